@@ -11,6 +11,7 @@
 #pragma once
 
 #include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/SysfsTopology.hpp"
 
 namespace llvm::noelle {
 
@@ -22,9 +23,49 @@ namespace llvm::noelle {
 
         static uint32_t getNumberOfPhysicalCores (void);
 
+        /*
+         * Number of logical cores of a physical core (i.e., SMT siblings).
+         */
+        static uint32_t getNumberOfLogicalCoresPerPhysicalCore (void);
+
+        static uint32_t getNumberOfNUMANodes (void);
+
+        static uint32_t getNUMANodeOfLogicalCore (uint32_t logicalCore);
+
+        /*
+         * Index, between 0 and getNumberOfPhysicalCores() - 1, of the physical core that includes "logicalCore".
+         */
+        static uint32_t getPhysicalCoreOfLogicalCore (uint32_t logicalCore);
+
+        /*
+         * Logical cores that share the last level cache with the one given as input (included).
+         */
+        static std::vector<uint32_t> getLogicalCoresSharingTheLastLevelCache (uint32_t logicalCore);
+
+        static uint64_t getLastLevelCacheBytes (void);
+
         static int32_t getCacheLineBytes (void);
 
       private:
+
+        /*
+         * Topology of the machine read from /sys/devices/system/cpu.
+         * If the topology cannot be read, every physical core is assumed to have two logical cores and the machine is assumed to have a single NUMA node.
+         */
+        class Topology {
+          public:
+            uint32_t logicalCores;
+            uint32_t physicalCores;
+            uint32_t NUMANodes;
+            uint64_t lastLevelCacheBytes;
+            std::vector<uint32_t> NUMANodeOfLogicalCore;
+            std::vector<uint32_t> physicalCoreOfLogicalCore;
+            std::vector<uint32_t> lastLevelCacheOfLogicalCore;
+        };
+
+        static const Topology & getTopology (void);
+
+        static Topology computeTopology (void);
   };
 
 }
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2016 - 2021  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*
+ * This header is shared by the compiler (Architecture) and by the runtime (Parallelizer_utils.cpp).
+ * Hence, it only depends on the C++14 standard library.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Parser of the topology of the machine described in /sys/devices/system/cpu and /sys/devices/system/node.
+ */
+class SysfsTopology {
+  public:
+
+    /*
+     * Location of a logical core.
+     * Physical cores and caches are identified by the lowest logical core that belongs to them.
+     */
+    class LogicalCore {
+      public:
+        std::vector<uint32_t> SMTSiblings;
+        uint32_t physicalCore;
+        uint32_t secondLevelCache;
+        uint32_t lastLevelCache;
+        uint64_t lastLevelCacheBytes;
+    };
+
+    /*
+     * Read the location of "logicalCore".
+     * Return false if sysfs does not describe it.
+     */
+    static bool readLogicalCore (uint32_t logicalCore, LogicalCore &location){
+      auto cpuRoot = std::string("/sys/devices/system/cpu/cpu") + std::to_string(logicalCore);
+
+      /*
+       * Logical cores that belong to the same physical core (SMT siblings, "logicalCore" included) are listed in "thread_siblings_list".
+       */
+      location.SMTSiblings = readListOfIDs(cpuRoot + "/topology/thread_siblings_list");
+      if (location.SMTSiblings.size() == 0){
+        return false;
+      }
+      location.physicalCore = *std::min_element(location.SMTSiblings.begin(), location.SMTSiblings.end());
+
+      /*
+       * Fetch the second level cache and the last level cache.
+       */
+      location.secondLevelCache = location.physicalCore;
+      location.lastLevelCache = location.physicalCore;
+      location.lastLevelCacheBytes = 0;
+      uint32_t lastLevel = 0;
+      for (auto index = 0; ; index++){
+        auto cacheRoot = cpuRoot + "/cache/index" + std::to_string(index);
+        auto levelString = readLine(cacheRoot + "/level");
+        if (levelString == ""){
+          break ;
+        }
+        if (readLine(cacheRoot + "/type") == "Instruction"){
+          continue ;
+        }
+        auto sharedCores = readListOfIDs(cacheRoot + "/shared_cpu_list");
+        if (sharedCores.size() == 0){
+          continue ;
+        }
+        auto cache = *std::min_element(sharedCores.begin(), sharedCores.end());
+        auto level = std::stoul(levelString);
+        if (level == 2){
+          location.secondLevelCache = cache;
+        }
+        if (level < lastLevel){
+          continue ;
+        }
+        lastLevel = level;
+        location.lastLevelCache = cache;
+        location.lastLevelCacheBytes = readBytes(cacheRoot + "/size");
+      }
+
+      return true;
+    }
+
+    /*
+     * Return the NUMA node of every logical core that sysfs assigns to one.
+     */
+    static std::unordered_map<uint32_t, uint32_t> readNUMANodes (void){
+      std::unordered_map<uint32_t, uint32_t> nodes;
+      for (auto node : readListOfIDs("/sys/devices/system/node/online")){
+        for (auto core : readListOfIDs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist")){
+          nodes[core] = node;
+        }
+      }
+
+      return nodes;
+    }
+
+    static std::string readLine (const std::string &fileName){
+      std::ifstream file(fileName);
+      std::string line;
+      if (  false
+            || (!file.is_open())
+            || (!std::getline(file, line))
+         ){
+        return "";
+      }
+
+      return line;
+    }
+
+    static std::vector<uint32_t> readListOfIDs (const std::string &fileName){
+      std::vector<uint32_t> ids;
+
+      /*
+       * Lists are written like "0-3,8,10-11".
+       */
+      std::stringstream stream(readLine(fileName));
+      std::string range;
+      while (std::getline(stream, range, ',')){
+        if (range == ""){
+          continue ;
+        }
+        auto separator = range.find('-');
+        auto first = std::stoul(range.substr(0, separator));
+        auto last = (separator == std::string::npos) ? first : std::stoul(range.substr(separator + 1));
+        for (auto id = first; id <= last; id++){
+          ids.push_back(id);
+        }
+      }
+
+      return ids;
+    }
+
+  private:
+
+    /*
+     * Sizes are written like "32768K".
+     */
+    static uint64_t readBytes (const std::string &fileName){
+      auto sizeString = readLine(fileName);
+      if (sizeString == ""){
+        return 0;
+      }
+      uint64_t bytes = std::stoull(sizeString);
+      switch (sizeString.back()){
+        case 'K':
+          bytes *= 1024;
+          break ;
+        case 'M':
+          bytes *= 1024 * 1024;
+          break ;
+      }
+
+      return bytes;
+    }
+};
@@ -21,11 +21,144 @@ uint32_t Architecture::getNumberOfLogicalCores (void){
 }
 
 uint32_t Architecture::getNumberOfPhysicalCores (void){
-  return getNumberOfLogicalCores() / 2;
+  return getTopology().physicalCores;
+}
+
+uint32_t Architecture::getNumberOfLogicalCoresPerPhysicalCore (void){
+  auto &t = getTopology();
+  auto smt = t.logicalCores / t.physicalCores;
+  if (smt < 1){
+    smt = 1;
+  }
+
+  return smt;
+}
+
+uint32_t Architecture::getNumberOfNUMANodes (void){
+  return getTopology().NUMANodes;
+}
+
+uint32_t Architecture::getNUMANodeOfLogicalCore (uint32_t logicalCore){
+  auto &t = getTopology();
+  if (logicalCore >= t.NUMANodeOfLogicalCore.size()){
+    return 0;
+  }
+
+  return t.NUMANodeOfLogicalCore[logicalCore];
+}
+
+uint32_t Architecture::getPhysicalCoreOfLogicalCore (uint32_t logicalCore){
+  auto &t = getTopology();
+  if (logicalCore >= t.physicalCoreOfLogicalCore.size()){
+    return logicalCore % t.physicalCores;
+  }
+
+  return t.physicalCoreOfLogicalCore[logicalCore];
+}
+
+std::vector<uint32_t> Architecture::getLogicalCoresSharingTheLastLevelCache (uint32_t logicalCore){
+  std::vector<uint32_t> cores;
+
+  auto &t = getTopology();
+  if (logicalCore >= t.lastLevelCacheOfLogicalCore.size()){
+    cores.push_back(logicalCore);
+    return cores;
+  }
+  auto cache = t.lastLevelCacheOfLogicalCore[logicalCore];
+  for (uint64_t i = 0; i < t.lastLevelCacheOfLogicalCore.size(); i++){
+    if (t.lastLevelCacheOfLogicalCore[i] == cache){
+      cores.push_back(i);
+    }
+  }
+
+  return cores;
+}
+
+uint64_t Architecture::getLastLevelCacheBytes (void){
+  return getTopology().lastLevelCacheBytes;
 }
 
 int32_t Architecture::getCacheLineBytes (void){
   return 64;
 }
 
+const Architecture::Topology & Architecture::getTopology (void){
+  static Topology t = computeTopology();
+
+  return t;
+}
+
+Architecture::Topology Architecture::computeTopology (void){
+  Topology t;
+
+  /*
+   * Set the default topology.
+   */
+  t.logicalCores = getNumberOfLogicalCores();
+  if (t.logicalCores == 0){
+    t.logicalCores = 1;
+  }
+  t.physicalCores = t.logicalCores / 2;
+  if (t.physicalCores == 0){
+    t.physicalCores = 1;
+  }
+  t.NUMANodes = 1;
+  t.lastLevelCacheBytes = 0;
+  t.NUMANodeOfLogicalCore.assign(t.logicalCores, 0);
+  t.physicalCoreOfLogicalCore.resize(t.logicalCores);
+  t.lastLevelCacheOfLogicalCore.assign(t.logicalCores, 0);
+  for (uint32_t i = 0; i < t.logicalCores; i++){
+    t.physicalCoreOfLogicalCore[i] = std::min(i / 2, t.physicalCores - 1);
+  }
+
+  /*
+   * Read the location of each logical core.
+   */
+  std::vector<SysfsTopology::LogicalCore> locations(t.logicalCores);
+  for (uint32_t i = 0; i < t.logicalCores; i++){
+    if (!SysfsTopology::readLogicalCore(i, locations[i])){
+
+      /*
+       * The topology is not available.
+       */
+      return t;
+    }
+  }
+
+  /*
+   * Number the physical cores densely in the order of their lowest logical core.
+   */
+  std::map<uint32_t, uint32_t> physicalCoreIndices;
+  for (auto &location : locations){
+    physicalCoreIndices[location.physicalCore] = 0;
+  }
+  uint32_t nextIndex = 0;
+  for (auto &pair : physicalCoreIndices){
+    pair.second = nextIndex++;
+  }
+  t.physicalCores = physicalCoreIndices.size();
+  for (uint32_t i = 0; i < t.logicalCores; i++){
+    t.physicalCoreOfLogicalCore[i] = physicalCoreIndices[locations[i].physicalCore];
+    t.lastLevelCacheOfLogicalCore[i] = locations[i].lastLevelCache;
+    if (locations[i].lastLevelCacheBytes > 0){
+      t.lastLevelCacheBytes = locations[i].lastLevelCacheBytes;
+    }
+  }
+
+  /*
+   * Identify the NUMA node of each logical core.
+   */
+  auto nodes = SysfsTopology::readListOfIDs("/sys/devices/system/node/online");
+  if (nodes.size() > 0){
+    t.NUMANodes = nodes.size();
+    for (auto &pair : SysfsTopology::readNUMANodes()){
+      if (pair.first < t.logicalCores){
+        t.NUMANodeOfLogicalCore[pair.first] = pair.second;
+      }
+    }
+  }
+
+  return t;
+}
+
 }
@@ -21,6 +21,24 @@ namespace llvm {
       std::vector<Function *> queuePushes;
       std::vector<Function *> queuePops;
       std::vector<Type *> queueTypes;
+
+      /*
+       * Queues that transfer values in blocks (see NOELLE_DSWPDispatcher_batchedQueues).
+       */
+      std::vector<Function *> queueBatchedPushes;
+      std::vector<Function *> queueBatchedPops;
+      std::vector<Function *> queueBatchedFlushes;
+      std::vector<Type *> batchedQueueTypes;
+
+      /*
+       * Queues of values of any size and of records that pack several values.
+       */
+      Function *queuePushRecord;
+      Function *queuePopRecord;
+      Function *queueBatchedPushRecord;
+      Function *queueBatchedPopRecord;
+      Function *queueBatchedFlushRecord;
+      Type *recordQueueType;
   };
 
 }
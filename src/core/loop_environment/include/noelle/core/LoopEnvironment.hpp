@@ -55,6 +55,8 @@ namespace llvm::noelle {
 
       uint64_t addLiveInValue (Value *newLiveInValue, const std::unordered_set<Instruction *> &consumers);
 
+      uint64_t addLiveOutValue (Value *newLiveOutValue, const std::unordered_set<Instruction *> &consumers);
+
     private:
       uint64_t addLiveInProducer (Value *producer);
       void addLiveOutProducer (Value *producer);
@@ -45,15 +45,34 @@ namespace llvm::noelle {
       /*
        * Reduce live out variables given binary operators to reduce
        * with and initial values to start at
+       *
+       * Min/max variables are reduced by keeping the private copy that satisfies "predicate(privateCopy, accumulatedValue)".
+       * Paired variables (e.g., argmin/argmax) keep the private copy of the thread whose min/max private copy is kept;
+       * ties are broken towards the private copy that satisfies "tieBreakPredicate(privateCopy, accumulatedValue)".
        */
       BasicBlock * reduceLiveOutVariables (
         BasicBlock *bb,
         IRBuilder<> builder,
         std::unordered_map<int, int> &reducableBinaryOps,
+        std::unordered_map<int, CmpInst::Predicate> &reducableMinMaxPredicates,
+        std::unordered_map<int, std::pair<int, CmpInst::Predicate>> &pairedReducableVariables,
         std::unordered_map<int, Value *> &initialValues,
         Value *numberOfThreadsExecuted
       );
 
+      /*
+       * Generate a function of type @combinerType (i.e., "void (i8 *env, i64 destination, i64 source)") that combines the private copies of reduced live-out variables of two task instances.
+       * The private copies of the task instance "source" are accumulated to the ones of the task instance "destination".
+       * The runtime uses this function to combine private copies in parallel when tasks end.
+       */
+      Function * generateReductionCombiner (
+        Module &module,
+        FunctionType *combinerType,
+        std::unordered_map<int, int> &reducableBinaryOps,
+        std::unordered_map<int, CmpInst::Predicate> &reducableMinMaxPredicates,
+        std::unordered_map<int, std::pair<int, CmpInst::Predicate>> &pairedReducableVariables
+      );
+
       /*
        * As all users of the environment know its structure, pass around the equivalent of a void pointer
        */
@@ -161,6 +161,23 @@ uint64_t LoopEnvironment::addLiveInValue (Value *newLiveInValue, const std::unor
   return newIndex;
 }
 
+uint64_t LoopEnvironment::addLiveOutValue (Value *newLiveOutValue, const std::unordered_set<Instruction *> &consumers){
+
+  /*
+   * Add the live-out value.
+   */
+  auto newIndex = this->addProducer(newLiveOutValue, false);
+
+  /*
+   * Add the consumers.
+   */
+  for (auto consumerOfNewLiveOut : consumers){
+    this->prodConsumers[newLiveOutValue].insert(consumerOfNewLiveOut);
+  }
+
+  return newIndex;
+}
+
 bool LoopEnvironment::isProducer (Value *producer) const {
   return producerIndexMap.find(producer) != producerIndexMap.end();
 }
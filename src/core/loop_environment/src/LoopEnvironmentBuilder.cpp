@@ -222,6 +222,8 @@ BasicBlock * LoopEnvironmentBuilder::reduceLiveOutVariables (
   BasicBlock *bb,
   IRBuilder<> builder,
   std::unordered_map<int, int> &reducableBinaryOps,
+  std::unordered_map<int, CmpInst::Predicate> &reducableMinMaxPredicates,
+  std::unordered_map<int, std::pair<int, CmpInst::Predicate>> &pairedReducableVariables,
   std::unordered_map<int, Value *> &initialValues,
   Value *numberOfThreadsExecuted
 ) {
@@ -271,6 +273,7 @@ BasicBlock * LoopEnvironmentBuilder::reduceLiveOutVariables (
    * Add the PHI nodes about the current accumulated value
    */
   std::vector<PHINode *> phiNodes;
+  std::unordered_map<int, uint32_t> positionOfVariable;
   auto count = 0;
   for (auto envIndexInitValue : initialValues) {
     auto envIndex = envIndexInitValue.first;
@@ -290,6 +293,7 @@ BasicBlock * LoopEnvironmentBuilder::reduceLiveOutVariables (
     /*
      * Keep track of the PHI node just created.
      */
+    positionOfVariable[envIndex] = phiNodes.size();
     phiNodes.push_back(phiNode);
   }
 
@@ -342,11 +346,6 @@ BasicBlock * LoopEnvironmentBuilder::reduceLiveOutVariables (
   for (auto envIndexInitValue : initialValues) {
     auto envIndex = envIndexInitValue.first;
 
-    /*
-     * Fetch the information about the operation to perform to accumulate values.
-     */
-    auto binOp = (Instruction::BinaryOps)reducableBinaryOps[envIndex];
-
     /*
      * Fetch the accumulator, which is the PHI node related to the current reduced variable.
      */
@@ -356,7 +355,52 @@ BasicBlock * LoopEnvironmentBuilder::reduceLiveOutVariables (
      * Accumulate values to the accumulator of the current reduced variable.
      */
     auto privateCurrentCopy = loadedValues[count];
-    auto newAccumulatorValue = loopBodyBuilder.CreateBinOp(binOp, accumVal, privateCurrentCopy);
+    Value *newAccumulatorValue = nullptr;
+    if (reducableMinMaxPredicates.find(envIndex) != reducableMinMaxPredicates.end()) {
+
+      /*
+       * Min/max: keep the private copy if it compares favorably with the accumulated value.
+       */
+      auto predicate = reducableMinMaxPredicates.at(envIndex);
+      auto isPrivateCopySelected = loopBodyBuilder.CreateCmp(predicate, privateCurrentCopy, accumVal);
+      newAccumulatorValue = loopBodyBuilder.CreateSelect(isPrivateCopySelected, privateCurrentCopy, accumVal);
+
+    } else if (pairedReducableVariables.find(envIndex) != pairedReducableVariables.end()) {
+
+      /*
+       * Fetch the min/max variable this variable is paired with.
+       */
+      auto minMaxEnvIndex = pairedReducableVariables.at(envIndex).first;
+      auto tieBreakPredicate = pairedReducableVariables.at(envIndex).second;
+      auto minMaxPredicate = reducableMinMaxPredicates.at(minMaxEnvIndex);
+      auto minMaxPosition = positionOfVariable.at(minMaxEnvIndex);
+      auto minMaxAccumVal = phiNodes[minMaxPosition];
+      auto minMaxPrivateCopy = loadedValues[minMaxPosition];
+      auto minMaxInitialValue = initialValues.at(minMaxEnvIndex);
+
+      /*
+       * Keep the private copy if the min/max private copy strictly improves the accumulated min/max.
+       * On ties, keep the private copy selected in the earliest iteration.
+       * The initial value precedes all iterations, so it wins all ties.
+       */
+      auto isMinMaxBetter = loopBodyBuilder.CreateCmp(minMaxPredicate, minMaxPrivateCopy, minMaxAccumVal);
+      auto isMinMaxTied = minMaxPrivateCopy->getType()->isFloatingPointTy()
+        ? loopBodyBuilder.CreateFCmpOEQ(minMaxPrivateCopy, minMaxAccumVal)
+        : loopBodyBuilder.CreateICmpEQ(minMaxPrivateCopy, minMaxAccumVal);
+      auto isMinMaxAccumulatedFromPrivateCopies = loopBodyBuilder.CreateCmp(minMaxPredicate, minMaxAccumVal, minMaxInitialValue);
+      auto isPrivateCopyEarlier = loopBodyBuilder.CreateICmp(tieBreakPredicate, privateCurrentCopy, accumVal);
+      auto isTieWon = loopBodyBuilder.CreateAnd(loopBodyBuilder.CreateAnd(isMinMaxTied, isMinMaxAccumulatedFromPrivateCopies), isPrivateCopyEarlier);
+      auto isPrivateCopySelected = loopBodyBuilder.CreateOr(isMinMaxBetter, isTieWon);
+      newAccumulatorValue = loopBodyBuilder.CreateSelect(isPrivateCopySelected, privateCurrentCopy, accumVal);
+
+    } else {
+
+      /*
+       * Fetch the information about the operation to perform to accumulate values.
+       */
+      auto binOp = (Instruction::BinaryOps)reducableBinaryOps[envIndex];
+      newAccumulatorValue = loopBodyBuilder.CreateBinOp(binOp, accumVal, privateCurrentCopy);
+    }
 
     /*
      * Keep track of the new accumulator value.
@@ -411,6 +455,129 @@ BasicBlock * LoopEnvironmentBuilder::reduceLiveOutVariables (
   return afterReductionBB;
 }
 
+Function * LoopEnvironmentBuilder::generateReductionCombiner (
+  Module &module,
+  FunctionType *combinerType,
+  std::unordered_map<int, int> &reducableBinaryOps,
+  std::unordered_map<int, CmpInst::Predicate> &reducableMinMaxPredicates,
+  std::unordered_map<int, std::pair<int, CmpInst::Predicate>> &pairedReducableVariables
+) {
+
+  /*
+   * Create the function.
+   */
+  auto combiner = Function::Create(combinerType, GlobalValue::InternalLinkage, "noelle_combine_reductions", &module);
+  auto entryBB = BasicBlock::Create(this->CXT, "Entry", combiner);
+  IRBuilder<> builder{entryBB};
+  auto argIter = combiner->arg_begin();
+  auto envArg = &*(argIter++);
+  auto destinationArg = &*(argIter++);
+  auto sourceArg = &*(argIter++);
+
+  /*
+   * Compute the offsets of the private copies of the two task instances.
+   */
+  auto int64 = IntegerType::get(this->CXT, 64);
+  auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
+  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+  auto valuesInCacheLineV = ConstantInt::get(int64, valuesInCacheLine);
+  auto destinationOffset = builder.CreateMul(destinationArg, valuesInCacheLineV);
+  auto sourceOffset = builder.CreateMul(sourceArg, valuesInCacheLineV);
+
+  /*
+   * Load the private copies of the two task instances.
+   */
+  auto envArray = builder.CreateBitCast(envArg, PointerType::getUnqual(this->envArrayType));
+  auto reduceArrType = ArrayType::get(int64, this->numReducers * valuesInCacheLine);
+  std::unordered_map<int, Value *> destinationPtrs;
+  std::unordered_map<int, Value *> destinationValues;
+  std::unordered_map<int, Value *> sourceValues;
+  for (auto indexVarPair : this->envIndexToReducableVar) {
+    auto envIndex = indexVarPair.first;
+    auto isReduced = false
+      || (reducableBinaryOps.find(envIndex) != reducableBinaryOps.end())
+      || (reducableMinMaxPredicates.find(envIndex) != reducableMinMaxPredicates.end())
+      || (pairedReducableVariables.find(envIndex) != pairedReducableVariables.end());
+    if (!isReduced){
+      continue ;
+    }
+    auto ptrType = PointerType::getUnqual(this->envTypes[envIndex]);
+
+    /*
+     * Fetch the vectorized form of the variable from the environment.
+     */
+    auto envIndV = cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
+    auto envPtr = builder.CreateInBoundsGEP(envArray, ArrayRef<Value*>({ zeroV, envIndV }));
+    auto reduceArrPtrPtr = builder.CreateBitCast(envPtr, PointerType::getUnqual(PointerType::getUnqual(reduceArrType)));
+    auto reduceArr = builder.CreateLoad(reduceArrPtrPtr);
+
+    /*
+     * Load the private copies.
+     */
+    auto destinationPtr = builder.CreateBitCast(builder.CreateInBoundsGEP(reduceArr, ArrayRef<Value*>({ zeroV, destinationOffset })), ptrType);
+    auto sourcePtr = builder.CreateBitCast(builder.CreateInBoundsGEP(reduceArr, ArrayRef<Value*>({ zeroV, sourceOffset })), ptrType);
+    destinationPtrs[envIndex] = destinationPtr;
+    destinationValues[envIndex] = builder.CreateLoad(destinationPtr);
+    sourceValues[envIndex] = builder.CreateLoad(sourcePtr);
+  }
+
+  /*
+   * Combine the private copies.
+   *
+   * All values are combined before storing any of them because paired variables depend on the values of the min/max variables they are paired with.
+   */
+  std::unordered_map<int, Value *> combinedValues;
+  for (auto destinationPair : destinationValues) {
+    auto envIndex = destinationPair.first;
+    auto destinationValue = destinationPair.second;
+    auto sourceValue = sourceValues.at(envIndex);
+    Value *combinedValue = nullptr;
+    if (reducableMinMaxPredicates.find(envIndex) != reducableMinMaxPredicates.end()) {
+
+      /*
+       * Min/max: keep the private copy of the source if it compares favorably with the one of the destination.
+       */
+      auto predicate = reducableMinMaxPredicates.at(envIndex);
+      auto isSourceSelected = builder.CreateCmp(predicate, sourceValue, destinationValue);
+      combinedValue = builder.CreateSelect(isSourceSelected, sourceValue, destinationValue);
+
+    } else if (pairedReducableVariables.find(envIndex) != pairedReducableVariables.end()) {
+
+      /*
+       * Paired variables: keep the private copy of the source if its min/max strictly improves the one of the destination.
+       * On ties, keep the private copy selected in the earliest iteration.
+       */
+      auto minMaxEnvIndex = pairedReducableVariables.at(envIndex).first;
+      auto tieBreakPredicate = pairedReducableVariables.at(envIndex).second;
+      auto minMaxPredicate = reducableMinMaxPredicates.at(minMaxEnvIndex);
+      auto minMaxDestination = destinationValues.at(minMaxEnvIndex);
+      auto minMaxSource = sourceValues.at(minMaxEnvIndex);
+      auto isMinMaxBetter = builder.CreateCmp(minMaxPredicate, minMaxSource, minMaxDestination);
+      auto isMinMaxTied = minMaxSource->getType()->isFloatingPointTy()
+        ? builder.CreateFCmpOEQ(minMaxSource, minMaxDestination)
+        : builder.CreateICmpEQ(minMaxSource, minMaxDestination);
+      auto isSourceEarlier = builder.CreateICmp(tieBreakPredicate, sourceValue, destinationValue);
+      auto isSourceSelected = builder.CreateOr(isMinMaxBetter, builder.CreateAnd(isMinMaxTied, isSourceEarlier));
+      combinedValue = builder.CreateSelect(isSourceSelected, sourceValue, destinationValue);
+
+    } else {
+      auto binOp = (Instruction::BinaryOps)reducableBinaryOps.at(envIndex);
+      combinedValue = builder.CreateBinOp(binOp, destinationValue, sourceValue);
+    }
+    combinedValues[envIndex] = combinedValue;
+  }
+
+  /*
+   * Store the combined values to the private copies of the destination.
+   */
+  for (auto combinedPair : combinedValues) {
+    builder.CreateStore(combinedPair.second, destinationPtrs.at(combinedPair.first));
+  }
+  builder.CreateRetVoid();
+
+  return combiner;
+}
+
 Value *LoopEnvironmentBuilder::getEnvironmentArrayVoidPtr (void) const {
   assert(this->envArrayInt8Ptr != nullptr);
 
@@ -29,6 +29,19 @@ namespace llvm::noelle {
       bool isSubOp (unsigned op);
       unsigned accumOpForType (unsigned op, Type *type);
       Value *generateIdentityFor (Instruction *accumulator, Type *castType);
+
+      /*
+       * Min/max accumulators: a select whose condition compares the two values it selects from, or a call to llvm.minnum/llvm.maxnum.
+       */
+      bool isMinMaxOp (Instruction *accumulator);
+
+      /*
+       * Return the predicate P such that two partial results of the min/max accumulator @accumulator of @accumulatedValue are combined as "P(partial, accumulated) ? partial : accumulated".
+       * Return CmpInst::BAD_ICMP_PREDICATE if @accumulator is not a min/max accumulator of @accumulatedValue.
+       */
+      CmpInst::Predicate getMinMaxPredicate (Instruction *accumulator, Value *accumulatedValue);
+
+      Value *generateMinMaxIdentityFor (CmpInst::Predicate minMaxPredicate, Type *castType);
   };
 
 }
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2016 - 2022  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/AccumulatorOpInfo.hpp"
+
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+
+namespace llvm::noelle {
+
+  /*
+   * An array reduction (e.g., a histogram) accumulates values to elements of an array through commutative and associative operations.
+   * The array is not accessed otherwise within the loop.
+   * Hence, each thread can accumulate values to a private copy of the array, and the private copies can be merged into the array after the loop.
+   */
+  class ArrayReduction {
+    public:
+
+      /*
+       * Operations used to accumulate values to elements.
+       * These values must match the ones used by the NOELLE_arrayReduction_* functions of the runtime.
+       */
+      enum Operation {ADD = 0, SUB = 1, MUL = 2, OR = 3, AND = 4, XOR = 5};
+
+      ArrayReduction (
+        LoadInst *load,
+        BinaryOperator *update,
+        StoreInst *store
+        );
+
+      ArrayReduction () = delete ;
+
+      /*
+       * The instructions that load, update, and store an element.
+       */
+      LoadInst * getLoad (void) const ;
+      BinaryOperator * getUpdate (void) const ;
+      StoreInst * getStore (void) const ;
+
+      /*
+       * The computation of the address of the element.
+       */
+      GetElementPtrInst * getPointer (void) const ;
+
+      /*
+       * The array.
+       */
+      Value * getBaseObject (void) const ;
+
+      /*
+       * The index of the element within the array.
+       */
+      Value * getIndex (void) const ;
+
+      /*
+       * The value accumulated to the element.
+       */
+      Value * getAccumulatedValue (void) const ;
+
+      Type * getElementType (void) const ;
+
+      Operation getOperation (void) const ;
+
+      /*
+       * Return the number of elements of the array if it is known at compile time; 0 otherwise.
+       */
+      uint64_t getNumberOfElements (void) const ;
+
+    private:
+      LoadInst *load;
+      BinaryOperator *update;
+      StoreInst *store;
+      GetElementPtrInst *pointer;
+      Operation operation;
+      uint64_t numberOfElements;
+  };
+
+}
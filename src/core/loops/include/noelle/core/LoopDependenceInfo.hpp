@@ -157,6 +157,12 @@ namespace llvm::noelle {
 
       MemoryCloningAnalysis * getMemoryCloningAnalysis (void) const ;
 
+      /*
+       * Return the pairs of memory accesses whose dependences have been removed by assuming they touch disjoint ranges of addresses.
+       * Code generated from the dependence graph of "this" is correct only if this assumption is checked at run time before running it.
+       */
+      const std::vector<std::pair<Instruction *, Instruction *>> & getMemoryAccessesAssumedToBeDisjoint (void) const ;
+
       bool doesHaveCompileTimeKnownTripCount (void) const ;
 
       uint64_t getCompileTimeTripCount (void) const ;
@@ -189,6 +195,8 @@ namespace llvm::noelle {
 
       MemoryCloningAnalysis *memoryCloningAnalysis;
 
+      std::vector<std::pair<Instruction *, Instruction *>> memoryAccessesAssumedToBeDisjoint;
+
       bool compileTimeKnownTripCount;
 
       uint64_t tripCount;
@@ -230,6 +238,13 @@ namespace llvm::noelle {
         DominatorSummary &DS
       );
 
+      void removeUnnecessaryDependenciesThatRuntimeAliasChecksNegate (
+        StayConnectedNestedLoopForestNode *loopNode,
+        PDG *loopDG,
+        LoopIterationDomainSpaceAnalysis &domainSpace,
+        ScalarEvolution &SE
+      );
+
       SCCDAG * computeSCCDAGWithOnlyVariableAndControlDependences (
         PDG *loopDG
         );
@@ -43,6 +43,16 @@ namespace llvm::noelle {
         Instruction *to
       ) const ;
 
+      /*
+       * Return the lowest address accessed by @memoryAccessor during an invocation of the outermost loop and the address that follows the highest one.
+       * Both are expressed with values available before the loop starts.
+       * Return a pair of nullptr if they cannot be computed.
+       */
+      std::pair<const SCEV *, const SCEV *> getRangeOfAddressesAccessedByTheLoop (
+        Instruction *memoryAccessor,
+        ScalarEvolution &SE
+      ) const ;
+
     private:
 
       /*
@@ -33,17 +33,35 @@ namespace llvm::noelle {
       std::unordered_set<std::unique_ptr<ClonableMemoryLocation>> clonableMemoryLocations;
   };
 
+  /*
+   * A memory object that every iteration of a loop fully overwrites before reading it.
+   * Each thread can use a private copy of it.
+   *
+   * The object can be a stack object (i.e., an alloca of the function that includes the loop), a global variable, or a heap object allocated before the loop (e.g., by malloc).
+   * Global and heap objects must only be accessed by the loop (and freed after it for heap objects), so no other code can observe their private copies.
+   */
   class ClonableMemoryLocation {
     public:
       ClonableMemoryLocation (
-        AllocaInst *allocation,
+        Value *allocation,
         uint64_t sizeInBits,
         LoopStructure *loop,
         DominatorSummary &DS,
         PDG *ldg
       ) ;
 
-      AllocaInst * getAllocation (void) const ;
+      /*
+       * Return the object: an AllocaInst, a GlobalVariable, or the call that allocates the heap object.
+       */
+      Value * getAllocation (void) const ;
+
+      bool isStackObject (void) const ;
+
+      bool isGlobalObject (void) const ;
+
+      bool isHeapObject (void) const ;
+
+      uint64_t getSizeInBits (void) const ;
 
       std::unordered_set<Instruction *> getLoopInstructionsUsingLocation (void) const ;
 
@@ -59,8 +77,10 @@ namespace llvm::noelle {
 
       static bool isMemCpyInstrinsicCall (CallInst *call) ;
 
+      static bool isMemSetInstrinsicCall (CallInst *call) ;
+
     private:
-      AllocaInst *allocation;
+      Value *allocation;
       Type *allocatedType;
       uint64_t sizeInBits;
       LoopStructure *loop;
@@ -71,18 +91,20 @@ namespace llvm::noelle {
       std::unordered_set<Instruction *> storingInstructions;
       std::unordered_set<Instruction *> loadInstructions;
       std::unordered_set<Instruction *> nonStoringInstructions;
+      std::unordered_set<ConstantExpr *> constantCastsAndGEPs;
+      std::unordered_set<Instruction *> deallocatingInstructions;
 
       bool identifyStoresAndOtherUsers (LoopStructure *loop, DominatorSummary &DS) ;
 
       bool isThereRAWThroughMemoryFromOutsideLoop (
           LoopStructure *loop, 
-          AllocaInst *al, 
+          Value *al, 
           PDG *ldg
           ) const ;
 
       bool isThereRAWThroughMemoryFromOutsideLoop (
           LoopStructure *loop, 
-          AllocaInst *al, 
+          Value *al, 
           PDG *ldg,
           std::unordered_set<Instruction *> insts
           ) const ;
@@ -105,7 +127,7 @@ namespace llvm::noelle {
       bool isOverrideSetFullyCoveringTheAllocationSpace (OverrideSet *overrideSet) const ;
 
       void setObjectScope (
-        AllocaInst *allocation,
+        Value *allocation,
         LoopStructure *loop,
         DominatorSummary &ds
         );
@@ -90,7 +90,7 @@ namespace llvm::noelle {
       bool canBeCloned (void) const ;
 
       /*
-       * Return true if cloning is possible through memory AllocaInst cloning
+       * Return true if cloning is possible through cloning memory objects (see ClonableMemoryLocation)
        */
       bool canBeClonedUsingLocalMemoryLocations (void) const;
 
@@ -161,7 +161,7 @@ namespace llvm::noelle {
       /*
        * Return the memory locations that can be safely clone to void reusing the same memory locations between invocations of this SCC.
        */
-      std::unordered_set<AllocaInst *> getMemoryLocationsToClone (void) const ;
+      std::unordered_set<Value *> getMemoryLocationsToClone (void) const ;
 
       /*
        * Add a loop carried cycle
@@ -12,6 +12,7 @@
 
 #include "noelle/core/SystemHeaders.hpp"
 #include "noelle/core/AccumulatorOpInfo.hpp"
+#include "noelle/core/ArrayReduction.hpp"
 #include "noelle/core/SCCDAG.hpp"
 #include "noelle/core/SCC.hpp"
 #include "noelle/core/SCCAttrs.hpp"
@@ -73,6 +74,33 @@ namespace llvm::noelle {
         ) const ;
       SCCAttrs * getSCCAttrs (SCC *scc) const; 
 
+      /*
+       * Return the predicate used to combine partial results of the min/max reduction @scc.
+       * Return CmpInst::BAD_ICMP_PREDICATE if @scc is not a min/max reduction.
+       */
+      CmpInst::Predicate getMinMaxPredicateOfReduction (SCC *scc) ;
+
+      /*
+       * Paired reductions (e.g., argmin/argmax) select their new value when a min/max reduction selects its own.
+       * Return the SCC of such min/max reduction if @scc is a paired reduction; nullptr otherwise.
+       */
+      SCC * getMinMaxSCCOfPairedReduction (SCC *scc) const ;
+
+      /*
+       * Return the predicate that compares two values of the paired reduction @scc and holds if the first one was selected in an earlier iteration.
+       */
+      CmpInst::Predicate getTieBreakPredicateOfPairedReduction (SCC *scc) const ;
+
+      /*
+       * Return the array reduction (e.g., a histogram) computed by @scc if there is one; nullptr otherwise.
+       */
+      ArrayReduction * getArrayReduction (SCC *scc) const ;
+
+      /*
+       * Return all array reductions of the loop.
+       */
+      std::unordered_set<ArrayReduction *> getArrayReductions (void) const ;
+
       /*
        * Methods about single dependence.
        */
@@ -115,6 +143,8 @@ namespace llvm::noelle {
       PDG *loopDG;
       SCCDAG *sccdag;     /* SCCDAG of the related loop.  */
       MemoryCloningAnalysis *memoryCloningAnalysis;
+      std::unordered_map<SCC *, std::pair<SCC *, CmpInst::Predicate>> pairedReductions;
+      std::unordered_map<SCC *, ArrayReduction *> arrayReductions;
 
       /*
        * Helper methods on SCCDAG
@@ -126,9 +156,26 @@ namespace llvm::noelle {
        * Helper methods on single SCC
        */
       bool checkIfReducible (
+        SCC *scc,
+        StayConnectedNestedLoopForestNode *loop,
+        std::set<InductionVariable *> &IVs
+        );
+      bool isArrayReduction (
         SCC *scc,
         StayConnectedNestedLoopForestNode *loop
         );
+      bool isMinMaxReduction (
+        SCC *scc,
+        StayConnectedNestedLoopForestNode *loop,
+        PHINode *loopCarriedPHI
+        );
+      bool isPairedReduction (
+        SCC *scc,
+        StayConnectedNestedLoopForestNode *loop,
+        PHINode *loopCarriedPHI,
+        std::set<InductionVariable *> &IVs
+        );
+      void checkIfPairedReductionsAreComplete (StayConnectedNestedLoopForestNode *loop);
       bool checkIfIndependent (SCC *scc);
       bool checkIfSCCOnlyContainsInductionVariables (
         SCC *scc,
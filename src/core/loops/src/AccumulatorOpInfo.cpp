@@ -21,7 +21,8 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     Instruction::Sub,
     Instruction::FSub,
     Instruction::Or,
-    Instruction::And
+    Instruction::And,
+    Instruction::Xor
   };
 
   this->accumOps = std::set<unsigned>(sideEffectFreeOps.begin(), sideEffectFreeOps.end());
@@ -34,7 +35,8 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     { Instruction::Sub, 0 },
     { Instruction::FSub, 0 },
     { Instruction::Or, 0 },
-    { Instruction::And, 1 }
+    { Instruction::And, 1 },
+    { Instruction::Xor, 0 }
   };
 
   this->integerReducingOperators = {
@@ -45,7 +47,8 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     { Instruction::Sub, Instruction::Add },
     { Instruction::FSub, Instruction::Add },
     { Instruction::Or, Instruction::Or },
-    { Instruction::And, Instruction::And }
+    { Instruction::And, Instruction::And },
+    { Instruction::Xor, Instruction::Xor }
   };
 
   this->floatingReducingOperators = {
@@ -90,6 +93,17 @@ unsigned AccumulatorOpInfo::accumOpForType (unsigned op, Type *type) {
 
 Value *AccumulatorOpInfo::generateIdentityFor (Instruction *accumulator, Type *castType) {
   Value *initVal = nullptr;
+
+  /*
+   * The identity of "and" has all bits set.
+   */
+  if (  true
+        && (accumulator->getOpcode() == Instruction::And)
+        && castType->isIntegerTy()
+    ){
+    return Constant::getAllOnesValue(castType);
+  }
+
   auto opIdentity = this->opIdentities[accumulator->getOpcode()];
   if (castType->isIntegerTy()) initVal = ConstantInt::get(castType, opIdentity);
   if (castType->isFloatTy()) initVal = ConstantFP::get(castType, (float)opIdentity);
@@ -98,4 +112,132 @@ Value *AccumulatorOpInfo::generateIdentityFor (Instruction *accumulator, Type *c
   return initVal;
 }
 
+bool AccumulatorOpInfo::isMinMaxOp (Instruction *accumulator) {
+
+  /*
+   * Check llvm.minnum and llvm.maxnum.
+   */
+  if (auto intrinsic = dyn_cast<IntrinsicInst>(accumulator)){
+    auto intrinsicID = intrinsic->getIntrinsicID();
+    return (intrinsicID == Intrinsic::minnum) || (intrinsicID == Intrinsic::maxnum);
+  }
+
+  /*
+   * Check a select that chooses between the two values compared by its condition.
+   */
+  auto selectInst = dyn_cast<SelectInst>(accumulator);
+  if (selectInst == nullptr){
+    return false;
+  }
+  auto cmpInst = dyn_cast<CmpInst>(selectInst->getCondition());
+  if (  false
+        || (cmpInst == nullptr)
+        || cmpInst->isEquality()
+    ){
+    return false;
+  }
+  auto trueValue = selectInst->getTrueValue();
+  auto falseValue = selectInst->getFalseValue();
+  auto lhs = cmpInst->getOperand(0);
+  auto rhs = cmpInst->getOperand(1);
+  if (  false
+        || ((lhs == trueValue) && (rhs == falseValue))
+        || ((lhs == falseValue) && (rhs == trueValue))
+    ){
+    return true;
+  }
+
+  return false;
+}
+
+CmpInst::Predicate AccumulatorOpInfo::getMinMaxPredicate (Instruction *accumulator, Value *accumulatedValue) {
+  if (!this->isMinMaxOp(accumulator)){
+    return CmpInst::BAD_ICMP_PREDICATE;
+  }
+
+  /*
+   * llvm.maxnum and llvm.minnum return the other operand when one of them is a NaN.
+   * Partial results start from an infinity and therefore they are never NaN.
+   * Hence, a partial result replaces the accumulated value if it is greater (smaller) or if the accumulated value is a NaN.
+   */
+  if (auto intrinsic = dyn_cast<IntrinsicInst>(accumulator)){
+    if (  true
+          && (intrinsic->getArgOperand(0) != accumulatedValue)
+          && (intrinsic->getArgOperand(1) != accumulatedValue)
+      ){
+      return CmpInst::BAD_ICMP_PREDICATE;
+    }
+    return intrinsic->getIntrinsicID() == Intrinsic::maxnum ? CmpInst::FCMP_UGT : CmpInst::FCMP_ULT;
+  }
+
+  /*
+   * Normalize the select to "P(newValue, accumulatedValue) ? newValue : accumulatedValue".
+   */
+  auto selectInst = cast<SelectInst>(accumulator);
+  auto cmpInst = cast<CmpInst>(selectInst->getCondition());
+  auto predicate = cmpInst->getPredicate();
+  if (selectInst->getFalseValue() == accumulatedValue){
+    if (cmpInst->getOperand(0) == accumulatedValue){
+      predicate = CmpInst::getSwappedPredicate(predicate);
+    }
+
+  } else if (selectInst->getTrueValue() == accumulatedValue){
+    predicate = CmpInst::getInversePredicate(predicate);
+    if (cmpInst->getOperand(0) == accumulatedValue){
+      predicate = CmpInst::getSwappedPredicate(predicate);
+    }
+
+  } else {
+    return CmpInst::BAD_ICMP_PREDICATE;
+  }
+
+  /*
+   * A NaN must not replace the accumulated value.
+   * Otherwise, the result would depend on the order the values are accumulated.
+   */
+  switch (predicate) {
+    case CmpInst::FCMP_OGT:
+    case CmpInst::FCMP_OGE:
+    case CmpInst::FCMP_OLT:
+    case CmpInst::FCMP_OLE:
+      return predicate;
+    default:
+      if (CmpInst::isFPPredicate(predicate)){
+        return CmpInst::BAD_ICMP_PREDICATE;
+      }
+  }
+
+  return predicate;
+}
+
+Value *AccumulatorOpInfo::generateMinMaxIdentityFor (CmpInst::Predicate minMaxPredicate, Type *castType) {
+  switch (minMaxPredicate) {
+    case CmpInst::ICMP_SGT:
+    case CmpInst::ICMP_SGE:
+      return ConstantInt::get(castType, APInt::getSignedMinValue(castType->getIntegerBitWidth()));
+    case CmpInst::ICMP_SLT:
+    case CmpInst::ICMP_SLE:
+      return ConstantInt::get(castType, APInt::getSignedMaxValue(castType->getIntegerBitWidth()));
+    case CmpInst::ICMP_UGT:
+    case CmpInst::ICMP_UGE:
+      return ConstantInt::get(castType, 0);
+    case CmpInst::ICMP_ULT:
+    case CmpInst::ICMP_ULE:
+      return Constant::getAllOnesValue(castType);
+    case CmpInst::FCMP_OGT:
+    case CmpInst::FCMP_OGE:
+    case CmpInst::FCMP_UGT:
+      return ConstantFP::getInfinity(castType, true);
+    case CmpInst::FCMP_OLT:
+    case CmpInst::FCMP_OLE:
+    case CmpInst::FCMP_ULT:
+      return ConstantFP::getInfinity(castType, false);
+    default:
+      assert(false
+        && "Attempting to compute the identity of an unknown min/max operator!");
+  }
+
+  return nullptr;
+}
+
 }
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2016 - 2022  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/AccumulatorOpInfo.hpp"
+
+#include "noelle/core/ArrayReduction.hpp"
+
+namespace llvm::noelle {
+
+ArrayReduction::ArrayReduction (
+  LoadInst *load,
+  BinaryOperator *update,
+  StoreInst *store
+  ) :
+    load{load}
+  , update{update}
+  , store{store}
+  , pointer{cast<GetElementPtrInst>(load->getPointerOperand())}
+  , operation{ADD}
+  , numberOfElements{0}
+  {
+
+  /*
+   * Fetch the operation used to accumulate values.
+   */
+  switch (update->getOpcode()) {
+    case Instruction::Add:
+    case Instruction::FAdd:
+      this->operation = ADD;
+      break ;
+    case Instruction::Sub:
+    case Instruction::FSub:
+      this->operation = SUB;
+      break ;
+    case Instruction::Mul:
+    case Instruction::FMul:
+      this->operation = MUL;
+      break ;
+    case Instruction::Or:
+      this->operation = OR;
+      break ;
+    case Instruction::And:
+      this->operation = AND;
+      break ;
+    case Instruction::Xor:
+      this->operation = XOR;
+      break ;
+    default:
+      assert(false && "Attempting to reduce an array with an unknown operator!");
+  }
+
+  /*
+   * Compute the number of elements of the array if it is known at compile time.
+   *
+   * An array object is indexed through its second index (e.g., "getelementptr [N x T], [N x T]* @a, i64 0, i64 %i").
+   * A pointer is indexed through its first index (e.g., "getelementptr T, T* %a, i64 %i"), and its number of elements is known only if it points to a stack object.
+   */
+  if (this->pointer->getNumIndices() == 2){
+    if (auto arrayType = dyn_cast<ArrayType>(this->pointer->getSourceElementType())){
+      this->numberOfElements = arrayType->getNumElements();
+    }
+
+  } else if (auto allocaInst = dyn_cast<AllocaInst>(this->getBaseObject())){
+    if (auto arraySize = dyn_cast<ConstantInt>(allocaInst->getArraySize())){
+      this->numberOfElements = arraySize->getZExtValue();
+    }
+  }
+
+  return ;
+}
+
+LoadInst * ArrayReduction::getLoad (void) const {
+  return this->load;
+}
+
+BinaryOperator * ArrayReduction::getUpdate (void) const {
+  return this->update;
+}
+
+StoreInst * ArrayReduction::getStore (void) const {
+  return this->store;
+}
+
+GetElementPtrInst * ArrayReduction::getPointer (void) const {
+  return this->pointer;
+}
+
+Value * ArrayReduction::getBaseObject (void) const {
+  return this->pointer->getPointerOperand();
+}
+
+Value * ArrayReduction::getIndex (void) const {
+  return this->pointer->getOperand(this->pointer->getNumOperands() - 1);
+}
+
+Value * ArrayReduction::getAccumulatedValue (void) const {
+  if (this->update->getOperand(0) == this->load){
+    return this->update->getOperand(1);
+  }
+
+  return this->update->getOperand(0);
+}
+
+Type * ArrayReduction::getElementType (void) const {
+  return this->load->getType();
+}
+
+ArrayReduction::Operation ArrayReduction::getOperation (void) const {
+  return this->operation;
+}
+
+uint64_t ArrayReduction::getNumberOfElements (void) const {
+  return this->numberOfElements;
+}
+
+}
@@ -130,16 +130,16 @@ LoopDependenceInfo::LoopDependenceInfo(
   /*
    * Create the environment for the loop.
    *
-   * Exclude stack objects that will be cloned. To do so, we need to collect this set of objects.
+   * Exclude stack and heap objects that will be cloned. To do so, we need to collect this set of objects.
    */
-  std::set<Value *> stackObjectsThatWillBeCloned;
+  std::set<Value *> objectsThatWillBeCloned;
   if (this->memoryCloningAnalysis != nullptr){
     for (auto memObject : this->memoryCloningAnalysis->getClonableMemoryLocations()){
-      auto stackObject = memObject->getAllocation();
-      stackObjectsThatWillBeCloned.insert(stackObject);
+      auto object = memObject->getAllocation();
+      objectsThatWillBeCloned.insert(object);
     }
   }
-  this->environment = new LoopEnvironment(loopDG, loopExitBlocks, stackObjectsThatWillBeCloned);
+  this->environment = new LoopEnvironment(loopDG, loopExitBlocks, objectsThatWillBeCloned);
 
   /*
    * Create the invariant manager.
@@ -168,6 +168,28 @@ LoopDependenceInfo::LoopDependenceInfo(
   this->sccdagAttrs = new SCCDAGAttrs(enableFloatAsReal, loopDG, loopSCCDAG, this->loop, SE, *inductionVariables, DS);
   this->domainSpaceAnalysis = new LoopIterationDomainSpaceAnalysis(this->loop, *this->inductionVariables, SE);
 
+  /*
+   * Paired reductions (e.g., argmin/argmax) are combined by comparing the partial results of the min/max reductions that select their values.
+   * Hence, these min/max variables must belong to the environment even when no instruction outside the loop consumes them.
+   */
+  for (auto sccInfo : this->sccdagAttrs->getSCCsOfType(SCCAttrs::SCCType::REDUCIBLE)) {
+    auto minMaxSCC = this->sccdagAttrs->getMinMaxSCCOfPairedReduction(sccInfo->getSCC());
+    if (minMaxSCC == nullptr){
+      continue ;
+    }
+    auto isMinMaxLiveOut = false;
+    for (auto envIndex : this->environment->getEnvIndicesOfLiveOutVars()){
+      if (minMaxSCC->isInternal(this->environment->producerAt(envIndex))){
+        isMinMaxLiveOut = true;
+        break ;
+      }
+    }
+    if (!isMinMaxLiveOut){
+      auto minMaxPHI = this->sccdagAttrs->getSCCAttrs(minMaxSCC)->getSingleHeaderPHI();
+      this->environment->addLiveOutValue(minMaxPHI, {});
+    }
+  }
+
   /*
    * Collect induction variable information
    */
@@ -304,6 +326,13 @@ std::pair<PDG *, SCCDAG *> LoopDependenceInfo::createDGsForLoop (
     this->removeUnnecessaryDependenciesWithThreadSafeLibraryFunctions(loopNode, loopDG, DS);
   }
 
+  /*
+   * Remove memory dependences between accesses that can be checked to be disjoint right before the loop starts.
+   */
+  if (this->loopTransformationsManager->isOptimizationEnabled(LoopDependenceInfoOptimization::RUNTIME_ALIAS_CHECKS_ID)){
+    this->removeUnnecessaryDependenciesThatRuntimeAliasChecksNegate(loopNode, loopDG, domainSpace, SE);
+  }
+
   /*
    * Build a SCCDAG of loop-internal instructions
    */
@@ -405,6 +434,113 @@ void LoopDependenceInfo::removeUnnecessaryDependenciesWithThreadSafeLibraryFunct
   return ;
 }
 
+void LoopDependenceInfo::removeUnnecessaryDependenciesThatRuntimeAliasChecksNegate (
+  StayConnectedNestedLoopForestNode *loopNode,
+  PDG *loopDG,
+  LoopIterationDomainSpaceAnalysis &domainSpace,
+  ScalarEvolution &SE
+){
+
+  /*
+   * Every check runs at every invocation of the loop.
+   * Hence, we give up if too many of them are needed.
+   */
+  uint32_t maximumNumberOfChecks = 8;
+
+  /*
+   * Fetch the loop sub-tree rooted at @this.
+   */
+  auto rootLoop = loopNode->getLoop();
+
+  /*
+   * Group the memory dependences that may exist between different instructions of the loop by the pair of instructions involved.
+   * Dependences that must exist cannot be removed.
+   * Instructions are visited in the order they appear in the function to generate the same checks at every compilation.
+   */
+  std::vector<std::pair<Instruction *, Instruction *>> pairs;
+  std::map<std::pair<Instruction *, Instruction *>, std::unordered_set<DGEdge<Value> *>> dependencesOfPair;
+  for (auto &bb : *rootLoop->getFunction()){
+    if (!rootLoop->isIncluded(&bb)){
+      continue ;
+    }
+    for (auto &I : bb){
+      auto producer = &I;
+      if (!loopDG->isInGraph(producer)){
+        continue ;
+      }
+      for (auto edge : loopDG->fetchNode(producer)->getOutgoingEdges()){
+        if (  false
+              || (!edge->isMemoryDependence())
+              || edge->isMustDependence()
+           ){
+          continue ;
+        }
+        auto consumer = dyn_cast<Instruction>(edge->getIncomingT());
+        if (  false
+              || (consumer == nullptr)
+              || (consumer == producer)
+              || (!rootLoop->isIncluded(consumer))
+           ){
+          continue ;
+        }
+        auto instPair = std::make_pair(producer, consumer);
+        if (dependencesOfPair.find(std::make_pair(consumer, producer)) != dependencesOfPair.end()){
+          instPair = std::make_pair(consumer, producer);
+        }
+        if (dependencesOfPair.find(instPair) == dependencesOfPair.end()){
+          pairs.push_back(instPair);
+        }
+        dependencesOfPair[instPair].insert(edge);
+      }
+    }
+  }
+
+  /*
+   * Identify the pairs of instructions that can be checked at run time.
+   *
+   * The ranges of addresses they access during the whole loop invocation must be computable before the loop starts.
+   * Furthermore, their pointers must be derived from different bases.
+   * Accesses to the same object (e.g., a[i] and a[i+1]) would always overlap, so checking them would only waste time.
+   */
+  std::vector<std::pair<Instruction *, Instruction *>> pairsToCheck;
+  for (auto instPair : pairs){
+    auto range1 = domainSpace.getRangeOfAddressesAccessedByTheLoop(instPair.first, SE);
+    auto range2 = domainSpace.getRangeOfAddressesAccessedByTheLoop(instPair.second, SE);
+    if (  false
+          || (range1.first == nullptr)
+          || (range2.first == nullptr)
+       ){
+      continue ;
+    }
+    auto pointer1 = getLoadStorePointerOperand(instPair.first);
+    auto pointer2 = getLoadStorePointerOperand(instPair.second);
+    if (SE.getPointerBase(SE.getSCEV(pointer1)) == SE.getPointerBase(SE.getSCEV(pointer2))){
+      continue ;
+    }
+    pairsToCheck.push_back(instPair);
+  }
+  if (  false
+        || (pairsToCheck.size() == 0)
+        || (pairsToCheck.size() > maximumNumberOfChecks)
+     ){
+    return ;
+  }
+
+  /*
+   * Remove the dependences.
+   * The code generated from the dependence graph must check that the accesses are disjoint before running.
+   */
+  for (auto instPair : pairsToCheck){
+    for (auto edge : dependencesOfPair[instPair]){
+      edge->setLoopCarried(false);
+      loopDG->removeEdge(edge);
+    }
+    this->memoryAccessesAssumedToBeDisjoint.push_back(instPair);
+  }
+
+  return ;
+}
+
 void LoopDependenceInfo::removeUnnecessaryDependenciesThatCloningMemoryNegates (
   StayConnectedNestedLoopForestNode *loopNode,
   PDG *loopInternalDG,
@@ -576,6 +712,10 @@ LoopIterationDomainSpaceAnalysis * LoopDependenceInfo::getLoopIterationDomainSpa
   return this->domainSpaceAnalysis;
 }
 
+const std::vector<std::pair<Instruction *, Instruction *>> & LoopDependenceInfo::getMemoryAccessesAssumedToBeDisjoint (void) const {
+  return this->memoryAccessesAssumedToBeDisjoint;
+}
+
 StayConnectedNestedLoopForestNode * LoopDependenceInfo::getLoopHierarchyStructures (void) const {
   return this->loop;
 }
@@ -66,6 +66,88 @@ bool LoopIterationDomainSpaceAnalysis::areInstructionsAccessingDisjointMemoryLoc
   return (accessSpaceI == accessSpaceJ) || isMemoryAccessSpaceEquivalentForTopLoopIVSubscript(accessSpaceI, accessSpaceJ);
 }
 
+std::pair<const SCEV *, const SCEV *> LoopIterationDomainSpaceAnalysis::getRangeOfAddressesAccessedByTheLoop (
+  Instruction *memoryAccessor,
+  ScalarEvolution &SE
+) const {
+  std::pair<const SCEV *, const SCEV *> unknownRange{nullptr, nullptr};
+
+  /*
+   * Fetch the pointer used by the memory access and the type of the value accessed.
+   */
+  Value *pointer = nullptr;
+  Type *accessedType = nullptr;
+  if (auto loadInst = dyn_cast<LoadInst>(memoryAccessor)){
+    pointer = loadInst->getPointerOperand();
+    accessedType = loadInst->getType();
+  } else if (auto storeInst = dyn_cast<StoreInst>(memoryAccessor)){
+    pointer = storeInst->getPointerOperand();
+    accessedType = storeInst->getValueOperand()->getType();
+  } else {
+    return unknownRange;
+  }
+  if (!SE.isSCEVable(pointer->getType())){
+    return unknownRange;
+  }
+
+  /*
+   * Compute the number of bytes accessed.
+   */
+  auto &DL = memoryAccessor->getModule()->getDataLayout();
+  auto intPtrType = DL.getIntPtrType(pointer->getType());
+  auto accessSize = SE.getConstant(intPtrType, DL.getTypeStoreSize(accessedType));
+
+  /*
+   * Pointers computed before the loop point to the same location at every iteration.
+   */
+  auto rootLoopStructure = this->loops->getLoop();
+  auto pointerSCEV = SE.getSCEV(pointer);
+  auto pointerInst = dyn_cast<Instruction>(pointer);
+  if (  false
+        || (pointerInst == nullptr)
+        || (!rootLoopStructure->isIncluded(pointerInst))
+     ){
+    return std::make_pair(pointerSCEV, SE.getAddExpr(pointerSCEV, accessSize));
+  }
+
+  /*
+   * The pointer must move by a constant stride at every iteration of the outermost loop.
+   * Pointers that evolve within nested loops are not handled.
+   */
+  auto addRec = dyn_cast<SCEVAddRecExpr>(pointerSCEV);
+  if (  false
+        || (addRec == nullptr)
+        || (!addRec->isAffine())
+        || (addRec->getLoop()->getHeader() != rootLoopStructure->getHeader())
+     ){
+    return unknownRange;
+  }
+
+  /*
+   * The number of iterations must be known before the loop starts.
+   */
+  auto backedgeTakenCount = SE.getBackedgeTakenCount(addRec->getLoop());
+  if (isa<SCEVCouldNotCompute>(backedgeTakenCount)){
+    return unknownRange;
+  }
+
+  /*
+   * Compute the addresses accessed by the first and the last iterations.
+   * The last iteration might not reach the access, so the range can include bytes that are never accessed.
+   */
+  auto step = addRec->getStepRecurrence(SE);
+  auto firstAddress = addRec->getStart();
+  auto lastAddress = addRec->evaluateAtIteration(backedgeTakenCount, SE);
+  if (SE.isKnownNonNegative(step)){
+    return std::make_pair(firstAddress, SE.getAddExpr(lastAddress, accessSize));
+  }
+  if (SE.isKnownNegative(step)){
+    return std::make_pair(lastAddress, SE.getAddExpr(firstAddress, accessSize));
+  }
+
+  return unknownRange;
+}
+
 bool LoopIterationDomainSpaceAnalysis::isMemoryAccessSpaceEquivalentForTopLoopIVSubscript (
   MemoryAccessSpace *space1,
   MemoryAccessSpace *space2
@@ -8,6 +8,7 @@
  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include "noelle/core/Utils.hpp"
 #include "noelle/core/MemoryCloningAnalysis.hpp"
 
 using namespace llvm;
@@ -81,6 +82,84 @@ MemoryCloningAnalysis::MemoryCloningAnalysis (
     this->clonableMemoryLocations.insert(std::move(location));
   }
 
+  /*
+   * Collect the global variables and the heap objects accessed by the loop.
+   *
+   * Heap objects must be allocated before the loop starts.
+   * Their size must be known at compile time.
+   */
+  std::unordered_map<Value *, uint64_t> globalAndHeapObjects;
+  auto loopHeader = loop->getHeader();
+  for (auto inst : loop->getInstructions()){
+    for (auto &op : inst->operands()){
+
+      /*
+       * Fetch the object the operand points to.
+       */
+      auto object = op.get()->stripInBoundsOffsets();
+      if (globalAndHeapObjects.find(object) != globalAndHeapObjects.end()){
+        continue ;
+      }
+
+      /*
+       * Check if the object is a global variable that only the current module can access.
+       * The private copies are allocated by malloc, so the global variable cannot require an alignment bigger than what malloc guarantees.
+       */
+      if (auto globalVar = dyn_cast<GlobalVariable>(object)){
+        if (  false
+              || globalVar->isConstant()
+              || (!globalVar->hasLocalLinkage())
+              || (!globalVar->hasDefinitiveInitializer())
+              || globalVar->isThreadLocal()
+              || (globalVar->getAlignment() > 16)
+           ){
+          continue ;
+        }
+        auto sizeInBits = DL.getTypeAllocSizeInBits(globalVar->getValueType());
+        globalAndHeapObjects[globalVar] = sizeInBits;
+        continue ;
+      }
+
+      /*
+       * Check if the object is allocated by malloc or calloc before the loop.
+       */
+      auto call = dyn_cast<CallInst>(object);
+      if (  false
+            || (call == nullptr)
+            || (!Utils::isAllocator(call))
+            || Utils::isReallocator(call)
+            || loop->isIncluded(call)
+            || (!DS.DT.dominates(call->getParent(), loopHeader))
+         ){
+        continue ;
+      }
+      uint64_t sizeInBytes = 1;
+      for (auto i = 0u; i < call->getNumArgOperands(); i++){
+        auto argConst = dyn_cast<ConstantInt>(call->getArgOperand(i));
+        if (argConst == nullptr){
+          sizeInBytes = 0;
+          break ;
+        }
+        sizeInBytes *= argConst->getZExtValue();
+      }
+      if (sizeInBytes == 0){
+        continue ;
+      }
+      globalAndHeapObjects[call] = sizeInBytes * 8;
+    }
+  }
+
+  /*
+   * Check each global and heap object.
+   */
+  for (auto objectPair : globalAndHeapObjects){
+    auto location = std::make_unique<ClonableMemoryLocation>(objectPair.first, objectPair.second, loop, DS, ldg);
+    if (!location->isClonableLocation()) {
+      continue;
+    }
+    this->clonableMemoryLocations.insert(std::move(location));
+  }
+
   return ;
 }
 
@@ -164,6 +243,11 @@ bool ClonableMemoryLocation::mustAliasAMemoryLocationWithinObject (Value *ptr) c
       return true;
     }
   }
+  for (auto aliasPtr : this->constantCastsAndGEPs){
+    if (aliasPtr == ptr){
+      return true;
+    }
+  }
 
   return false;
 }
@@ -190,7 +274,7 @@ std::unordered_set<Instruction *> ClonableMemoryLocation::getLoopInstructionsUsi
 }
 
 ClonableMemoryLocation::ClonableMemoryLocation (
-  AllocaInst *allocation,
+  Value *allocation,
   uint64_t sizeInBits,
   LoopStructure *loop,
   DominatorSummary &DS,
@@ -204,17 +288,32 @@ ClonableMemoryLocation::ClonableMemoryLocation (
 
   // allocation->print(errs() << "Examining alloca: "); errs() << "\n";
 
+  /*
+   * Fetch the type of the object.
+   * The type of heap objects is unknown, so we consider them as arrays of bytes.
+   */
+  if (auto stackObject = dyn_cast<AllocaInst>(allocation)){
+    this->allocatedType = stackObject->getAllocatedType();
+  } else if (auto globalObject = dyn_cast<GlobalVariable>(allocation)){
+    this->allocatedType = globalObject->getValueType();
+  } else {
+    this->allocatedType = IntegerType::get(allocation->getContext(), 8);
+  }
+
   /*
    * Check if the current stack object's scope is the loop.
+   * The scope of global and heap objects always goes beyond the loop.
    */
-  this->setObjectScope(allocation, loop, DS);
+  if (this->isStackObject()){
+    this->setObjectScope(allocation, loop, DS);
+  }
 
   /*
-   * Only consider struct and integer types for objects that has scope outside the loop.
+   * Only consider struct and integer types for stack objects that has scope outside the loop.
    * TODO: Remove this when array/vector types are supported
    */
-  this->allocatedType = allocation->getAllocatedType();
   if (  true
+        && this->isStackObject()
         && (!this->isScopeWithinLoop)
         && (!allocatedType->isStructTy())
         && (!allocatedType->isIntegerTy()) 
@@ -254,7 +353,7 @@ ClonableMemoryLocation::ClonableMemoryLocation (
 }
 
 void ClonableMemoryLocation::setObjectScope (
-  AllocaInst *allocation,
+  Value *allocation,
   LoopStructure *loop,
   DominatorSummary &ds
   ) {
@@ -297,10 +396,26 @@ void ClonableMemoryLocation::setObjectScope (
   return ;
 }
 
-AllocaInst * ClonableMemoryLocation::getAllocation (void) const {
+Value * ClonableMemoryLocation::getAllocation (void) const {
   return this->allocation;
 }
 
+bool ClonableMemoryLocation::isStackObject (void) const {
+  return isa<AllocaInst>(this->allocation);
+}
+
+bool ClonableMemoryLocation::isGlobalObject (void) const {
+  return isa<GlobalVariable>(this->allocation);
+}
+
+bool ClonableMemoryLocation::isHeapObject (void) const {
+  return isa<CallInst>(this->allocation);
+}
+
+uint64_t ClonableMemoryLocation::getSizeInBits (void) const {
+  return this->sizeInBits;
+}
+
 bool ClonableMemoryLocation::isClonableLocation (void) const {
   return this->isClonable;
 }
@@ -329,13 +444,25 @@ bool ClonableMemoryLocation::isMemCpyInstrinsicCall (CallInst *call) {
   return nameString.find("llvm.memcpy") != std::string::npos;
 }
 
+bool ClonableMemoryLocation::isMemSetInstrinsicCall (CallInst *call) {
+  auto calledFn = call->getCalledFunction();
+  if (!calledFn || !calledFn->hasName()) return false;
+  auto name = calledFn->getName();
+  std::string nameString = std::string(name.bytes_begin(), name.bytes_end());
+  return nameString.find("llvm.memset") != std::string::npos;
+}
+
 bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, DominatorSummary &DS) {
 
   /*
    * Determine all uses of the stack location.
    * Ensure they only exist within the loop provided.
+   *
+   * Global and heap objects can be accessed by code outside the function, so their private copies must be invisible to the rest of the program.
+   * Hence, their pointers cannot escape and they can only be accessed within the loop (heap objects can also be freed after it).
    */
-  std::queue<Instruction *> allocationUses{};
+  auto isStack = this->isStackObject();
+  std::queue<Value *> allocationUses{};
   allocationUses.push(this->allocation);
   while (!allocationUses.empty()) {
 
@@ -350,6 +477,21 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
      */
     for (auto user : I->users()) {
 
+      /*
+       * Global variables are used through constant expressions.
+       */
+      if (auto constExpr = dyn_cast<ConstantExpr>(user)) {
+        if (  true
+              && (!constExpr->isCast())
+              && (constExpr->getOpcode() != Instruction::GetElementPtr)
+           ){
+          return false;
+        }
+        allocationUses.push(constExpr);
+        this->constantCastsAndGEPs.insert(constExpr);
+        continue;
+      }
+
       /*
        * Find storing and non-storing instructions
        */
@@ -375,6 +517,16 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
       } 
       if (auto store = dyn_cast<StoreInst>(user)) {
 
+        /*
+         * The pointer of global and heap objects cannot be stored in memory.
+         */
+        if (  true
+              && (!isStack)
+              && (store->getValueOperand() == I)
+           ){
+          return false;
+        }
+
         /*
          * As straightforward as it gets
          */
@@ -398,23 +550,47 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
         }
 
         /*
-         * We consider llvm.memcpy as a storing instruction if the use is the dest (first operand) 
+         * Heap objects can be freed after the loop.
+         */
+        if (  true
+              && this->isHeapObject()
+              && Utils::isDeallocator(call)
+           ){
+          if (loop->isIncluded(call)){
+            return false;
+          }
+          this->deallocatingInstructions.insert(call);
+          continue;
+        }
+
+        /*
+         * We consider llvm.memcpy and llvm.memset as storing instructions if the use is the dest (first operand) 
          */
         auto isMemCpy = ClonableMemoryLocation::isMemCpyInstrinsicCall(call);
+        auto isMemSet = ClonableMemoryLocation::isMemSetInstrinsicCall(call);
         auto isUseTheDestinationOp = (call->getNumArgOperands() == 4) && (call->getArgOperand(0) == I);
         auto isUseTheSourceOp = (call->getNumArgOperands() == 4) && (call->getArgOperand(1) == I);
-        if (isMemCpy && isUseTheDestinationOp) {
+        if ((isMemCpy || isMemSet) && isUseTheDestinationOp) {
           storingInstructions.insert(call);
 
         } else if (isMemCpy && isUseTheSourceOp) {
           loadInstructions.insert(call);
 
+        } else if (!isStack) {
+          return false;
+
         } else {
           this->nonStoringInstructions.insert(call);
         }
 
       } else if (auto inst = dyn_cast<Instruction>(user)) {
 
+        /*
+         * Other instructions could let the pointer of global and heap objects escape.
+         */
+        if (!isStack) {
+          return false;
+        }
         this->nonStoringInstructions.insert(inst);
 
       } else {
@@ -431,6 +607,9 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
        */
       auto inst = cast<Instruction>(user);
       if (!loop->isIncluded(inst)) {
+        if (!isStack) {
+          return false;
+        }
         auto block = inst->getParent();
         auto header = loop->getHeader();
         if (!DS.DT.dominates(block, header)) {
@@ -452,7 +631,7 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
 
 bool ClonableMemoryLocation::isThereRAWThroughMemoryFromOutsideLoop (
   LoopStructure *loop, 
-  AllocaInst *al, 
+  Value *al, 
   PDG *ldg, 
   std::unordered_set<Instruction *> insts
   ) const {
@@ -523,7 +702,7 @@ bool ClonableMemoryLocation::isThereRAWThroughMemoryFromOutsideLoop (
   return false;
 }
         
-bool ClonableMemoryLocation::isThereRAWThroughMemoryFromOutsideLoop (LoopStructure *loop, AllocaInst *al, PDG *ldg) const {
+bool ClonableMemoryLocation::isThereRAWThroughMemoryFromOutsideLoop (LoopStructure *loop, Value *al, PDG *ldg) const {
 
   /*
    * Check every read of the stack object.
@@ -664,9 +843,12 @@ bool ClonableMemoryLocation::isOverrideSetFullyCoveringTheAllocationSpace (
       auto pointerOperand = store->getPointerOperand();
 
       /*
-       * If the pointer is the returned value of an alloca, then @store is initializing the whole memory object.
+       * If the pointer is a stack or global object, then @store is initializing the whole memory object.
        */
-      if (dyn_cast<AllocaInst>(pointerOperand)) {
+      if (  true
+            && (pointerOperand == this->allocation)
+            && (!this->isHeapObject())
+         ) {
 
         /*
          * The allocation is stored directly to and is completely overriden
@@ -674,7 +856,19 @@ bool ClonableMemoryLocation::isOverrideSetFullyCoveringTheAllocationSpace (
         return true;
       } 
 
-      if (auto gep = dyn_cast<GetElementPtrInst>(pointerOperand)) {
+      /*
+       * If the pointer is a cast of the object, then @store is initializing the whole memory object only if it stores as many bits as the object has.
+       */
+      if (pointerOperand->stripPointerCasts() == this->allocation) {
+        auto &DL = store->getModule()->getDataLayout();
+        auto bitsStored = DL.getTypeStoreSizeInBits(store->getValueOperand()->getType());
+        if (this->sizeInBits == bitsStored) {
+          return true;
+        }
+        continue;
+      }
+
+      if (auto gep = dyn_cast<GEPOperator>(pointerOperand)) {
 
         // gep->print(errs() << "Examining GEP for coverage: "); errs() << "\n";
 
@@ -704,9 +898,12 @@ bool ClonableMemoryLocation::isOverrideSetFullyCoveringTheAllocationSpace (
       }
 
     } else if (auto call = dyn_cast<CallInst>(storingInstruction)) {
-      assert(ClonableMemoryLocation::isMemCpyInstrinsicCall(call));
+      assert(  false
+               || ClonableMemoryLocation::isMemCpyInstrinsicCall(call)
+               || ClonableMemoryLocation::isMemSetInstrinsicCall(call)
+            );
 
-      // call->print(errs() << "Examining llvm.memcpy call: "); errs() << "\n";
+      // call->print(errs() << "Examining llvm.memcpy/llvm.memset call: "); errs() << "\n";
 
       /*
        * Naively require that the whole allocation is written to
@@ -722,7 +919,7 @@ bool ClonableMemoryLocation::isOverrideSetFullyCoveringTheAllocationSpace (
     }
   }
 
-  if (this->allocation->getAllocatedType()->isStructTy()) {
+  if (this->allocatedType->isStructTy()) {
 
     // errs() << "Number of elements covered: " << structElementsStoredTo.size() << " versus struct element number: " << this->allocatedType->getStructNumElements() << "\n";
 
@@ -156,6 +156,14 @@ void SCCAttrs::collectPHIsAndAccumulators (LoopStructure &LS) {
         this->accumulators.insert(I);
         continue;
       }
+
+      /*
+       * Check if this is a min/max.
+       */
+      if (accumOpInfo.isMinMaxOp(I)) {
+        this->accumulators.insert(I);
+        continue;
+      }
     }
   }
 
@@ -263,8 +271,8 @@ void SCCAttrs::addClonableMemoryLocationsContainedInSCC (std::unordered_set<cons
   this->clonableMemoryLocations = locations;
 }
 
-std::unordered_set<AllocaInst *> SCCAttrs::getMemoryLocationsToClone (void) const {
-  std::unordered_set<AllocaInst *> allocations;
+std::unordered_set<Value *> SCCAttrs::getMemoryLocationsToClone (void) const {
+  std::unordered_set<Value *> allocations;
   for (auto location : clonableMemoryLocations) {
     allocations.insert(location->getAllocation());
   }
@@ -86,7 +86,7 @@ SCCDAGAttrs::SCCDAGAttrs (
     if (this->checkIfIndependent(scc)) {
       sccInfo->setType(SCCAttrs::SCCType::INDEPENDENT);
 
-    } else if (this->checkIfReducible(scc, loopNode)) {
+    } else if (this->checkIfReducible(scc, loopNode, ivs)) {
       sccInfo->setType(SCCAttrs::SCCType::REDUCIBLE);
 
     } else {
@@ -96,6 +96,11 @@ SCCDAGAttrs::SCCDAGAttrs (
     return false;
   });
 
+  /*
+   * Paired reductions can only be reduced together with the min/max reductions that select their values.
+   */
+  this->checkIfPairedReductionsAreComplete(loopNode);
+
   collectSCCGraphAssumingDistributedClones();
 
   return ;
@@ -275,6 +280,58 @@ SCCAttrs * SCCDAGAttrs::getSCCAttrs (SCC *scc) const {
   return sccInfo->second;
 }
 
+CmpInst::Predicate SCCDAGAttrs::getMinMaxPredicateOfReduction (SCC *scc) {
+
+  /*
+   * Fetch the variable and the single instruction that accumulates its values.
+   */
+  auto sccInfo = this->getSCCAttrs(scc);
+  auto headerPHI = sccInfo->getSingleHeaderPHI();
+  auto accumulator = sccInfo->getSingleAccumulator();
+  if (  false
+        || (!sccInfo->canExecuteReducibly())
+        || (headerPHI == nullptr)
+        || (accumulator == nullptr)
+    ){
+    return CmpInst::BAD_ICMP_PREDICATE;
+  }
+
+  return this->accumOpInfo.getMinMaxPredicate(accumulator, headerPHI);
+}
+
+SCC * SCCDAGAttrs::getMinMaxSCCOfPairedReduction (SCC *scc) const {
+  auto pairedReduction = this->pairedReductions.find(scc);
+  if (pairedReduction == this->pairedReductions.end()){
+    return nullptr;
+  }
+
+  return pairedReduction->second.first;
+}
+
+CmpInst::Predicate SCCDAGAttrs::getTieBreakPredicateOfPairedReduction (SCC *scc) const {
+  assert(this->pairedReductions.find(scc) != this->pairedReductions.end());
+
+  return this->pairedReductions.at(scc).second;
+}
+
+ArrayReduction * SCCDAGAttrs::getArrayReduction (SCC *scc) const {
+  auto arrayReduction = this->arrayReductions.find(scc);
+  if (arrayReduction == this->arrayReductions.end()){
+    return nullptr;
+  }
+
+  return arrayReduction->second;
+}
+
+std::unordered_set<ArrayReduction *> SCCDAGAttrs::getArrayReductions (void) const {
+  std::unordered_set<ArrayReduction *> reductions;
+  for (auto pair : this->arrayReductions){
+    reductions.insert(pair.second);
+  }
+
+  return reductions;
+}
+
 void SCCDAGAttrs::collectSCCGraphAssumingDistributedClones () {
   auto addIncomingNodes = [&](std::queue<DGNode<SCC> *> &queue, DGNode<SCC> *node) -> void {
     std::set<DGNode<SCC> *> nodes;
@@ -413,7 +470,8 @@ bool SCCDAGAttrs::checkIfSCCOnlyContainsInductionVariables (
 
 bool SCCDAGAttrs::checkIfReducible (
   SCC *scc,
-  StayConnectedNestedLoopForestNode *loopNode
+  StayConnectedNestedLoopForestNode *loopNode,
+  std::set<InductionVariable *> &IVs
   ){
 
   /*
@@ -422,6 +480,15 @@ bool SCCDAGAttrs::checkIfReducible (
    */
   auto rootLoop = loopNode->getLoop();
   auto rootLoopHeader = rootLoop->getHeader();
+
+  /*
+   * Check if the SCC accumulates values to elements of an array (e.g., a histogram).
+   * Such SCC can be reduced by privatizing the array.
+   */
+  if (this->isArrayReduction(scc, loopNode)){
+    return true;
+  }
+
   std::unordered_set<PHINode *> loopCarriedPHIs{};
   for (auto dependency : this->sccToLoopCarriedDependencies.at(scc)) {
 
@@ -490,6 +557,20 @@ bool SCCDAGAttrs::checkIfReducible (
    */
   auto variable = new LoopCarriedVariable(*rootLoop, loopNode, *loopDG, *sccdag, *scc, singleLoopCarriedPHI);
   if (!variable->isEvolutionReducibleAcrossLoopIterations()) {
+
+    /*
+     * The variable does not evolve through commutative and associative arithmetic operations.
+     * Check if it is a min/max or a paired (e.g., argmin/argmax) reduction.
+     */
+    if (  false
+          || this->isMinMaxReduction(scc, loopNode, singleLoopCarriedPHI)
+          || this->isPairedReduction(scc, loopNode, singleLoopCarriedPHI, IVs)
+      ){
+      auto sccInfo = this->getSCCAttrs(scc);
+      sccInfo->addLoopCarriedVariable(variable);
+      return true;
+    }
+
     delete variable;
     return false;
   }
@@ -519,6 +600,580 @@ bool SCCDAGAttrs::checkIfReducible (
   return true;
 }
 
+bool SCCDAGAttrs::isArrayReduction (
+  SCC *scc,
+  StayConnectedNestedLoopForestNode *loopNode
+  ){
+
+  /*
+   * The SCC must only include the load of an element, its update, and the store of the updated value.
+   */
+  LoadInst *load = nullptr;
+  BinaryOperator *update = nullptr;
+  StoreInst *store = nullptr;
+  for (auto nodePair : scc->internalNodePairs()) {
+    auto value = nodePair.first;
+    if (  true
+          && isa<LoadInst>(value)
+          && (load == nullptr)
+          && cast<LoadInst>(value)->isSimple()
+       ){
+      load = cast<LoadInst>(value);
+      continue ;
+    }
+    if (  true
+          && isa<BinaryOperator>(value)
+          && (update == nullptr)
+       ){
+      update = cast<BinaryOperator>(value);
+      continue ;
+    }
+    if (  true
+          && isa<StoreInst>(value)
+          && (store == nullptr)
+          && cast<StoreInst>(value)->isSimple()
+       ){
+      store = cast<StoreInst>(value);
+      continue ;
+    }
+    return false;
+  }
+  if (  false
+        || (load == nullptr)
+        || (update == nullptr)
+        || (store == nullptr)
+    ){
+    return false;
+  }
+
+  /*
+   * The updated element must be stored back to the same address it has been loaded from.
+   */
+  auto gep = dyn_cast<GetElementPtrInst>(load->getPointerOperand());
+  if (  false
+        || (gep == nullptr)
+        || (store->getPointerOperand() != gep)
+        || (store->getValueOperand() != update)
+    ){
+    return false;
+  }
+
+  /*
+   * The update must accumulate a value computed outside the SCC to the element through a commutative and associative operation.
+   * Subtractions are accumulated as additions of negated values, so the element must be their first operand.
+   */
+  auto elementType = load->getType();
+  switch (update->getOpcode()) {
+    case Instruction::Add:
+    case Instruction::Mul:
+    case Instruction::Or:
+    case Instruction::And:
+    case Instruction::Xor:
+    case Instruction::Sub:
+      break ;
+    case Instruction::FAdd:
+    case Instruction::FMul:
+    case Instruction::FSub:
+      if (!this->enableFloatAsReal){
+        return false;
+      }
+      break ;
+    default:
+      return false;
+  }
+  if (  false
+        || (  true
+              && (update->getOperand(0) != load)
+              && (update->getOperand(1) != load)
+           )
+        || (update->getOperand(0) == update->getOperand(1))
+    ){
+    return false;
+  }
+  if (  true
+        && (  false
+              || (update->getOpcode() == Instruction::Sub)
+              || (update->getOpcode() == Instruction::FSub)
+           )
+        && (update->getOperand(0) != load)
+    ){
+    return false;
+  }
+  if (  true
+        && (!elementType->isIntegerTy(8))
+        && (!elementType->isIntegerTy(16))
+        && (!elementType->isIntegerTy(32))
+        && (!elementType->isIntegerTy(64))
+        && (!elementType->isFloatTy())
+        && (!elementType->isDoubleTy())
+    ){
+    return false;
+  }
+
+  /*
+   * Intermediate values cannot be used otherwise.
+   */
+  if (  false
+        || (!load->hasOneUse())
+        || (!update->hasOneUse())
+    ){
+    return false;
+  }
+  for (auto user : gep->users()){
+    if (  true
+          && (user != load)
+          && (user != store)
+      ){
+      return false;
+    }
+  }
+
+  /*
+   * The address of the element must be computed within the loop by indexing an array that is the same for all iterations.
+   */
+  auto rootLoop = loopNode->getLoop();
+  if (  false
+        || (!rootLoop->isIncluded(gep))
+        || (loopNode->getInnermostLoopThatContains(store) != rootLoop)
+    ){
+    return false;
+  }
+  auto isArrayIndexing = false;
+  if (gep->getNumIndices() == 1){
+    isArrayIndexing = true;
+  } else if (gep->getNumIndices() == 2){
+    auto firstIndex = dyn_cast<ConstantInt>(gep->getOperand(1));
+    isArrayIndexing = true
+                      && isa<ArrayType>(gep->getSourceElementType())
+                      && (firstIndex != nullptr)
+                      && firstIndex->isZero();
+  }
+  if (!isArrayIndexing){
+    return false;
+  }
+  auto baseObject = gep->getPointerOperand();
+  if (auto baseInst = dyn_cast<Instruction>(baseObject)){
+    if (rootLoop->isIncluded(baseInst)){
+      return false;
+    }
+  } else if (  true
+               && (!isa<Argument>(baseObject))
+               && (!isa<GlobalVariable>(baseObject))
+            ){
+    return false;
+  }
+
+  /*
+   * No other instruction of the loop can access the elements of the array.
+   */
+  for (auto inst : { cast<Instruction>(load), cast<Instruction>(store) }){
+    auto node = this->loopDG->fetchNode(inst);
+    for (auto edge : node->getAllConnectedEdges()){
+      if (!edge->isMemoryDependence()){
+        continue ;
+      }
+      auto otherValue = (edge->getOutgoingT() == inst) ? edge->getIncomingT() : edge->getOutgoingT();
+      if (scc->isInternal(otherValue)){
+        continue ;
+      }
+      auto otherInst = dyn_cast<Instruction>(otherValue);
+      if (  true
+            && (otherInst != nullptr)
+            && rootLoop->isIncluded(otherInst)
+         ){
+        return false;
+      }
+    }
+  }
+
+  /*
+   * The SCC accumulates values to elements of the array.
+   */
+  this->arrayReductions[scc] = new ArrayReduction(load, update, store);
+
+  return true;
+}
+
+bool SCCDAGAttrs::isMinMaxReduction (
+  SCC *scc,
+  StayConnectedNestedLoopForestNode *loopNode,
+  PHINode *loopCarriedPHI
+  ){
+
+  /*
+   * The variable must be declared in the header of the loop.
+   */
+  auto rootLoop = loopNode->getLoop();
+  auto preHeader = rootLoop->getPreHeader();
+  if (  false
+        || (preHeader == nullptr)
+        || (loopCarriedPHI->getParent() != rootLoop->getHeader())
+        || (loopCarriedPHI->getBasicBlockIndex(preHeader) == -1)
+    ){
+    return false;
+  }
+
+  /*
+   * Fetch the single min/max that produces the values of the variable for the next iteration.
+   */
+  Instruction *accumulator = nullptr;
+  for (uint32_t i = 0; i < loopCarriedPHI->getNumIncomingValues(); ++i) {
+    if (loopCarriedPHI->getIncomingBlock(i) == preHeader) {
+      continue ;
+    }
+    auto incomingInst = dyn_cast<Instruction>(loopCarriedPHI->getIncomingValue(i));
+    if (  false
+          || (incomingInst == nullptr)
+          || ((accumulator != nullptr) && (accumulator != incomingInst))
+          || (!this->accumOpInfo.isMinMaxOp(incomingInst))
+      ){
+      return false;
+    }
+    accumulator = incomingInst;
+  }
+  if (accumulator == nullptr){
+    return false;
+  }
+  auto predicate = this->accumOpInfo.getMinMaxPredicate(accumulator, loopCarriedPHI);
+  if (predicate == CmpInst::BAD_ICMP_PREDICATE){
+    return false;
+  }
+
+  /*
+   * The min/max must be executed once per iteration of the loop.
+   */
+  if (loopNode->getInnermostLoopThatContains(accumulator) != rootLoop){
+    return false;
+  }
+
+  /*
+   * The SCC must only include the variable, the min/max, and the comparison that drives the latter.
+   */
+  Instruction *condition = nullptr;
+  if (auto selectInst = dyn_cast<SelectInst>(accumulator)){
+    condition = cast<Instruction>(selectInst->getCondition());
+  }
+  for (auto nodePair : scc->internalNodePairs()) {
+    auto value = nodePair.first;
+    if (  false
+          || (value == loopCarriedPHI)
+          || (value == accumulator)
+          || (value == condition)
+      ){
+      continue ;
+    }
+    return false;
+  }
+
+  /*
+   * Comparisons between floating point values do not distinguish -0 from +0.
+   * Hence, which zero a select-based min/max returns depends on the order of the values, which is acceptable only if floating point values can be considered real numbers.
+   * llvm.minnum/llvm.maxnum do not specify which zero they return.
+   */
+  if (  true
+        && isa<SelectInst>(accumulator)
+        && CmpInst::isFPPredicate(predicate)
+        && (!this->enableFloatAsReal)
+    ){
+    return false;
+  }
+
+  /*
+   * Intermediate values cannot be used within the loop.
+   * The only exception is the comparison, which can select the values of paired variables (e.g., argmin/argmax).
+   */
+  for (auto inst : { cast<Instruction>(loopCarriedPHI), accumulator, condition }){
+    if (inst == nullptr){
+      continue ;
+    }
+    for (auto user : inst->users()){
+      auto userInst = dyn_cast<Instruction>(user);
+      if (  false
+            || (userInst == nullptr)
+            || (!rootLoop->isIncluded(userInst))
+            || scc->isInternal(userInst)
+        ){
+        continue ;
+      }
+      if (  true
+            && (inst == condition)
+            && isa<SelectInst>(userInst)
+            && (cast<SelectInst>(userInst)->getTrueValue() != condition)
+            && (cast<SelectInst>(userInst)->getFalseValue() != condition)
+        ){
+        continue ;
+      }
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool SCCDAGAttrs::isPairedReduction (
+  SCC *scc,
+  StayConnectedNestedLoopForestNode *loopNode,
+  PHINode *loopCarriedPHI,
+  std::set<InductionVariable *> &IVs
+  ){
+
+  /*
+   * The variable must be an integer declared in the header of the loop.
+   */
+  auto rootLoop = loopNode->getLoop();
+  auto rootLoopHeader = rootLoop->getHeader();
+  auto preHeader = rootLoop->getPreHeader();
+  if (  false
+        || (preHeader == nullptr)
+        || (loopCarriedPHI->getParent() != rootLoopHeader)
+        || (loopCarriedPHI->getBasicBlockIndex(preHeader) == -1)
+        || (!loopCarriedPHI->getType()->isIntegerTy())
+    ){
+    return false;
+  }
+
+  /*
+   * Fetch the single select that produces the values of the variable for the next iteration.
+   */
+  SelectInst *selectInst = nullptr;
+  for (uint32_t i = 0; i < loopCarriedPHI->getNumIncomingValues(); ++i) {
+    if (loopCarriedPHI->getIncomingBlock(i) == preHeader) {
+      continue ;
+    }
+    auto incomingSelect = dyn_cast<SelectInst>(loopCarriedPHI->getIncomingValue(i));
+    if (  false
+          || (incomingSelect == nullptr)
+          || ((selectInst != nullptr) && (selectInst != incomingSelect))
+      ){
+      return false;
+    }
+    selectInst = incomingSelect;
+  }
+  if (  false
+        || (selectInst == nullptr)
+        || (loopNode->getInnermostLoopThatContains(selectInst) != rootLoop)
+    ){
+    return false;
+  }
+
+  /*
+   * The SCC must only include the variable and the select.
+   */
+  for (auto nodePair : scc->internalNodePairs()) {
+    auto value = nodePair.first;
+    if (  true
+          && (value != loopCarriedPHI)
+          && (value != selectInst)
+      ){
+      return false;
+    }
+  }
+
+  /*
+   * Intermediate values cannot be used within the loop.
+   */
+  for (auto inst : { cast<Instruction>(loopCarriedPHI), cast<Instruction>(selectInst) }){
+    for (auto user : inst->users()){
+      auto userInst = dyn_cast<Instruction>(user);
+      if (  true
+            && (userInst != nullptr)
+            && rootLoop->isIncluded(userInst)
+            && (!scc->isInternal(userInst))
+        ){
+        return false;
+      }
+    }
+  }
+
+  /*
+   * Fetch the new value the select chooses instead of keeping the current value of the variable.
+   */
+  Value *newValue = nullptr;
+  if (selectInst->getFalseValue() == loopCarriedPHI){
+    newValue = selectInst->getTrueValue();
+  } else if (selectInst->getTrueValue() == loopCarriedPHI){
+    newValue = selectInst->getFalseValue();
+  }
+  if (  false
+        || (newValue == nullptr)
+        || (newValue == loopCarriedPHI)
+    ){
+    return false;
+  }
+
+  /*
+   * Fetch the min/max variable whose comparison drives the select.
+   */
+  auto condition = dyn_cast<CmpInst>(selectInst->getCondition());
+  if (condition == nullptr){
+    return false;
+  }
+  SelectInst *minMaxAccumulator = nullptr;
+  for (auto user : condition->users()){
+    auto userSelect = dyn_cast<SelectInst>(user);
+    if (  true
+          && (userSelect != nullptr)
+          && (userSelect->getCondition() == condition)
+          && this->accumOpInfo.isMinMaxOp(userSelect)
+      ){
+      minMaxAccumulator = userSelect;
+      break ;
+    }
+  }
+  if (minMaxAccumulator == nullptr){
+    return false;
+  }
+  auto minMaxSCC = this->sccdag->sccOfValue(minMaxAccumulator);
+  PHINode *minMaxPHI = nullptr;
+  for (auto selectedValue : { minMaxAccumulator->getTrueValue(), minMaxAccumulator->getFalseValue() }){
+    auto selectedPHI = dyn_cast<PHINode>(selectedValue);
+    if (  true
+          && (selectedPHI != nullptr)
+          && (selectedPHI->getParent() == rootLoopHeader)
+          && minMaxSCC->isInternal(selectedPHI)
+      ){
+      minMaxPHI = selectedPHI;
+    }
+  }
+  if (  false
+        || (minMaxPHI == nullptr)
+        || (!this->isMinMaxReduction(minMaxSCC, loopNode, minMaxPHI))
+    ){
+    return false;
+  }
+
+  /*
+   * Both variables must take their new value on the same outcome of the comparison.
+   */
+  auto isNewValueSelectedOnTrue = (selectInst->getTrueValue() == newValue);
+  auto isNewMinMaxSelectedOnTrue = (minMaxAccumulator->getTrueValue() != minMaxPHI);
+  if (isNewValueSelectedOnTrue != isNewMinMaxSelectedOnTrue){
+    return false;
+  }
+
+  /*
+   * The comparison must be strict (i.e., the first extreme value is the one selected).
+   * Ties between partial results can then be broken towards the earliest iteration.
+   */
+  auto predicate = this->accumOpInfo.getMinMaxPredicate(minMaxAccumulator, minMaxPHI);
+  switch (predicate) {
+    case CmpInst::ICMP_SGT:
+    case CmpInst::ICMP_SLT:
+    case CmpInst::ICMP_UGT:
+    case CmpInst::ICMP_ULT:
+    case CmpInst::FCMP_OGT:
+    case CmpInst::FCMP_OLT:
+      break ;
+    default:
+      return false;
+  }
+
+  /*
+   * The new value must be an induction variable of the loop with a constant step, so the iteration that selected a value can be recovered from the value itself.
+   */
+  auto indexValue = newValue;
+  while (auto castInst = dyn_cast<CastInst>(indexValue)){
+    if (  true
+          && (!isa<SExtInst>(castInst))
+          && (!isa<ZExtInst>(castInst))
+          && (!isa<TruncInst>(castInst))
+      ){
+      return false;
+    }
+    indexValue = castInst->getOperand(0);
+  }
+  InductionVariable *indexIV = nullptr;
+  for (auto iv : IVs){
+    if (iv->getLoopEntryPHI() == indexValue){
+      indexIV = iv;
+      break ;
+    }
+  }
+  if (  false
+        || (indexIV == nullptr)
+        || (indexIV->getLoopEntryPHI()->getParent() != rootLoopHeader)
+    ){
+    return false;
+  }
+  auto stepValue = dyn_cast_or_null<ConstantInt>(indexIV->getSingleComputedStepValue());
+  if (  false
+        || (stepValue == nullptr)
+        || stepValue->isZero()
+    ){
+    return false;
+  }
+
+  /*
+   * Keep track of the paired reduction.
+   */
+  auto tieBreakPredicate = stepValue->isNegative() ? CmpInst::ICMP_SGT : CmpInst::ICMP_SLT;
+  this->pairedReductions[scc] = std::make_pair(minMaxSCC, tieBreakPredicate);
+
+  return true;
+}
+
+void SCCDAGAttrs::checkIfPairedReductionsAreComplete (StayConnectedNestedLoopForestNode *loopNode){
+  auto rootLoop = loopNode->getLoop();
+
+  /*
+   * A min/max reduction whose comparison selects the values of other variables can be reduced only if all of them are paired reductions of it that are reduced as well.
+   * A paired reduction can be reduced only if its min/max reduction is reduced as well.
+   */
+  std::unordered_set<SCC *> minMaxSCCsToSerialize;
+  for (auto &pairedReduction : this->pairedReductions){
+    auto minMaxSCC = pairedReduction.second.first;
+    if (!this->getSCCAttrs(minMaxSCC)->canExecuteReducibly()){
+      minMaxSCCsToSerialize.insert(minMaxSCC);
+    }
+  }
+  for (auto &sccInfoPair : this->sccToInfo){
+    auto minMaxSCC = sccInfoPair.first;
+    if (this->getMinMaxPredicateOfReduction(minMaxSCC) == CmpInst::BAD_ICMP_PREDICATE){
+      continue ;
+    }
+    auto selectInst = dyn_cast<SelectInst>(sccInfoPair.second->getSingleAccumulator());
+    if (selectInst == nullptr){
+      continue ;
+    }
+    for (auto user : selectInst->getCondition()->users()){
+      auto userInst = dyn_cast<Instruction>(user);
+      if (  false
+            || (userInst == nullptr)
+            || (!rootLoop->isIncluded(userInst))
+            || minMaxSCC->isInternal(userInst)
+        ){
+        continue ;
+      }
+      auto userSCC = this->sccdag->sccOfValue(userInst);
+      if (  false
+            || (this->getMinMaxSCCOfPairedReduction(userSCC) != minMaxSCC)
+            || (!this->getSCCAttrs(userSCC)->canExecuteReducibly())
+        ){
+        minMaxSCCsToSerialize.insert(minMaxSCC);
+      }
+    }
+  }
+
+  /*
+   * Serialize incomplete min/max reductions and their paired reductions.
+   */
+  for (auto minMaxSCC : minMaxSCCsToSerialize){
+    this->getSCCAttrs(minMaxSCC)->setType(SCCAttrs::SCCType::SEQUENTIAL);
+  }
+  for (auto pairedReductionIter = this->pairedReductions.begin(); pairedReductionIter != this->pairedReductions.end(); ){
+    auto pairedSCC = pairedReductionIter->first;
+    auto minMaxSCC = pairedReductionIter->second.first;
+    if (minMaxSCCsToSerialize.find(minMaxSCC) == minMaxSCCsToSerialize.end()){
+      ++pairedReductionIter;
+      continue ;
+    }
+    this->getSCCAttrs(pairedSCC)->setType(SCCAttrs::SCCType::SEQUENTIAL);
+    pairedReductionIter = this->pairedReductions.erase(pairedReductionIter);
+  }
+
+  return ;
+}
+
 /*
  * The SCC is independent if it doesn't have loop carried data dependencies
  */
@@ -909,6 +1564,10 @@ std::unordered_set<SCCAttrs *> SCCDAGAttrs::getSCCsOfType (SCCAttrs::SCCType scc
 }
 
 SCCDAGAttrs::~SCCDAGAttrs (){
+  for (auto pair : this->arrayReductions){
+    delete pair.second;
+  }
+
   return ;
 }
 
@@ -183,7 +183,14 @@ namespace llvm::noelle {
         BasicBlock *endOfParLoopInOriginalFunc,
         Value *envArray,
         Value *envIndexForExitVariable,
-        std::vector<BasicBlock *> &loopExitBlocks
+        std::vector<BasicBlock *> &loopExitBlocks,
+        bool allowConcurrentInvocations = false,
+        Instruction *joinOfParLoopInOriginalFunc = nullptr
+        );
+
+      void guardTransformedLoopWithRuntimeAliasChecks (
+        LoopDependenceInfo *originalLoop,
+        BasicBlock *originalPreHeader
         );
 
       bool verifyCode (void) const ;
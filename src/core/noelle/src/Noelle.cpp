@@ -107,13 +107,21 @@ void Noelle::linkTransformedLoopToOriginalFunction (
     BasicBlock *endOfParLoopInOriginalFunc,
     Value *envArray,
     Value *envIndexForExitVariable,
-    std::vector<BasicBlock *> &loopExitBlocks
+    std::vector<BasicBlock *> &loopExitBlocks,
+    bool allowConcurrentInvocations,
+    Instruction *joinOfParLoopInOriginalFunc
     ){
 
   /*
    * Create the global variable for the parallelized loop.
+   *
+   * If concurrent invocations are allowed (e.g., the loop is nested in another parallelized loop), the variable is thread local.
+   * This way, every thread can run its own invocation in parallel while recursive invocations within the same thread still run sequentially.
    */
   auto globalBool = new GlobalVariable(*module, int32, /*isConstant=*/ false, GlobalValue::ExternalLinkage, Constant::getNullValue(int32));
+  if (allowConcurrentInvocations){
+    globalBool->setThreadLocal(true);
+  }
   auto const0 = ConstantInt::get(int32, 0);
   auto const1 = ConstantInt::get(int32, 1);
 
@@ -199,8 +207,116 @@ void Noelle::linkTransformedLoopToOriginalFunction (
     IRBuilder<> startBuilder(&*startOfParLoopInOriginalFunc->begin());
     startBuilder.CreateStore(const1, globalBool);
   }
-  endBuilder.SetInsertPoint(endOfParLoopInOriginalFunc->getTerminator());
-  endBuilder.CreateStore(const0, globalBool);
+  if (joinOfParLoopInOriginalFunc == nullptr){
+    endBuilder.SetInsertPoint(endOfParLoopInOriginalFunc->getTerminator());
+    endBuilder.CreateStore(const0, globalBool);
+    return ;
+  }
+
+  /*
+   * The parallelized loop is still running when it reaches its exit point.
+   * Hence, the global variable is reset after the join.
+   *
+   * The join also runs when the original loop runs instead (e.g., because another invocation of the loop is running in parallel).
+   * So the variable is reset only by the invocation that set it.
+   */
+  auto &cxt = module->getContext();
+  auto loopFunction = originalPreHeader->getParent();
+  IRBuilder<> entryBuilder(&*loopFunction->begin()->begin());
+  auto isTheVariableSet = entryBuilder.CreateAlloca(this->int1);
+  IRBuilder<> preHeaderBuilder(originalPreHeader->getTerminator());
+  preHeaderBuilder.CreateStore(ConstantInt::getFalse(cxt), isTheVariableSet);
+  IRBuilder<> startBuilder(&*startOfParLoopInOriginalFunc->begin());
+  startBuilder.CreateStore(ConstantInt::getTrue(cxt), isTheVariableSet);
+  auto afterTheJoin = joinOfParLoopInOriginalFunc->getNextNode();
+  IRBuilder<> joinBuilder(afterTheJoin);
+  auto wasTheVariableSet = joinBuilder.CreateLoad(isTheVariableSet);
+  auto resetTerminator = SplitBlockAndInsertIfThen(wasTheVariableSet, afterTheJoin, false);
+  IRBuilder<> resetBuilder(resetTerminator);
+  resetBuilder.CreateStore(const0, globalBool);
+
+  return ;
+}
+
+void Noelle::guardTransformedLoopWithRuntimeAliasChecks (
+    LoopDependenceInfo *originalLoop,
+    BasicBlock *originalPreHeader
+    ){
+
+  /*
+   * Check if the transformed loop relies on memory accesses being disjoint.
+   */
+  auto &accessesToCheck = originalLoop->getMemoryAccessesAssumedToBeDisjoint();
+  if (accessesToCheck.size() == 0){
+    return ;
+  }
+
+  /*
+   * Fetch the branch that selects between the transformed loop and the original one (see linkTransformedLoopToOriginalFunction).
+   */
+  auto loopSwitch = cast<BranchInst>(originalPreHeader->getTerminator());
+  assert(loopSwitch->isConditional());
+
+  /*
+   * Fetch the scalar evolution of the function.
+   * It is recomputed because the function has been modified since the loop has been analyzed.
+   * The original loop is still there, unchanged, as it is the one that runs when the transformed one cannot.
+   */
+  auto loopFunction = originalPreHeader->getParent();
+  auto& SE = getAnalysis<ScalarEvolutionWrapperPass>(*loopFunction).getSE();
+  auto domainSpace = originalLoop->getLoopIterationDomainSpaceAnalysis();
+  SCEVExpander expander(SE, this->program->getDataLayout(), "noelle.alias.check");
+
+  /*
+   * Generate the code that computes the range of addresses accessed by a memory instruction during the whole loop invocation.
+   */
+  std::unordered_map<Instruction *, std::pair<Value *, Value *>> ranges;
+  auto generateRange = [&ranges, domainSpace, &SE, &expander, loopSwitch, this](Instruction *memoryAccess) -> std::pair<Value *, Value *> {
+    if (ranges.find(memoryAccess) != ranges.end()){
+      return ranges[memoryAccess];
+    }
+    std::pair<Value *, Value *> range{nullptr, nullptr};
+    auto rangeSCEVs = domainSpace->getRangeOfAddressesAccessedByTheLoop(memoryAccess, SE);
+    if (  true
+          && (rangeSCEVs.first != nullptr)
+          && isSafeToExpand(rangeSCEVs.first, SE)
+          && isSafeToExpand(rangeSCEVs.second, SE)
+       ){
+      range.first = expander.expandCodeFor(rangeSCEVs.first, this->int64, loopSwitch);
+      range.second = expander.expandCodeFor(rangeSCEVs.second, this->int64, loopSwitch);
+    }
+    ranges[memoryAccess] = range;
+    return range;
+  };
+
+  /*
+   * Generate the checks.
+   *
+   * Two ranges are disjoint if one ends before the other starts.
+   * If a range cannot be computed anymore, then the original loop always runs.
+   */
+  IRBuilder<> checkBuilder(loopSwitch);
+  Value *areDisjoint = ConstantInt::getTrue(this->program->getContext());
+  for (auto accessPair : accessesToCheck){
+    auto range1 = generateRange(accessPair.first);
+    auto range2 = generateRange(accessPair.second);
+    if (  false
+          || (range1.first == nullptr)
+          || (range2.first == nullptr)
+       ){
+      areDisjoint = ConstantInt::getFalse(this->program->getContext());
+      break ;
+    }
+    auto isFirstBeforeSecond = checkBuilder.CreateICmpULE(range1.second, range2.first);
+    auto isSecondBeforeFirst = checkBuilder.CreateICmpULE(range2.second, range1.first);
+    areDisjoint = checkBuilder.CreateAnd(checkBuilder.CreateOr(isFirstBeforeSecond, isSecondBeforeFirst), areDisjoint);
+  }
+
+  /*
+   * Run the transformed loop only if all accesses are disjoint.
+   */
+  auto canRunTheTransformedLoop = checkBuilder.CreateAnd(loopSwitch->getCondition(), areDisjoint);
+  loopSwitch->setCondition(canRunTheTransformedLoop);
 
   return ;
 }
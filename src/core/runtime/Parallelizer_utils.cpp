@@ -1,6 +1,7 @@
 #include <future>
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <pthread.h>
 #include <functional>
@@ -14,17 +15,32 @@
 #include <ThreadSafeQueue.hpp>
 #include <ThreadSafeLockFreeQueue.hpp>
 #include <ThreadPools.hpp>
+#include <noelle/core/SysfsTopology.hpp>
 
 #include <condition_variable>
 #include <mutex>
 #include <queue>
+#include <deque>
 #include <utility>
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <set>
+#include <map>
+#include <unordered_map>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 /*
  * OPTIONS
  */
-//#define RUNTIME_PROFILE
 //#define RUNTIME_PRINT
 //#define DSWP_STATS
 
@@ -32,6 +48,19 @@ using namespace MARC;
 
 #define CACHE_LINE_SIZE 64
 
+/*
+ * Hint to the CPU that the current thread is spinning.
+ */
+static inline void cpu_relax (void){
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#else
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
 #ifdef DSWP_STATS
 static int64_t numberOfPushes8 = 0;
 static int64_t numberOfPushes16 = 0;
@@ -39,1009 +68,4899 @@ static int64_t numberOfPushes32 = 0;
 static int64_t numberOfPushes64 = 0;
 #endif
     
-typedef struct {
-  void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t) ;
-  void *env ;
-  int64_t coreID ;
-  int64_t numCores;
-  int64_t chunkSize ;
-  pthread_spinlock_t endLock;
-} DOALL_args_t ;
-
-class NoelleRuntime {
+/*
+ * Waits of the runtime (sequential segments, joins, and DSWP queues).
+ *
+ * A waiting thread spins for a bounded number of iterations and then it sleeps on a futex.
+ * This avoids burning cores when the machine is oversubscribed.
+ *
+ * The policy is selected by the environment variable NOELLE_WAIT_POLICY:
+ * - "adaptive" (default): spin NOELLE_WAIT_SPIN_ITERATIONS times (4096 by default) and then sleep.
+ * - "spin": never sleep.
+ * - "park": sleep right away.
+ */
+class AdaptiveWait {
   public:
-    NoelleRuntime ();
+    static void initialize (void);
 
-    uint32_t reserveCores (uint32_t coresRequested);
-
-    void releaseCores (uint32_t coresReleased);
-
-    DOALL_args_t * getDOALLArgs (uint32_t cores, uint32_t *index);
+    /*
+     * Iterations to spin before sleeping (negative means forever).
+     */
+    static int64_t spinIterations;
 
-    void releaseDOALLArgs (uint32_t index);
+    static bool shouldKeepSpinning (int64_t iteration) {
+      return (spinIterations < 0) || (iteration < spinIterations);
+    }
 
-    ThreadPoolForCSingleQueue *virgil;
+    static void futexWait (std::atomic<uint32_t> *word, uint32_t expectedValue);
 
-    ~NoelleRuntime(void);
+    static void futexWake (std::atomic<uint32_t> *word, int32_t numberOfThreads);
+};
 
-  private:
-    mutable pthread_spinlock_t doallMemoryLock;
-    std::vector<uint32_t> doallMemorySizes;
-    std::vector<bool> doallMemoryAvailability;
-    std::vector<DOALL_args_t *> doallMemory;
+/*
+ * Binary semaphore.
+ *
+ * It is not owned by a thread: signal and wait can be invoked by different threads.
+ * Its size is 4 bytes so it fits wherever a pthread_spinlock_t used to be.
+ */
+class AdaptiveSemaphore {
+  public:
+    void initialize (bool isAvailable);
 
-    uint32_t getMaximumNumberOfCores (void);
+    void wait (void);
 
     /*
-     * Current number of idle cores.
+     * Take the semaphore if it is available without waiting.
      */
-    int32_t NOELLE_idleCores;
+    bool tryWait (void);
+
+    void signal (void);
+
+  private:
 
     /*
-     * Maximum number of cores.
+     * 0 = available, 1 = taken, 2 = taken and some threads might be sleeping.
      */
-    uint32_t maxCores;
-
-    mutable pthread_spinlock_t spinLock;
+    std::atomic<uint32_t> state;
 };
 
-#ifdef RUNTIME_PROFILE
-pthread_spinlock_t printLock;
-uint64_t clocks_starts[64];
-uint64_t clocks_ends[64];
-uint64_t clocks_dispatch_starts[64];
-uint64_t clocks_dispatch_ends[64];
-#endif
+/*
+ * Event count to wait for a condition that other threads make true (e.g., a queue becoming not empty).
+ * Threads that make the condition true need to invoke notifyAll.
+ */
+class AdaptiveEventCount {
+  public:
+    AdaptiveEventCount ();
 
-static NoelleRuntime runtime{};
+    template <typename ConditionT>
+    void waitUntil (ConditionT isConditionTrue);
 
-extern "C" {
+    void notifyAll (void);
 
-  /******************************************** NOELLE APIs ***********************************************/
+  private:
+    std::atomic<uint32_t> epoch;
+    std::atomic<uint32_t> sleepers;
+};
 
-  class DispatcherInfo {
-    public:
-      int32_t numberOfThreadsUsed;
-      int64_t unusedVariableToPreventOptIfStructHasOnlyOneVariable;
-  };
+template <typename ConditionT>
+void AdaptiveEventCount::waitUntil (ConditionT isConditionTrue){
 
   /*
-   * Dispatch threads to run a DOALL loop.
+   * Spin.
    */
-  DispatcherInfo NOELLE_DOALLDispatcher (
-    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t), 
-    void *env, 
-    int64_t maxNumberOfCores, 
-    int64_t chunkSize
-    );
-
-
-    #ifdef RUNTIME_PROFILE
-    static __inline__ int64_t rdtsc_s(void) {
-      unsigned a, d; 
-      asm volatile("cpuid" ::: "%rax", "%rbx", "%rcx", "%rdx");
-      asm volatile("rdtsc" : "=a" (a), "=d" (d)); 
-      return ((unsigned long)a) | (((unsigned long)d) << 32); 
-    }
-    static __inline__ int64_t rdtsc_e(void) {
-      unsigned a, d; 
-      asm volatile("rdtscp" : "=a" (a), "=d" (d)); 
-      asm volatile("cpuid" ::: "%rax", "%rbx", "%rcx", "%rdx");
-      return ((unsigned long)a) | (((unsigned long)d) << 32); 
+  for (int64_t i = 0; AdaptiveWait::shouldKeepSpinning(i); i++){
+    if (isConditionTrue()){
+      return ;
     }
-    #endif
-
-
-  /******************************************** NOELLE API implementations ***********************************************/
-
-  typedef void (*stageFunctionPtr_t)(void *, void*);
-
-  void printReachedS(std::string s)
-  {
-    auto outS = "Reached: " + s;
-    printf("%s\n",outS.c_str());
-  }
-
-  void printReachedI(int i){
-    printf("Reached: %d\n",i);
-  }
-
-  void printPushedP(int32_t *p){
-    printf("Pushed: %p\n", p);
+    cpu_relax();
   }
 
-  void printPulledP(int32_t *p){
-    printf("Pulled: %p\n", p);
+  /*
+   * Sleep.
+   *
+   * We announce ourselves as sleepers before checking the condition one last time.
+   * This way, a thread that makes the condition true after our check will see us and wake us up.
+   */
+  this->sleepers.fetch_add(1);
+  while (true){
+    auto currentEpoch = this->epoch.load();
+    if (isConditionTrue()){
+      break ;
+    }
+    AdaptiveWait::futexWait(&this->epoch, currentEpoch);
   }
+  this->sleepers.fetch_sub(1);
 
-  void queuePush8(ThreadSafeQueue<int8_t> *queue, int8_t *val) { 
-    queue->push(*val); 
-
-    #ifdef DSWP_STATS
-    numberOfPushes8++;
-    #endif
+  return ;
+}
 
-    return ;
-  }
+/*
+ * Sequential segment of a HELIX loop.
+ *
+ * Every iteration of the loop (or chunk of iterations) has a ticket: 0 for the first one, 1 for the second one, and so on.
+ * The iteration with ticket t can enter the sequential segment once the iterations with the tickets before t have left it.
+ * Hence, a single counter per sequential segment orders all cores.
+ *
+ * Each sequential segment uses its own cache line.
+ */
+class alignas(CACHE_LINE_SIZE) HELIXSequentialSegment {
+  public:
+    void initialize (void);
 
-  void queuePop8(ThreadSafeQueue<int8_t> *queue, int8_t *val) { 
-    queue->waitPop(*val); 
-    return ;
-  }
+    void wait (int64_t ticket);
 
-  void queuePush16(ThreadSafeQueue<int16_t> *queue, int16_t *val) { 
-    queue->push(*val); 
+    void signal (int64_t ticket);
 
-    #ifdef DSWP_STATS
-    numberOfPushes16++;
-    #endif
+    /*
+     * Return true if the iteration with "ticket" can enter the sequential segment.
+     */
+    bool canEnter (int64_t ticket) const ;
 
-    return ;
-  }
+  private:
 
-  void queuePop16(ThreadSafeQueue<int16_t> *queue, int16_t *val) { 
-    queue->waitPop(*val);
-  }
+    /*
+     * Number of iterations that left the sequential segment.
+     */
+    std::atomic<int64_t> completedTickets;
+    AdaptiveEventCount ticketCompleted;
+};
 
-  void queuePush32(ThreadSafeQueue<int32_t> *queue, int32_t *val) { 
-    queue->push(*val); 
+/*
+ * Telemetry of the parallelized loops.
+ *
+ * It is enabled by the environment variable NOELLE_TELEMETRY, which names the JSON file to write when the program exits ("stderr" writes it to the standard error).
+ * Each invocation of a parallelized loop is recorded with the ID of its loop.
+ * Only the first NOELLE_TELEMETRY_INVOCATIONS invocations of a loop (1000 by default) are kept; the other ones only contribute to the totals of their loop.
+ *
+ * Times are in nanoseconds:
+ * - setup: from the invocation of the dispatcher to the submission of the first task (e.g., reserving cores, allocating memory).
+ * - fork: from the submission of the first task to the start of the last task that started.
+ * - busy: running the task of a thread.
+ * - join: from the end of the last task that ended to the dispatcher noticing it.
+ * The imbalance of an invocation is the maximum busy time of its threads divided by their average busy time.
+ */
+class RuntimeTelemetry {
+  public:
 
-    #ifdef DSWP_STATS
-    numberOfPushes32++;
-    #endif
+    /*
+     * Occupancy of a DSWP queue sampled every time a value is pushed.
+     */
+    struct QueueRecord {
+      uint64_t valueBytes;
+      uint64_t capacity;
+      uint64_t values;
+      uint64_t occupancySum;
+      uint64_t maximumOccupancy;
+      uint64_t fullWaits;
+      uint64_t emptyWaits;
+    };
+
+    struct InvocationRecord {
+      int64_t loopID;
+      const char *technique;
+      uint64_t dispatchTime;
+      uint64_t forkTime;
+      uint64_t joinedTime;
+      std::vector<uint64_t> taskStartTimes;
+      std::vector<uint64_t> taskEndTimes;
+      std::vector<uint64_t> sequentialSegmentWaitTimes;
+      std::vector<QueueRecord> queues;
+
+      uint64_t getSetupTime (void) const ;
+
+      uint64_t getForkTime (void) const ;
+
+      uint64_t getJoinTime (void) const ;
+
+      double getImbalance (void) const ;
+    };
 
-    return ;
-  }
+    /*
+     * Whether the telemetry is enabled.
+     * Code that only exists to feed the telemetry must check it.
+     */
+    static bool enabled;
 
-  void queuePop32(ThreadSafeQueue<int32_t> *queue, int32_t *val) { 
-    queue->waitPop(*val);
-  }
+    void initialize (void);
 
-  void queuePush64(ThreadSafeQueue<int64_t> *queue, int64_t *val) { 
-    queue->push(*val); 
+    static uint64_t now (void) {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
 
-    #ifdef DSWP_STATS
-    numberOfPushes64++;
-    #endif
+    void record (InvocationRecord &invocation);
 
-    return ;
-  }
+    /*
+     * Write the records as JSON.
+     */
+    void dump (void);
 
-  void queuePop64(ThreadSafeQueue<int64_t> *queue, int64_t *val) { 
-    queue->waitPop(*val); 
+  private:
+    struct LoopRecord {
+      std::string technique;
+      uint64_t invocations;
+      uint64_t totalTime;
+      uint64_t setupTime;
+      uint64_t forkTime;
+      uint64_t joinTime;
+      std::vector<InvocationRecord> invocationRecords;
+    };
+
+    std::mutex lock;
+    std::map<int64_t, LoopRecord> loops;
+    std::string outputFileName;
+    uint64_t maximumInvocationsPerLoop;
+
+    static void dumpInvocation (std::ostream &stream, const InvocationRecord &invocation);
+};
 
-    return ;
-  }
+/*
+ * Model of the cost of parallelized loops used to choose the number of threads of each invocation.
+ *
+ * For each loop, the model learns online the time an iteration takes and the overhead (setup, fork, and join) each thread adds to an invocation.
+ * An invocation of N iterations that take C nanoseconds each runs in about N*C/T + O*(T-1) nanoseconds with T threads that add an overhead of O nanoseconds each.
+ * Hence, the best number of threads is sqrt(N*C/O).
+ * Invocations with N*C < 4*O run in the thread that invokes the loop without forking and joining.
+ * One invocation out of LoopCostModel::probingPeriod that would run in the invoking thread runs with two threads instead to keep learning the overhead.
+ *
+ * Invocations with an unknown number of iterations and invocations of loops without history use all the cores they are given.
+ * The model is disabled by NOELLE_ADAPTIVE_THREADS=0.
+ */
+class LoopCostModel {
+  public:
+    static bool enabled;
 
+    void initialize (void);
 
-  /**********************************************************************
-   *                DOALL
-   **********************************************************************/
-  static void NOELLE_DOALLTrampoline (void *args){
-    #ifdef RUNTIME_PROFILE
-    auto clocks_start = rdtsc_s();
-    #endif
+    uint32_t chooseNumberOfThreads (int64_t loopID, int64_t numberOfIterations, uint32_t maximumNumberOfThreads);
 
     /*
-     * Fetch the arguments.
+     * Learn from an invocation that run "numberOfIterations" iterations with "threads" threads.
+     * The task run by the thread that invoked the loop took "taskTime" nanoseconds and the whole invocation took "invocationTime" nanoseconds.
      */
-    auto DOALLArgs = (DOALL_args_t *) args;
+    void learn (int64_t loopID, int64_t numberOfIterations, uint32_t threads, uint64_t taskTime, uint64_t invocationTime);
+
+  private:
+    static const uint32_t probingPeriod = 64;
 
     /*
-     * Invoke
+     * Costs are kept in a table indexed by loop ID.
+     * A loop that collides with another one takes its entry and the history of the other loop is lost.
+     * Invocations of the same loop can update its entry concurrently; the model tolerates lost updates.
      */
-    DOALLArgs->parallelizedLoop(DOALLArgs->env, DOALLArgs->coreID, DOALLArgs->numCores, DOALLArgs->chunkSize);
-    #ifdef RUNTIME_PROFILE
-    auto clocks_end = rdtsc_e();
-    clocks_starts[DOALLArgs->coreID] = clocks_start;
-    clocks_ends[DOALLArgs->coreID] = clocks_end;
-    #endif
+    struct LoopCost {
+      std::atomic<int64_t> loopID;
+      std::atomic<double> nanosecondsPerIteration;
+      std::atomic<double> overheadPerThread;
+      std::atomic<uint32_t> sequentialInvocations;
+    };
+    static const uint32_t numberOfLoopCosts = 1024;
+    LoopCost loopCosts[numberOfLoopCosts];
+
+    LoopCost & fetchLoopCost (int64_t loopID);
+
+    static double average (double currentAverage, double sample);
+};
 
-    pthread_spin_unlock(&(DOALLArgs->endLock));
-    return ;
-  }
+/*
+ * Combine the private copies of the reduced live-out variables of the task instances of an invocation.
+ *
+ * The combination follows a binary tree whose leaves are the task instances.
+ * When a task instance ends, it climbs the tree starting from its leaf:
+ * at each node, the first child that arrives leaves, and the second one combines the private copies of both children and keeps climbing.
+ * Hence, task instances never wait for each other, the last task instance to end performs at most log2(instances) combinations, and all private copies are combined into the ones of task instance 0.
+ * The thread that invoked the dispatcher only reads the private copies of task instance 0 after the join.
+ *
+ * The compiler generates the function that combines the private copies of the instance "source" into the ones of the instance "destination".
+ */
+class ReductionTree {
+  public:
+    ReductionTree (
+      void (*combine)(void *env, int64_t destination, int64_t source),
+      void *env,
+      int64_t numberOfInstances
+      )
+      : combine{combine}
+      , env{env}
+      , numberOfInstances{numberOfInstances}
+      , arrivals(new std::atomic<uint32_t>[numberOfInstances])
+      {
+      for (auto i = 0; i < numberOfInstances; i++){
+        this->arrivals[i].store(0, std::memory_order_relaxed);
+      }
 
-  DispatcherInfo NOELLE_DOALLDispatcher (
-    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t), 
-    void *env, 
-    int64_t maxNumberOfCores, 
-    int64_t chunkSize
-    ){
-    #ifdef RUNTIME_PROFILE
-    auto clocks_start = rdtsc_s();
-    #endif
+      return ;
+    }
 
     /*
-     * Fetch VIRGIL
+     * Combine the private copies of the task instance @instanceID, which just ended.
      */
-    auto virgil = runtime.virgil;
+    void arrive (int64_t instanceID) {
+      for (int64_t level = 0; (((int64_t)1) << level) < this->numberOfInstances; level++){
 
-    /*
-     * Set the number of cores to use.
-     */
-    auto numCores = runtime.reserveCores(maxNumberOfCores);
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Starting dispatcher: num cores " << numCores << ", chunk size: " << chunkSize << std::endl;
-    #endif
+        /*
+         * Identify the children of the current node by the instances of their leftmost leaves.
+         * Each node is identified by its right child, which is unique across levels.
+         */
+        auto left = (instanceID >> (level + 1)) << (level + 1);
+        auto right = left + (((int64_t)1) << level);
+        if (right >= this->numberOfInstances){
 
-    /*
-     * Allocate the memory to store the arguments.
-     */
-    uint32_t doallMemoryIndex;
-    auto argsForAllCores = runtime.getDOALLArgs(numCores - 1, &doallMemoryIndex);
+          /*
+           * The current node only has the left child.
+           */
+          continue ;
+        }
+
+        /*
+         * Leave if the other child did not arrive yet.
+         */
+        if (this->arrivals[right].fetch_add(1, std::memory_order_acq_rel) == 0){
+          return ;
+        }
+
+        /*
+         * Both children arrived.
+         */
+        this->combine(this->env, left, right);
+        instanceID = left;
+      }
+
+      return ;
+    }
+
+  private:
+    void (*combine)(void *, int64_t, int64_t);
+    void *env;
+    int64_t numberOfInstances;
+    std::unique_ptr<std::atomic<uint32_t>[]> arrivals;
+};
+
+/*
+ * Memory of the objects allocated by an iteration of a parallelized loop that are never used outside it (see NOELLE_arena_malloc).
+ *
+ * Every thread bumps a pointer through its own blocks of memory, so threads never contend for the allocator.
+ * Freed objects give their memory back as soon as all objects allocated after them have been freed too.
+ * Everything else is given back when the current chunk of iterations ends and when the current task instance ends (see TaskScope), as no object can outlive its iteration.
+ * Blocks are kept for the next task instances that run in the same thread.
+ */
+class IterationArena {
+  public:
 
     /*
-     * Submit DOALL tasks.
+     * Set the memory allocated while an instance of a task runs in the current thread.
+     * Scopes nest, so the objects of an iteration of a loop that invokes a parallelized loop outlive the task instances of the latter that run in the same thread.
      */
-    for (auto i = 0; i < (numCores - 1); ++i) {
+    class TaskScope {
+      public:
+        TaskScope ();
+
+        ~TaskScope ();
+
+      private:
+        uint64_t previousTaskStart;
+        void *previousLastAllocation;
+    };
+
+    IterationArena ()
+      : top{0}
+      , taskStart{0}
+      , lastAllocation{nullptr}
+      {
+      return ;
+    }
+
+    void * allocate (uint64_t bytes) {
 
       /*
-       * Prepare the arguments.
+       * Objects are aligned like the ones returned by malloc.
        */
-      auto argsPerCore = &argsForAllCores[i];
-      argsPerCore->parallelizedLoop = parallelizedLoop;
-      argsPerCore->env = env;
-      argsPerCore->numCores = numCores;
-      argsPerCore->chunkSize = chunkSize;
-
-      #ifdef RUNTIME_PROFILE
-      clocks_dispatch_starts[i] = rdtsc_s();
-      #endif
+      auto objectBytes = ((bytes + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+      auto neededBytes = objectBytes + sizeof(Header);
+      if (objectBytes < bytes){
+        return nullptr;
+      }
 
       /*
-       * Submit
+       * Find the first block, starting from the current one, with enough space left.
+       * A new block is added when there is none, and objects bigger than a block get a block of their own.
        */
-      virgil->submitAndDetach(NOELLE_DOALLTrampoline, argsPerCore);
+      auto previousTop = this->top;
+      auto blockID = this->blockOf(this->top);
+      auto offset = this->offsetOf(this->top);
+      while (  true
+               && (blockID < this->blocks.size())
+               && ((this->blocks[blockID].bytes - offset) < neededBytes)
+            ){
+        blockID++;
+        offset = 0;
+      }
+      if (blockID == this->blocks.size()){
+        Block newBlock;
+        newBlock.bytes = std::max(neededBytes, (uint64_t)BLOCK_BYTES);
+        newBlock.memory = (uint8_t *)malloc(newBlock.bytes);
+        if (newBlock.memory == nullptr){
+          return nullptr;
+        }
+        this->blocks.push_back(newBlock);
+      }
 
-      #ifdef RUNTIME_PROFILE
-      clocks_dispatch_ends[i] = rdtsc_s();
-      #endif
-      #ifdef RUNTIME_PRINT
-      std::cerr << "Submitted DOALL task on core " << i << std::endl;
-      #endif
+      /*
+       * Allocate the object.
+       */
+      auto header = (Header *)(this->blocks[blockID].memory + offset);
+      header->previousTop = previousTop;
+      header->previousLastAllocation = this->lastAllocation;
+      auto object = (void *)(header + 1);
+      this->top = this->positionOf(blockID, offset + neededBytes);
+      this->lastAllocation = object;
+
+      return object;
     }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Submitted pool" << std::endl;
-    #endif
-    #ifdef RUNTIME_PROFILE
-    auto clocks_after_fork = rdtsc_e();
-    #endif
 
-    /*
-     * Run a task.
-     */
-    parallelizedLoop(env, numCores - 1, numCores, chunkSize);
+    void free (void *object) {
+      if (object == nullptr){
+        return ;
+      }
 
-    /*
-     * Wait for the remaining DOALL tasks.
-     */
-    #ifdef RUNTIME_PROFILE
-    auto clocks_before_join = rdtsc_s();
-    #endif
-    for (auto i = 0; i < (numCores - 1); ++i) {
-      pthread_spin_lock(&(argsForAllCores[i].endLock));
+      /*
+       * Mark the object as freed.
+       * Objects never outlive their iteration, so they are freed by the thread that allocated them.
+       */
+      auto header = ((Header *)object) - 1;
+      header->previousTop |= FREED;
+
+      /*
+       * Give back the memory of the freed objects at the top of the current task instance.
+       */
+      while (this->lastAllocation != nullptr){
+        auto lastHeader = ((Header *)this->lastAllocation) - 1;
+        if ((lastHeader->previousTop & FREED) == 0){
+          break ;
+        }
+        this->top = lastHeader->previousTop & ~FREED;
+        this->lastAllocation = lastHeader->previousLastAllocation;
+      }
+
+      return ;
     }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "All tasks completed" << std::endl;
-    #endif
-    #ifdef RUNTIME_PROFILE
-    auto clocks_after_join = rdtsc_e();
-    auto clocks_before_cleanup = rdtsc_s();
-    #endif
 
     /*
-     * Free the cores and memory.
+     * Give back the memory allocated by the current task instance.
      */
-    runtime.releaseCores(numCores);
-    runtime.releaseDOALLArgs(doallMemoryIndex);
+    void rewindToTheStartOfTheCurrentTask (void) {
+      this->top = this->taskStart;
+      this->lastAllocation = nullptr;
 
-    /*
-     * Prepare the return value.
-     */
-    DispatcherInfo dispatcherInfo;
-    dispatcherInfo.numberOfThreadsUsed = numCores;
-    #ifdef RUNTIME_PROFILE
-    auto clocks_after_cleanup = rdtsc_s();
-    pthread_spin_lock(&printLock);
-    std::cerr << "XAN: Start         = " << clocks_start << "\n";
-    std::cerr << "XAN: Setup overhead         = " << clocks_after_fork - clocks_start << " clocks\n";
-    uint64_t totalDispatch = 0;
-    for (auto i=0; i < (numCores - 1); i++){
-      totalDispatch += (clocks_dispatch_ends[i] - clocks_dispatch_starts[i]);
-    }
-    std::cerr << "XAN:    Dispatch overhead         = " << totalDispatch << " clocks\n";
-    std::cerr << "XAN: Start joining = " << clocks_after_fork << "\n";
-    for (auto i=0; i < (numCores - 1); i++){
-      std::cerr << "Thread " << i << ": Start = " << clocks_starts[i] << "\n";
-      std::cerr << "Thread " << i << ": End   = " << clocks_ends[i] << "\n";
-      std::cerr << "Thread " << i << ": Delta = " << clocks_ends[i] - clocks_starts[i] << "\n";
-    }
-    std::cerr << "XAN: Joined        = " << clocks_after_join << "\n";
-    std::cerr << "XAN: Joining delta = " << clocks_after_join - clocks_before_join << "\n";
-
-    uint64_t start_min = 0;
-    uint64_t start_max = 0;
-    for (auto i=0; i < (numCores - 1); i++){
-      if (  false
-            || (start_min == 0)
-            || (clocks_starts[i] < start_min)
-        ){
-        start_min = clocks_starts[i];
-      }
-      if (clocks_starts[i] > start_max){
-        start_max = clocks_starts[i];
-      }
+      return ;
     }
-    std::cerr << "XAN: Thread starts min = " << start_min << "\n";
-    std::cerr << "XAN: Thread starts max = " << start_max << "\n";
-    std::cerr << "XAN: Task starting overhead = " << start_max - start_min << "\n";
 
-    uint64_t end_max = 0;
-    uint64_t lastThreadID = 0;
-    for (auto i=0; i < (numCores - 1); i++){
-      if (clocks_ends[i] > end_max){
-        lastThreadID = i;
-        end_max = clocks_ends[i];
+    ~IterationArena () {
+      for (auto &block : this->blocks){
+        ::free(block.memory);
       }
-    }
-    std::cerr << "XAN: Last thread ended = " << end_max << " (thread " << lastThreadID << ")\n";
-    std::cerr << "XAN: Joining overhead       = " << clocks_after_join - end_max << "\n";
-
-    pthread_spin_unlock(&printLock);
-    #endif
-
-    return dispatcherInfo;
-  }
-
-  #ifdef RUNTIME_PRINT
-  void *mySSGlobal = nullptr;
-  #endif
 
+      return ;
+    }
 
-  /**********************************************************************
-   *                HELIX
-   **********************************************************************/
-  typedef struct {
-    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *);
-    void *env ;
-    void *loopCarriedArray;
-    void *ssArrayPast;
-    void *ssArrayFuture;
-    uint64_t coreID;
-    uint64_t numCores;
-    uint64_t *loopIsOverFlag;
-    pthread_spinlock_t endLock;
-  } NOELLE_HELIX_args_t ;
-
-  static void NOELLE_HELIXTrampoline (void *args){
+  private:
 
     /*
-     * Fetch the arguments.
+     * Positions in the arena are encoded as (block << 40) | offset, so they can be compared as integers.
      */
-    auto HELIX_args = (NOELLE_HELIX_args_t *) args;
+    static constexpr uint64_t OFFSET_BITS = 40;
+    static constexpr uint64_t BLOCK_BYTES = 1 << 20;
+    static constexpr uint64_t ALIGNMENT = 16;
 
     /*
-     * Invoke
+     * Bit set in the previous top of the header of freed objects.
+     * Positions never use it as there are far fewer blocks than 2^23.
      */
-    HELIX_args->parallelizedLoop(
-      HELIX_args->env, 
-      HELIX_args->loopCarriedArray, 
-      HELIX_args->ssArrayPast, 
-      HELIX_args->ssArrayFuture, 
-      HELIX_args->coreID,
-      HELIX_args->numCores,
-      HELIX_args->loopIsOverFlag
-      );
+    static constexpr uint64_t FREED = ((uint64_t)1) << 63;
 
-    pthread_spin_unlock(&(HELIX_args->endLock));
-    return ;
-  }
+    typedef struct {
+      uint8_t *memory;
+      uint64_t bytes;
+    } Block ;
 
-  static void HELIX_helperThread (void *ssArray, uint32_t numOfsequentialSegments, uint64_t *theLoopIsOver){
+    typedef struct {
+      uint64_t previousTop;
+      void *previousLastAllocation;
+    } Header ;
 
-    while ((*theLoopIsOver) == 0){
+    std::vector<Block> blocks;
+    uint64_t top;
+    uint64_t taskStart;
+    void *lastAllocation;
 
-      /*
-       * Prefetch all sequential segment cache lines of the current loop iteration.
-       */
-      for (auto i = 0 ; ((*theLoopIsOver) == 0) && (i < numOfsequentialSegments); i++){
+    uint64_t positionOf (uint64_t blockID, uint64_t offset) const {
+      return (blockID << OFFSET_BITS) | offset;
+    }
 
-        /*
-         * Fetch the pointer.
-         */
-        auto ptr = (uint64_t *)(((uint64_t)ssArray) + (i * CACHE_LINE_SIZE));
+    uint64_t blockOf (uint64_t position) const {
+      return position >> OFFSET_BITS;
+    }
 
-        /*
-         * Prefetch the cache line for the current sequential segment.
-         */
-        while (((*theLoopIsOver) == 0) && ((*ptr) == 0)) ;
-      }
+    uint64_t offsetOf (uint64_t position) const {
+      return position & ((((uint64_t)1) << OFFSET_BITS) - 1);
     }
+};
 
-    return ;
-  }
+static thread_local IterationArena iterationArenaOfCurrentThread{};
 
-  static DispatcherInfo NOELLE_HELIX_dispatcher (
-    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *), 
-    void *env,
-    void *loopCarriedArray,
-    int64_t maxNumberOfCores, 
-    int64_t numOfsequentialSegments,
-    bool LIO
-    ){
-    #ifdef RUNTIME_PRINT
-    std::cerr << "HELIX: dispatcher: Start" << std::endl;
-    std::cerr << "HELIX: dispatcher:  Number of sequential segments = " << numOfsequentialSegments << std::endl;
-    std::cerr << "HELIX: dispatcher:  Number of cores = " << numCores << std::endl;
-    #endif
+IterationArena::TaskScope::TaskScope ()
+  : previousTaskStart{iterationArenaOfCurrentThread.taskStart}
+  , previousLastAllocation{iterationArenaOfCurrentThread.lastAllocation}
+  {
+  iterationArenaOfCurrentThread.taskStart = iterationArenaOfCurrentThread.top;
+  iterationArenaOfCurrentThread.lastAllocation = nullptr;
 
-    /*
-     * Assumptions.
-     */
-    assert(parallelizedLoop != NULL);
-    assert(env != NULL);
-    assert(maxNumberOfCores > 1);
+  return ;
+}
+
+IterationArena::TaskScope::~TaskScope () {
+  iterationArenaOfCurrentThread.rewindToTheStartOfTheCurrentTask();
+  iterationArenaOfCurrentThread.taskStart = this->previousTaskStart;
+  iterationArenaOfCurrentThread.lastAllocation = this->previousLastAllocation;
+
+  return ;
+}
+
+/*
+ * Chunk scheduling policies of DOALL loops.
+ * These values must match DOALL::ChunkScheduling of the compiler.
+ */
+#define DOALL_STATIC_SCHEDULING   0
+#define DOALL_DYNAMIC_SCHEDULING  1
+#define DOALL_GUIDED_SCHEDULING   2
+#define DOALL_DETERMINISTIC_SCHEDULING  3
+
+/*
+ * State shared by all the threads that execute the same invocation of a DOALL loop that does not use the static chunk scheduling.
+ *
+ * With the deterministic scheduling, chunks are assigned to a fixed number of task instances like the static scheduling does, and threads claim task instances (see NOELLE_DOALL_runTaskInstances).
+ *
+ * Loops with more than one exit leave as soon as an iteration takes an exit that is not the one of the loop-governing induction variable.
+ * The earliest of such iterations cancels all the chunks that start after it (see NOELLE_DOALL_cancel).
+ */
+typedef struct {
+  alignas(CACHE_LINE_SIZE) std::atomic<int64_t> nextIteration;
+  alignas(CACHE_LINE_SIZE) std::atomic<int64_t> nextTaskInstance;
+  alignas(CACHE_LINE_SIZE) std::atomic<int64_t> firstExitingIteration;
+  std::mutex exitLock;
+  alignas(CACHE_LINE_SIZE) int64_t scheduling;
+  int64_t chunkSize;
+  int64_t numCores;
+  int64_t numberOfIterations;
+  int64_t numberOfTaskInstances;
+} DOALL_schedule_t ;
+
+typedef struct {
+  void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *) ;
+  void *env ;
+  int64_t coreID ;
+  int64_t numCores;
+  int64_t chunkSize ;
+  DOALL_schedule_t *schedule ;
+  ReductionTree *reductionTree ;
+  uint32_t coreBudget ;
+  uint64_t startTime;
+  uint64_t endTime;
+  AdaptiveSemaphore endLock;
+} DOALL_args_t ;
+
+/*
+ * State of an invocation of a DOALL loop from the fork of its threads to their join.
+ */
+class DOALLInvocation {
+  public:
+    RuntimeTelemetry::InvocationRecord telemetry;
+    bool isTimed;
+    bool isAsynchronous;
+    int64_t loopID;
+    int64_t numberOfIterations;
 
     /*
-     * Fetch VIRGIL
+     * Threads and cores.
      */
-    auto virgil = runtime.virgil;
+    int64_t numCores;
+    uint32_t reservedCores;
+    bool coresFromBudget;
+    uint32_t callerCoreBudget;
 
     /*
-     * Reserve the cores.
+     * Tasks run by threads of the runtime.
      */
-    auto numCores = runtime.reserveCores(maxNumberOfCores);
-    assert(numCores >= 1);
+    int64_t numberOfTasks;
+    DOALL_args_t *argsForAllCores;
+    uint32_t doallMemoryIndex;
+    bool isRunByHotTeam;
 
     /*
-     * Allocate the sequential segment arrays.
-     * We need numCores - 1 arrays.
+     * Task run by the thread that invoked the loop.
      */
-    auto numOfSSArrays = numCores;
-    if (!LIO){
-      numOfSSArrays = 1;
-    }
-    void *ssArrays = NULL;
-    auto ssSize = CACHE_LINE_SIZE;
-    auto ssArraySize = ssSize * numOfsequentialSegments;
-    if (numOfsequentialSegments > 0){
+    uint64_t callerStartTime;
+    uint64_t callerEndTime;
 
-      /*
-       * Allocate the sequential segment arrays.
-       */
-      posix_memalign(&ssArrays, CACHE_LINE_SIZE, ssArraySize * numOfSSArrays);
-      if (ssArrays == NULL){
-        fprintf(stderr, "HELIX: dispatcher: ERROR = not enough memory to allocate %lld sequential segment arrays\n", (long long)numCores);
-        abort();
-      }
+    DOALL_schedule_t doallSchedule;
+    DOALL_schedule_t *schedule;
+    std::unique_ptr<ReductionTree> reductionTree;
+};
 
-      /*
-       * Initialize the sequential segment arrays.
-       */
-      for (auto i = 0; i < numOfSSArrays; i++){
+/*
+ * Topology of the machine read from /sys/devices/system/cpu (see SysfsTopology).
+ */
+class CoreTopology {
+  public:
+    CoreTopology ();
 
-        /*
-         * Fetch the current sequential segment array.
-         */
-        auto ssArray = (void *)(((uint64_t)ssArrays) + (i * ssArraySize));
+    /*
+     * Number of physical cores the process can run on.
+     */
+    uint32_t getNumberOfPhysicalCores (void) const ;
 
-        /*
-         * Initialize the locks.
-         */
-        for (auto lockID = 0; lockID < numOfsequentialSegments; lockID++){
+    /*
+     * Logical cores the process can run on, sorted by the order threads should be placed on them.
+     *
+     * The first one is the logical core the process started on.
+     * Then, physical cores follow from the closest to the farthest from it: same NUMA node first and, within a node, the ones that share a cache first.
+     * SMT siblings come last so threads use all physical cores before sharing one.
+     */
+    std::vector<int32_t> placement;
 
-          /*
-           * Fetch the pointer to the current lock.
-           */
-          auto lock = (pthread_spinlock_t *)(((uint64_t)ssArray) + (lockID * ssSize));
+    /*
+     * Return a logical core the process can run on that shares the physical core of "logicalCore" (-1 if there is none).
+     */
+    int32_t getSMTSibling (int32_t logicalCore) const ;
 
-          /*
-           * Initialize the lock.
-           */
-          pthread_spin_init(lock, PTHREAD_PROCESS_PRIVATE);
+    /*
+     * Pin the current thread to a logical core.
+     */
+    static void pinCurrentThread (int32_t logicalCore);
 
-          /*
-           * If the sequential segment is not for core 0, then we need to lock it.
-           */
-          if (i > 0){
-            pthread_spin_lock(lock);
-          }
-        }
-      }
-    }
+  private:
+    uint32_t physicalCores;
+    std::unordered_map<int32_t, int32_t> smtSiblings;
+};
 
-    #ifdef RUNTIME_PRINT
-    mySSGlobal = ssArrays;
-    #endif
+/*
+ * Thread pool with one queue of tasks per worker.
+ *
+ * A worker executes the tasks of its own queue in LIFO order.
+ * When its queue is empty, a worker steals the oldest task from the queue of another worker.
+ * Tasks submitted by threads outside the pool are distributed among the queues in a round-robin fashion.
+ * Tasks submitted by a worker (e.g., nested parallel loops) go to the queue of that worker.
+ */
+class WorkStealingThreadPool {
+  public:
 
     /*
-     * Allocate the arguments for the cores.
+     * If "cores" is not empty, the i-th worker is pinned to the logical core cores[i % cores.size()].
      */
-    NOELLE_HELIX_args_t *argsForAllCores;
-    posix_memalign((void **)&argsForAllCores, CACHE_LINE_SIZE, sizeof(NOELLE_HELIX_args_t) * (numCores - 1));
+    WorkStealingThreadPool (uint32_t numberOfWorkers, const std::vector<int32_t> &cores);
 
     /*
-     * Launch threads
+     * Submit a task.
+     *
+     * If the task is submitted by a thread outside the pool and "preferredWorker" is not negative, the task is appended to the queue of that worker.
      */
-    uint64_t loopIsOverFlag = 0;
-    cpu_set_t cores;
-    for (auto i = 0; i < (numCores - 1); ++i) {
-      #ifdef RUNTIME_PRINT
-      fprintf(stderr, "HelixDispatcher: Creating future for core %d\n", i);
-      #endif
-
-      /*
-       * Identify the past and future sequential segment arrays.
-       */
-      auto pastID = i % numOfSSArrays;
-      auto futureID = (i + 1) % numOfSSArrays;
+    void submitAndDetach (void (*task)(void *), void *args, int64_t preferredWorker);
 
-      /*
-       * Fetch the sequential segment array for the current thread.
-       */
-      auto ssArrayPast = (void *)(((uint64_t)ssArrays) + (pastID * ssArraySize));
-      auto ssArrayFuture = (void *)(((uint64_t)ssArrays) + (futureID * ssArraySize));
-      #ifdef RUNTIME_PRINT
-      fprintf(stderr, "HelixDispatcher: defined ss past and future arrays: %ld %ld\n", (int *)ssArrayPast - (int *)mySSGlobal, (int *)ssArrayFuture - (int *)mySSGlobal);
-      #endif
-
-      /*
-       * Prepare the arguments.
-       */
-      auto argsPerCore = &argsForAllCores[i];
-      argsPerCore->parallelizedLoop = parallelizedLoop;
-      argsPerCore->env = env;
-      argsPerCore->loopCarriedArray = loopCarriedArray;
-      argsPerCore->ssArrayPast = ssArrayPast;
-      argsPerCore->ssArrayFuture = ssArrayFuture;
-      argsPerCore->coreID = i;
-      argsPerCore->numCores = numCores;
-      argsPerCore->loopIsOverFlag = &loopIsOverFlag;
-      pthread_spin_init(&(argsPerCore->endLock), PTHREAD_PROCESS_PRIVATE);
-      pthread_spin_lock(&(argsPerCore->endLock));
+    /*
+     * Run a pending task if the current thread is a worker of the pool and it can find one.
+     * Return false otherwise.
+     */
+    bool runPendingTask (void);
 
-      /*
-       * Set the affinity for both the thread and its helper.
-       */
-      /*CPU_ZERO(&cores);
-      auto physicalCore = i * 2;
-      CPU_SET(physicalCore, &cores);
-      CPU_SET(physicalCore + 1, &cores);
-      */
+    static bool isCurrentThreadAWorker (void) {
+      return currentWorkerID >= 0;
+    }
 
-      /*
-       * Launch the thread.
-       */
-      virgil->submitAndDetach(NOELLE_HELIXTrampoline, argsPerCore);
+    ~WorkStealingThreadPool (void);
 
-      /*
-       * Launch the helper thread.
-       */
-      continue ;
-      /*localFutures.push_back(pool.submitToCores(
-        cores,
-        HELIX_helperThread, 
-        ssArrayPast,
-        numOfsequentialSegments,
-        &loopIsOverFlag
-      ));*/
-    }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Submitted pool\n";
-    int futureGotten = 0;
-    #endif
+  private:
+    typedef struct {
+      void (*task)(void *);
+      void *args;
+    } WorkStealingTask_t ;
+
+    class alignas(CACHE_LINE_SIZE) WorkerQueue {
+      public:
+        pthread_spinlock_t lock;
+        std::deque<WorkStealingTask_t> tasks;
+    };
+
+    std::vector<WorkerQueue *> queues;
+    std::vector<std::thread> workers;
+    std::atomic<uint64_t> nextQueue;
+    std::atomic<int64_t> pendingTasks;
+    std::atomic<int64_t> sleepingWorkers;
+    std::atomic<bool> isAlive;
+    std::mutex sleepLock;
+    std::condition_variable sleepCondition;
 
     /*
-     * Run a task.
+     * Identifier of the worker executed by the current thread (-1 for threads outside the pool).
      */
-    auto pastID = (numCores - 1) % numOfSSArrays;
-    auto futureID = 0;
-    auto ssArrayPast = (void *)(((uint64_t)ssArrays) + (pastID * ssArraySize));
-    auto ssArrayFuture = ssArrays;
-    parallelizedLoop(env, loopCarriedArray, ssArrayPast, ssArrayFuture, numCores - 1, numCores, &loopIsOverFlag);
+    static thread_local int64_t currentWorkerID;
+
+    void workerLoop (uint32_t workerID, int32_t logicalCore);
+
+    bool fetchTask (uint32_t workerID, WorkStealingTask_t &task);
+};
+
+/*
+ * Team of workers that stay hot across invocations of parallelized loops.
+ * It is enabled by NOELLE_HOT_TEAM=1, and it runs the tasks of DOALL loops when it is not busy with another loop.
+ *
+ * Workers wait (see AdaptiveWait) on a single word that holds the generation of the team and the number of workers that take part in it.
+ * Hence, a new generation starts with a single store to that word after the task to run has been published.
+ * The workers of a generation decrement a single counter when their task ends, and the thread that started the generation waits for it to become 0 (see join).
+ */
+class HotTeam {
+  public:
 
     /*
-     * Wait for the remaining HELIX tasks.
+     * If "cores" is not empty, the i-th worker is pinned to the logical core cores[i % cores.size()].
      */
-    for (auto i = 0; i < (numCores - 1); ++i) {
-      pthread_spin_lock(&(argsForAllCores[i].endLock));
-    }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Got all futures\n";
-    #endif
+    HotTeam (uint32_t numberOfWorkers, const std::vector<int32_t> &cores);
 
     /*
-     * Free the cores and memory.
+     * Start a new generation where the first "numberOfWorkers" workers of the team run "task".
+     * The i-th worker passes args + (i * argsBytes) to the task.
+     *
+     * Return false if the team is running another generation or it does not have enough workers.
+     * Otherwise, the caller must invoke join.
      */
-    runtime.releaseCores(numCores);
+    bool tryToStart (void (*task)(void *), void *args, uint64_t argsBytes, uint32_t numberOfWorkers);
 
     /*
-     * Free the memory.
+     * Wait for the workers of the current generation.
      */
-    free(argsForAllCores);
-    free(ssArrays);
-
-    DispatcherInfo dispatcherInfo;
-    dispatcherInfo.numberOfThreadsUsed = numCores;
-    return dispatcherInfo;
-  }
-
-  DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegments (
-    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *), 
-    void *env,
-    void *loopCarriedArray,
-    int64_t numCores, 
-    int64_t numOfsequentialSegments
-    ){
-    return NOELLE_HELIX_dispatcher(parallelizedLoop, env, loopCarriedArray, numCores, numOfsequentialSegments, true);
-  }
+    void join (void);
 
-  DispatcherInfo NOELLE_HELIX_dispatcher_criticalSections (
-    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *), 
-    void *env,
-    void *loopCarriedArray,
-    int64_t numCores, 
-    int64_t numOfsequentialSegments
-    ){
-    return NOELLE_HELIX_dispatcher(parallelizedLoop, env, loopCarriedArray, numCores, numOfsequentialSegments, false);
-  }
+    ~HotTeam (void);
 
-  void HELIX_wait (
-    void *sequentialSegment
-    ){
+  private:
 
     /*
-     * Fetch the spinlock
+     * The lowest bits of the generation word hold the number of workers that take part in the generation, the other bits hold its sequence number.
+     * The sequence number wraps around: a worker would miss a generation only if it did not run at all while 2^22 other generations were started.
      */
-    auto ss = (pthread_spinlock_t *) sequentialSegment;
+    static const uint32_t workersBits = 10;
+    static const uint32_t workersMask = (1 << workersBits) - 1;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> generation;
+    std::atomic<uint32_t> sleepingWorkers;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> runningWorkers;
+    std::atomic<uint32_t> isJoinerSleeping;
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> isBusy;
+    void (*task)(void *);
+    uint8_t *args;
+    uint64_t argsBytes;
+    std::atomic<bool> isAlive;
+    std::vector<std::thread> workers;
+
+    void workerLoop (uint32_t workerID, int32_t logicalCore);
+};
 
-    #ifdef RUNTIME_PRINT
-    assert(ss != NULL);
-    fprintf(stderr, "HelixDispatcher: Waiting on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
-    #endif
+/*
+ * Helper thread of HELIX tasks (see HELIX_helperThread).
+ *
+ * A helper is pinned to a logical core and it helps the task that runs on the SMT sibling of that core.
+ * The two logical cores share the private caches of their physical core.
+ * Hence, the cache lines of sequential segments and of spilled loop-carried values the helper loads are ready for the task when it needs them.
+ */
+class HELIXHelperThread {
+  public:
+    HELIXHelperThread (int32_t logicalCore);
 
     /*
-     * Wait
+     * Start helping a task that runs the iterations with tickets firstTicket, firstTicket + ticketStep, and so on.
+     *
+     * Return false if the helper is helping another task.
+     * Otherwise, the caller must invoke stop before the sequential segments and the loop-carried values are released.
      */
-    pthread_spin_lock(ss);
+    bool tryToStart (
+      HELIXSequentialSegment *ssArray,
+      int64_t numOfsequentialSegments,
+      void *loopCarriedArray,
+      int64_t loopCarriedArrayBytes,
+      int64_t firstTicket,
+      int64_t ticketStep
+      );
 
-    #ifdef RUNTIME_PRINT
-    fprintf(stderr, "HelixDispatcher: Waited on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
-    #endif
+    void stop (void);
 
-    return ;
-  }
+    ~HELIXHelperThread (void);
 
-  void HELIX_signal (
-    void *sequentialSegment
-    ){
+  private:
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> isBusy;
+    HELIXSequentialSegment *ssArray;
+    int64_t numOfsequentialSegments;
+    void *loopCarriedArray;
+    int64_t loopCarriedArrayBytes;
+    int64_t firstTicket;
+    int64_t ticketStep;
+    AdaptiveSemaphore startLock;
+    AdaptiveSemaphore stoppedLock;
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> isStopRequested;
+    std::atomic<bool> isAlive;
+    std::thread helper;
+
+    void helperLoop (int32_t logicalCore);
+};
+
+class DSWPQueue;
+
+class NoelleRuntime {
+  public:
+    NoelleRuntime ();
 
     /*
-     * Fetch the spinlock
+     * Reserve cores for a parallelized loop.
+     *
+     * A thread that runs within a parallelized loop and that has been given a budget of cores (see setCoreBudget) reserves the cores of its budget.
+     * Otherwise, cores are reserved from the ones that are idle in the system.
+     * The caller needs to pass "fromBudget" to releaseCores.
      */
-    auto ss = (pthread_spinlock_t *) sequentialSegment;
+    uint32_t reserveCores (uint32_t coresRequested, bool *fromBudget);
 
-    #ifdef RUNTIME_PRINT
-    assert(ss != NULL);
-    fprintf(stderr, "HelixDispatcher: Signaling on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
-    #endif
+    void releaseCores (uint32_t coresReleased, bool fromBudget);
 
     /*
-     * Signal
+     * Cores the current thread can use to run the parallelized loops it invokes (nested parallelism).
+     * A budget of 0 or 1 means the current thread has no core to spare besides its own.
      */
-    pthread_spin_unlock(ss);
+    uint32_t getCoreBudget (void) const ;
 
-    #ifdef RUNTIME_PRINT
-    fprintf(stderr, "HelixDispatcher: Signaled on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
-    #endif
+    void setCoreBudget (uint32_t cores);
 
-    return ;
+    DOALL_args_t * getDOALLArgs (uint32_t cores, uint32_t *index);
+
+    void releaseDOALLArgs (uint32_t index);
+
+    /*
+     * Run a task asynchronously.
+     *
+     * Tasks that need to communicate (e.g., consecutive DOALL chunks, HELIX and DSWP neighbours) should use consecutive preferred workers.
+     * Consecutive workers run on cores that are close to each other (see CoreTopology).
+     */
+    void submitAndDetach (void (*task)(void *), void *args, int64_t preferredWorker = -1);
+
+    /*
+     * Wait for a task submitted with submitAndDetach to signal "endLock".
+     *
+     * Workers of the pool that wait for the tasks they submitted (e.g., nested loops) run pending tasks meanwhile (help-first join).
+     * Hence, the tasks make progress even if every worker is waiting.
+     */
+    void waitForTask (AdaptiveSemaphore &endLock);
+
+    /*
+     * Pin the current thread if it is a VIRGIL worker that has not been pinned yet.
+     * Workers of the work-stealing pool are pinned when they start.
+     */
+    void placeCurrentWorker (void);
+
+    /*
+     * Queues of DSWP pipelines.
+     *
+     * Queues are kept in a pool and reused across invocations of pipelines.
+     * Batched queues publish blocks of NOELLE_DSWP_QUEUE_BLOCK_BYTES bytes (a cache line by default).
+     * Queues hold at most NOELLE_DSWP_QUEUE_CAPACITY values (1024 by default) or two blocks, whichever is bigger.
+     */
+    DSWPQueue * getDSWPQueue (uint64_t valueBytes, bool isBatched);
+
+    void releaseDSWPQueue (DSWPQueue *queue);
+
+    /*
+     * Sequential segments of HELIX loops.
+     *
+     * They are kept in a pool and reused across invocations of HELIX loops.
+     * The capacity of the returned array (which is at least "numOfsequentialSegments") needs to be given back when the array is released.
+     */
+    HELIXSequentialSegment * getHELIXSequentialSegments (uint64_t numOfsequentialSegments, uint64_t *capacity);
+
+    void releaseHELIXSequentialSegments (HELIXSequentialSegment *sequentialSegments, uint64_t capacity);
+
+    /*
+     * Helper thread for the HELIX task that runs on the current thread (see HELIXHelperThread).
+     *
+     * Helpers are enabled by NOELLE_HELIX_HELPER_THREADS=1 when threads are pinned (NOELLE_PIN_THREADS=1).
+     * They are created the first time a task runs next to their logical core, and they are not used when the HELIX loop has more threads than the physical cores (the SMT siblings run tasks then).
+     *
+     * Return null if the current thread cannot have a helper.
+     */
+    HELIXHelperThread * getHELIXHelperOfCurrentThread (uint32_t threadsOfTheLoop);
+
+    /*
+     * Telemetry of the parallelized loops (see RuntimeTelemetry).
+     */
+    RuntimeTelemetry telemetry;
+
+    /*
+     * Model that chooses the number of threads of each invocation of a parallelized loop (see LoopCostModel).
+     */
+    LoopCostModel loopCostModel;
+
+    /*
+     * Thread pools.
+     * Only one of them is allocated: the work-stealing pool by default, VIRGIL if NOELLE_THREAD_POOL=virgil.
+     */
+    WorkStealingThreadPool *workStealingPool;
+    ThreadPoolForCSingleQueue *virgil;
+
+    /*
+     * Hot team of workers (null unless NOELLE_HOT_TEAM=1).
+     */
+    HotTeam *hotTeam;
+
+    ~NoelleRuntime(void);
+
+  private:
+    mutable pthread_spinlock_t doallMemoryLock;
+    std::vector<uint32_t> doallMemorySizes;
+    std::vector<bool> doallMemoryAvailability;
+    std::vector<DOALL_args_t *> doallMemory;
+
+    uint32_t getMaximumNumberOfCores (void);
+
+    /*
+     * Topology of the machine and logical cores the workers are pinned to.
+     * Threads are pinned only if NOELLE_PIN_THREADS=1.
+     * Pinning is opt-in because every NOELLE process uses the same placement, so concurrent processes would pile onto the same cores.
+     */
+    CoreTopology topology;
+    std::vector<int32_t> workerCores;
+    std::atomic<uint64_t> nextWorkerToPlace;
+    static thread_local bool isCurrentWorkerPlaced;
+
+    mutable pthread_spinlock_t dswpQueuesLock;
+    std::vector<DSWPQueue *> availableDSWPQueues;
+    uint32_t dswpQueueBlockBytes;
+    uint64_t dswpQueueCapacity;
+
+    mutable pthread_spinlock_t helixSequentialSegmentsLock;
+    std::vector<std::pair<HELIXSequentialSegment *, uint64_t>> availableHELIXSequentialSegments;
+
+    bool areHELIXHelperThreadsEnabled;
+    mutable pthread_spinlock_t helixHelperThreadsLock;
+    std::unordered_map<int32_t, HELIXHelperThread *> helixHelperThreads;
+
+    /*
+     * Budget of cores of the current thread.
+     */
+    static thread_local uint32_t coreBudget;
+
+    /*
+     * Current number of idle cores.
+     */
+    int32_t NOELLE_idleCores;
+
+    /*
+     * Maximum number of cores.
+     */
+    uint32_t maxCores;
+
+    mutable pthread_spinlock_t spinLock;
+};
+
+static NoelleRuntime runtime{};
+
+/*
+ * Bounded queue between two DSWP stages.
+ * A DSWP queue always has exactly one producer stage and one consumer stage.
+ *
+ * Each slot of the queue holds a value of "slotBytes" bytes.
+ * Values are either scalars (see push and waitPop) or records that pack several values the producer sends at once (see pushRecord and waitPopRecord).
+ *
+ * The index published by the producer (tail) and the one published by the consumer (head) live in separate cache lines.
+ * Each side keeps a private copy of the index of the other side and reloads it only when the queue looks full (producer) or empty (consumer).
+ * Producers that run too far ahead wait for space and consumers wait for values with the policy of AdaptiveWait.
+ *
+ * Each side publishes its index every "valuesPerPublish" values (see initialize).
+ * Batched queues publish a block of values at a time; the producer publishes its last values when it flushes the queue.
+ * A thread publishes the indexes of all its queues before waiting on any of them.
+ * Otherwise, it could wait for a thread that is waiting for one of these indexes.
+ */
+class DSWPQueue {
+  public:
+    DSWPQueue (uint64_t bufferBytes)
+      : bufferBytes{bufferBytes}
+      {
+      void *slotsMemory = nullptr;
+      if (posix_memalign(&slotsMemory, CACHE_LINE_SIZE, std::max(bufferBytes, (uint64_t)CACHE_LINE_SIZE)) != 0){
+        fprintf(stderr, "NOELLE: Runtime: ERROR = not enough memory to allocate the slots of a DSWP queue\n");
+        abort();
+      }
+      this->slots = (uint8_t *)slotsMemory;
+
+      return ;
+    }
+
+    /*
+     * Empty the queue.
+     * The queue must not be in use.
+     *
+     * The capacity must be a power of 2.
+     */
+    void initialize (uint64_t slotBytes, uint64_t capacity, uint32_t valuesPerPublish) {
+      assert((slotBytes * capacity) <= this->bufferBytes);
+      assert(valuesPerPublish >= 1);
+      assert((2 * valuesPerPublish) <= capacity);
+      this->slotBytes = slotBytes;
+      this->capacity = capacity;
+      this->valuesPerPublish = valuesPerPublish;
+      this->tail.store(0);
+      this->head.store(0);
+      this->producerTail = 0;
+      this->producerCachedHead = 0;
+      this->isTailPending = false;
+      this->occupancySum = 0;
+      this->maximumOccupancy = 0;
+      this->fullWaits = 0;
+      this->consumerHead = 0;
+      this->consumerCachedTail = 0;
+      this->isHeadPending = false;
+      this->emptyWaits = 0;
+
+      return ;
+    }
+
+    uint64_t getBufferBytes (void) const {
+      return this->bufferBytes;
+    }
+
+    /*
+     * Occupancy of the queue since it has been initialized.
+     * Occupancy is sampled only when the telemetry is enabled; waits are always counted.
+     * The queue must not be in use.
+     */
+    RuntimeTelemetry::QueueRecord getTelemetry (void) const {
+      RuntimeTelemetry::QueueRecord record;
+      record.valueBytes = this->slotBytes;
+      record.capacity = this->capacity;
+      record.values = this->producerTail;
+      record.occupancySum = this->occupancySum;
+      record.maximumOccupancy = this->maximumOccupancy;
+      record.fullWaits = this->fullWaits;
+      record.emptyWaits = this->emptyWaits;
+
+      return record;
+    }
+
+    template <typename T>
+    void push (T value) {
+      *((T *)this->fetchSlotToFill()) = value;
+      this->publishFilledSlot();
+
+      return ;
+    }
+
+    void pushRecord (void *record) {
+      memcpy(this->fetchSlotToFill(), record, this->slotBytes);
+      this->publishFilledSlot();
+
+      return ;
+    }
+
+    void flush (void) {
+      this->isTailPending = false;
+      if (this->producerTail == this->tail.load(std::memory_order_relaxed)){
+        return ;
+      }
+      this->tail.store(this->producerTail, std::memory_order_release);
+      this->notEmpty.notifyAll();
+
+      return ;
+    }
+
+    /*
+     * Publish the indexes of all the queues the current thread uses.
+     */
+    static void publishQueuesOfCurrentThread (void) {
+      for (auto queue : DSWPQueue::tailsToPublish){
+        queue->flush();
+      }
+      DSWPQueue::tailsToPublish.clear();
+      for (auto queue : DSWPQueue::headsToPublish){
+        queue->publishHead();
+      }
+      DSWPQueue::headsToPublish.clear();
+
+      return ;
+    }
+
+    /*
+     * Forget the queues of the current thread.
+     * This must be invoked when a stage ends as queues are reused by later pipelines.
+     */
+    static void forgetQueuesOfCurrentThread (void) {
+      DSWPQueue::tailsToPublish.clear();
+      DSWPQueue::headsToPublish.clear();
+
+      return ;
+    }
+
+    template <typename T>
+    void waitPop (T &value) {
+      value = *((T *)this->fetchSlotToDrain());
+      this->publishDrainedSlot();
+
+      return ;
+    }
+
+    void waitPopRecord (void *record) {
+      memcpy(record, this->fetchSlotToDrain(), this->slotBytes);
+      this->publishDrainedSlot();
+
+      return ;
+    }
+
+    ~DSWPQueue () {
+      free(this->slots);
+
+      return ;
+    }
+
+  private:
+    uint8_t *slots;
+    uint64_t bufferBytes;
+    uint64_t slotBytes;
+    uint64_t capacity;
+    uint32_t valuesPerPublish;
+
+    static thread_local std::vector<DSWPQueue *> tailsToPublish;
+    static thread_local std::vector<DSWPQueue *> headsToPublish;
+
+    uint8_t * fetchSlotToFill (void) {
+
+      /*
+       * Wait for space if the queue is full.
+       * The consumer might be waiting for the values we did not publish yet, so publish them first.
+       */
+      if ((this->producerTail - this->producerCachedHead) == this->capacity){
+        this->fullWaits++;
+        this->flush();
+        DSWPQueue::publishQueuesOfCurrentThread();
+        this->notFull.waitUntil([this](void) -> bool {
+          this->producerCachedHead = this->head.load(std::memory_order_acquire);
+          return (this->producerTail - this->producerCachedHead) < this->capacity;
+        });
+      }
+
+      return this->slots + ((this->producerTail & (this->capacity - 1)) * this->slotBytes);
+    }
+
+    void publishFilledSlot (void) {
+      this->producerTail++;
+      if (RuntimeTelemetry::enabled){
+        auto occupancy = this->producerTail - this->head.load(std::memory_order_relaxed);
+        this->occupancySum += occupancy;
+        this->maximumOccupancy = std::max(this->maximumOccupancy, occupancy);
+      }
+      if ((this->producerTail - this->tail.load(std::memory_order_relaxed)) >= this->valuesPerPublish){
+        this->flush();
+
+      } else if (!this->isTailPending){
+        this->isTailPending = true;
+        DSWPQueue::tailsToPublish.push_back(this);
+      }
+
+      return ;
+    }
+
+    uint8_t * fetchSlotToDrain (void) {
+
+      /*
+       * Wait for a value if the queue is empty.
+       * The producer might be waiting for the space we did not publish yet, so publish it first.
+       */
+      if (this->consumerHead == this->consumerCachedTail){
+        this->emptyWaits++;
+        this->publishHead();
+        DSWPQueue::publishQueuesOfCurrentThread();
+        this->notEmpty.waitUntil([this](void) -> bool {
+          this->consumerCachedTail = this->tail.load(std::memory_order_acquire);
+          return this->consumerHead != this->consumerCachedTail;
+        });
+      }
+
+      return this->slots + ((this->consumerHead & (this->capacity - 1)) * this->slotBytes);
+    }
+
+    void publishDrainedSlot (void) {
+      this->consumerHead++;
+      if ((this->consumerHead - this->head.load(std::memory_order_relaxed)) >= this->valuesPerPublish){
+        this->publishHead();
+
+      } else if (!this->isHeadPending){
+        this->isHeadPending = true;
+        DSWPQueue::headsToPublish.push_back(this);
+      }
+
+      return ;
+    }
+
+    void publishHead (void) {
+      this->isHeadPending = false;
+      if (this->consumerHead == this->head.load(std::memory_order_relaxed)){
+        return ;
+      }
+      this->head.store(this->consumerHead, std::memory_order_release);
+      this->notFull.notifyAll();
+
+      return ;
+    }
+
+    /*
+     * Published indexes.
+     */
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head;
+
+    /*
+     * State of the producer.
+     */
+    alignas(CACHE_LINE_SIZE) uint64_t producerTail;
+    uint64_t producerCachedHead;
+    bool isTailPending;
+    uint64_t occupancySum;
+    uint64_t maximumOccupancy;
+    uint64_t fullWaits;
+    AdaptiveEventCount notFull;
+
+    /*
+     * State of the consumer.
+     */
+    alignas(CACHE_LINE_SIZE) uint64_t consumerHead;
+    uint64_t consumerCachedTail;
+    bool isHeadPending;
+    uint64_t emptyWaits;
+    AdaptiveEventCount notEmpty;
+};
+
+thread_local std::vector<DSWPQueue *> DSWPQueue::tailsToPublish;
+thread_local std::vector<DSWPQueue *> DSWPQueue::headsToPublish;
+
+/*
+ * Elements of arrays reduced by NOELLE_arrayReduction_* (e.g., histograms).
+ *
+ * An element is an integer of 1, 2, 4, or 8 bytes, a float, or a double.
+ * Values are passed around as their raw bits stored in the least significant bytes of a uint64_t.
+ */
+class ArrayReductionElement {
+  public:
+
+    /*
+     * Operations used to accumulate values to elements.
+     * They must match ArrayReduction::Operation of the compiler.
+     */
+    enum Operation {ADD = 0, SUB = 1, MUL = 2, OR = 3, AND = 4, XOR = 5};
+
+    static uint64_t getIdentity (int64_t elementBytes, bool isFloatingPoint, int64_t operation) {
+      switch (operation){
+        case ADD:
+        case SUB:
+
+          /*
+           * -0.0 is the identity of floating point additions (+0.0 + -0.0 is +0.0).
+           */
+          if (isFloatingPoint){
+            return (elementBytes == 4) ? ArrayReductionElement::toBits<float>(-0.0f) : ArrayReductionElement::toBits<double>(-0.0);
+          }
+          return 0;
+
+        case MUL:
+          if (isFloatingPoint){
+            return (elementBytes == 4) ? ArrayReductionElement::toBits<float>(1.0f) : ArrayReductionElement::toBits<double>(1.0);
+          }
+          return 1;
+
+        case AND:
+          return ArrayReductionElement::truncate(elementBytes, ~((uint64_t)0));
+
+        default:
+          return 0;
+      }
+    }
+
+    /*
+     * Return the operation used to merge private copies accumulated with @operation.
+     * Subtractions have been accumulated to the private copies already, so their copies are added.
+     */
+    static int64_t getMergeOperation (int64_t operation) {
+      if (operation == SUB){
+        return ADD;
+      }
+
+      return operation;
+    }
+
+    static uint64_t combine (int64_t elementBytes, bool isFloatingPoint, int64_t operation, uint64_t a, uint64_t b) {
+      if (isFloatingPoint){
+        if (elementBytes == 4){
+          return ArrayReductionElement::combineFloatingPointsAs<float>(operation, a, b);
+        }
+        return ArrayReductionElement::combineFloatingPointsAs<double>(operation, a, b);
+      }
+      switch (elementBytes){
+        case 1:
+          return ArrayReductionElement::combineIntegersAs<uint8_t>(operation, a, b);
+        case 2:
+          return ArrayReductionElement::combineIntegersAs<uint16_t>(operation, a, b);
+        case 4:
+          return ArrayReductionElement::combineIntegersAs<uint32_t>(operation, a, b);
+        default:
+          return ArrayReductionElement::combineIntegersAs<uint64_t>(operation, a, b);
+      }
+    }
+
+    /*
+     * Accumulate @bits to @element, which might be concurrently updated by other threads.
+     */
+    static void accumulateAtomically (void *element, int64_t elementBytes, bool isFloatingPoint, int64_t operation, uint64_t bits) {
+      switch (elementBytes){
+        case 1:
+          ArrayReductionElement::accumulateAtomicallyAs<uint8_t>(element, elementBytes, isFloatingPoint, operation, bits);
+          break ;
+        case 2:
+          ArrayReductionElement::accumulateAtomicallyAs<uint16_t>(element, elementBytes, isFloatingPoint, operation, bits);
+          break ;
+        case 4:
+          ArrayReductionElement::accumulateAtomicallyAs<uint32_t>(element, elementBytes, isFloatingPoint, operation, bits);
+          break ;
+        default:
+          ArrayReductionElement::accumulateAtomicallyAs<uint64_t>(element, elementBytes, isFloatingPoint, operation, bits);
+          break ;
+      }
+
+      return ;
+    }
+
+    static uint64_t load (void *element, int64_t elementBytes) {
+      uint64_t bits = 0;
+      memcpy(&bits, element, elementBytes);
+
+      return bits;
+    }
+
+    static void store (void *element, int64_t elementBytes, uint64_t bits) {
+      memcpy(element, &bits, elementBytes);
+
+      return ;
+    }
+
+  private:
+    static uint64_t truncate (int64_t elementBytes, uint64_t bits) {
+      if (elementBytes >= 8){
+        return bits;
+      }
+
+      return bits & ((((uint64_t)1) << (elementBytes * 8)) - 1);
+    }
+
+    template <typename T>
+    static uint64_t toBits (T value) {
+      uint64_t bits = 0;
+      memcpy(&bits, &value, sizeof(T));
+
+      return bits;
+    }
+
+    template <typename T>
+    static T fromBits (uint64_t bits) {
+      T value;
+      memcpy(&value, &bits, sizeof(T));
+
+      return value;
+    }
+
+    template <typename T>
+    static uint64_t combineFloatingPointsAs (int64_t operation, uint64_t a, uint64_t b) {
+      auto x = ArrayReductionElement::fromBits<T>(a);
+      auto y = ArrayReductionElement::fromBits<T>(b);
+      T result;
+      switch (operation){
+        case SUB:
+          result = x - y;
+          break ;
+        case MUL:
+          result = x * y;
+          break ;
+        default:
+          result = x + y;
+          break ;
+      }
+
+      return ArrayReductionElement::toBits<T>(result);
+    }
+
+    /*
+     * The least significant bits of the results of these operations only depend on the least significant bits of their operands.
+     * Hence, we compute them on 64 bits and we truncate the result.
+     */
+    template <typename T>
+    static uint64_t combineIntegersAs (int64_t operation, uint64_t x, uint64_t y) {
+      uint64_t result;
+      switch (operation){
+        case SUB:
+          result = x - y;
+          break ;
+        case MUL:
+          result = x * y;
+          break ;
+        case OR:
+          result = x | y;
+          break ;
+        case AND:
+          result = x & y;
+          break ;
+        case XOR:
+          result = x ^ y;
+          break ;
+        default:
+          result = x + y;
+          break ;
+      }
+
+      return (uint64_t)(T)result;
+    }
+
+    template <typename Bits>
+    static void accumulateAtomicallyAs (void *element, int64_t elementBytes, bool isFloatingPoint, int64_t operation, uint64_t bits) {
+      auto pointer = (Bits *)element;
+      auto oldBits = __atomic_load_n(pointer, __ATOMIC_RELAXED);
+      while (true){
+        auto newBits = (Bits)ArrayReductionElement::combine(elementBytes, isFloatingPoint, operation, oldBits, bits);
+        if (__atomic_compare_exchange_n(pointer, &oldBits, newBits, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)){
+          break ;
+        }
+      }
+
+      return ;
+    }
+};
+
+/*
+ * A sparse private copy of an array reduced by NOELLE_arrayReduction_*.
+ *
+ * It is used when the array is too big (or of unknown size) to be copied by every task.
+ * It stores only the elements accumulated by the task that owns it in an open-addressing hash table indexed by the index of the element.
+ */
+class ArrayReductionTable {
+  public:
+    ArrayReductionTable (int64_t elementBytes, bool isFloatingPoint, int64_t operation)
+      : elementBytes{elementBytes}
+      , isFloatingPoint{isFloatingPoint}
+      , operation{operation}
+      , identity{ArrayReductionElement::getIdentity(elementBytes, isFloatingPoint, operation)}
+      , numberOfElements{0}
+      , slots(ArrayReductionTable::initialCapacity)
+      {
+      return ;
+    }
+
+    void accumulate (int64_t index, uint64_t bits) {
+      auto slot = this->fetchSlot(index);
+      slot->value = ArrayReductionElement::combine(this->elementBytes, this->isFloatingPoint, this->operation, slot->value, bits);
+
+      return ;
+    }
+
+    /*
+     * Accumulate the elements of this copy to the array @shared.
+     * Tasks merge their copies concurrently.
+     */
+    void mergeInto (void *shared) {
+      auto mergeOperation = ArrayReductionElement::getMergeOperation(this->operation);
+      for (auto &slot : this->slots){
+        if (  false
+              || (!slot.isUsed)
+              || (slot.value == this->identity)
+           ){
+          continue ;
+        }
+        auto element = ((uint8_t *)shared) + (slot.index * this->elementBytes);
+        ArrayReductionElement::accumulateAtomically(element, this->elementBytes, this->isFloatingPoint, mergeOperation, slot.value);
+      }
+
+      return ;
+    }
+
+  private:
+    struct Slot {
+      int64_t index;
+      uint64_t value;
+      bool isUsed;
+    };
+
+    static constexpr uint64_t initialCapacity = 1024;
+
+    Slot * fetchSlot (int64_t index) {
+
+      /*
+       * Keep the table at most half full.
+       */
+      if ((this->numberOfElements * 2) >= this->slots.size()){
+        this->grow();
+      }
+
+      auto slot = this->findSlot(this->slots, index);
+      if (!slot->isUsed){
+        slot->index = index;
+        slot->value = this->identity;
+        slot->isUsed = true;
+        this->numberOfElements++;
+      }
+
+      return slot;
+    }
+
+    static Slot * findSlot (std::vector<Slot> &slots, int64_t index) {
+      auto mask = slots.size() - 1;
+      auto position = (((uint64_t)index) * 0x9E3779B97F4A7C15ull) >> 32;
+      while (true){
+        auto slot = &slots[position & mask];
+        if (  false
+              || (!slot->isUsed)
+              || (slot->index == index)
+           ){
+          return slot;
+        }
+        position++;
+      }
+    }
+
+    void grow (void) {
+      std::vector<Slot> newSlots(this->slots.size() * 2);
+      for (auto &slot : this->slots){
+        if (!slot.isUsed){
+          continue ;
+        }
+        *ArrayReductionTable::findSlot(newSlots, slot.index) = slot;
+      }
+      this->slots.swap(newSlots);
+
+      return ;
+    }
+
+    int64_t elementBytes;
+    bool isFloatingPoint;
+    int64_t operation;
+    uint64_t identity;
+    uint64_t numberOfElements;
+    std::vector<Slot> slots;
+};
+
+extern "C" {
+
+  /******************************************** NOELLE APIs ***********************************************/
+
+  class DispatcherInfo {
+    public:
+      int32_t numberOfThreadsUsed;
+      int64_t unusedVariableToPreventOptIfStructHasOnlyOneVariable;
+  };
+
+  class DOALLChunkInfo {
+    public:
+      int64_t firstIteration;
+      int64_t numberOfIterations;
+  };
+
+  /*
+   * Dispatch threads to run a DOALL loop.
+   *
+   * The scheduling is one of DOALL_*_SCHEDULING.
+   * The number of iterations is a hint (0 if unknown).
+   * It is used to choose the number of threads (see LoopCostModel), to avoid creating threads that would not get any chunk, and by the guided scheduling.
+   * The loop ID identifies the loop in the telemetry (see RuntimeTelemetry).
+   *
+   * If the loop has reduced live-out variables, "combineReductions" combines their private copies of two task instances (see ReductionTree).
+   * In this case, the caller only needs to read the private copies of the task instance 0.
+   * Otherwise, "combineReductions" is null.
+   *
+   * The deterministic scheduling always runs "maxNumberOfCores" task instances, independently of the number of threads used.
+   * The returned number of threads is the number of task instances that have been run.
+   */
+  DispatcherInfo NOELLE_DOALLDispatcher (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *), 
+    void *env, 
+    void (*combineReductions)(void *, int64_t, int64_t),
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize,
+    int64_t scheduling,
+    int64_t numberOfIterations,
+    int64_t loopID
+    );
+
+  /*
+   * Start a DOALL loop without waiting for it to end (see NOELLE_DOALLDispatcher).
+   * All task instances run in threads of the runtime, so the caller can run code that does not depend on the loop meanwhile.
+   *
+   * The returned handle needs to be passed to NOELLE_DOALL_join before relying on the effects of the loop.
+   * It is null if the loop has already been run by the caller (see LoopCostModel).
+   */
+  void * NOELLE_DOALLDispatcherAsync (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *), 
+    void *env, 
+    void (*combineReductions)(void *, int64_t, int64_t),
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize,
+    int64_t scheduling,
+    int64_t numberOfIterations,
+    int64_t loopID
+    );
+
+  /*
+   * Wait for a DOALL loop started by NOELLE_DOALLDispatcherAsync.
+   * Nothing happens if the handle is null.
+   */
+  void NOELLE_DOALL_join (
+    void *invocation
+    );
+
+  /*
+   * Claim the next chunk of iterations of a DOALL loop that uses a dynamic or guided scheduling.
+   *
+   * The returned chunk is empty if the loop has been cancelled by an iteration that comes before it (see NOELLE_DOALL_cancel).
+   * In this case, the task needs to end without taking any exit of the loop.
+   */
+  DOALLChunkInfo NOELLE_DOALL_claimChunk (
+    void *schedule
+    );
+
+  /*
+   * Declare that an iteration of a DOALL loop that uses a dynamic or guided scheduling took the exit "exitBlockID" of the loop.
+   *
+   * Chunks that start after the earliest of such iterations are cancelled, and the exit taken by that iteration is stored in "exitBlockTaken".
+   */
+  void NOELLE_DOALL_cancel (
+    void *schedule,
+    int64_t iteration,
+    int32_t exitBlockID,
+    int32_t *exitBlockTaken
+    );
+
+  /*
+   * Allocate and free objects that never outlive the iteration of a DOALL loop that allocates them (see IterationArena).
+   * They have the signatures of malloc, calloc, and free, as the compiler replaces calls to the latter with calls to them within DOALL tasks.
+   */
+  void * NOELLE_arena_malloc (
+    uint64_t bytes
+    );
+
+  void * NOELLE_arena_calloc (
+    uint64_t numberOfElements,
+    uint64_t elementBytes
+    );
+
+  void NOELLE_arena_free (
+    void *object
+    );
+
+
+  /******************************************** NOELLE API implementations ***********************************************/
+
+  typedef void (*stageFunctionPtr_t)(void *, void*);
+
+  void printReachedS(std::string s)
+  {
+    auto outS = "Reached: " + s;
+    printf("%s\n",outS.c_str());
+  }
+
+  void printReachedI(int i){
+    printf("Reached: %d\n",i);
+  }
+
+  void printPushedP(int32_t *p){
+    printf("Pushed: %p\n", p);
+  }
+
+  void printPulledP(int32_t *p){
+    printf("Pulled: %p\n", p);
+  }
+
+  void queuePush8(DSWPQueue *queue, int8_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes8++;
+    #endif
+
+    return ;
+  }
+
+  void queuePop8(DSWPQueue *queue, int8_t *val) { 
+    queue->waitPop(*val); 
+    return ;
+  }
+
+  void queuePush16(DSWPQueue *queue, int16_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes16++;
+    #endif
+
+    return ;
+  }
+
+  void queuePop16(DSWPQueue *queue, int16_t *val) { 
+    queue->waitPop(*val);
+  }
+
+  void queuePush32(DSWPQueue *queue, int32_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes32++;
+    #endif
+
+    return ;
+  }
+
+  void queuePop32(DSWPQueue *queue, int32_t *val) { 
+    queue->waitPop(*val);
+  }
+
+  void queuePush64(DSWPQueue *queue, int64_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes64++;
+    #endif
+
+    return ;
+  }
+
+  void queuePop64(DSWPQueue *queue, int64_t *val) { 
+    queue->waitPop(*val); 
+
+    return ;
+  }
+
+  void queueBatchedPush8(DSWPQueue *queue, int8_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes8++;
+    #endif
+
+    return ;
+  }
+
+  void queueBatchedPop8(DSWPQueue *queue, int8_t *val) { 
+    queue->waitPop(*val); 
+
+    return ;
+  }
+
+  void queueBatchedFlush8(DSWPQueue *queue) { 
+    queue->flush(); 
+
+    return ;
+  }
+
+  void queueBatchedPush16(DSWPQueue *queue, int16_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes16++;
+    #endif
+
+    return ;
+  }
+
+  void queueBatchedPop16(DSWPQueue *queue, int16_t *val) { 
+    queue->waitPop(*val); 
+
+    return ;
+  }
+
+  void queueBatchedFlush16(DSWPQueue *queue) { 
+    queue->flush(); 
+
+    return ;
+  }
+
+  void queueBatchedPush32(DSWPQueue *queue, int32_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes32++;
+    #endif
+
+    return ;
+  }
+
+  void queueBatchedPop32(DSWPQueue *queue, int32_t *val) { 
+    queue->waitPop(*val); 
+
+    return ;
+  }
+
+  void queueBatchedFlush32(DSWPQueue *queue) { 
+    queue->flush(); 
+
+    return ;
+  }
+
+  void queueBatchedPush64(DSWPQueue *queue, int64_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes64++;
+    #endif
+
+    return ;
+  }
+
+  void queueBatchedPop64(DSWPQueue *queue, int64_t *val) { 
+    queue->waitPop(*val); 
+
+    return ;
+  }
+
+  void queueBatchedFlush64(DSWPQueue *queue) { 
+    queue->flush(); 
+
+    return ;
+  }
+
+  /*
+   * Queues of values of any size and of records that pack several values.
+   * The size of the values of a queue is given to the DSWP dispatcher.
+   */
+  void queuePushRecord(DSWPQueue *queue, void *record) { 
+    queue->pushRecord(record); 
+
+    return ;
+  }
+
+  void queuePopRecord(DSWPQueue *queue, void *record) { 
+    queue->waitPopRecord(record); 
+
+    return ;
+  }
+
+  void queueBatchedPushRecord(DSWPQueue *queue, void *record) { 
+    queue->pushRecord(record); 
+
+    return ;
+  }
+
+  void queueBatchedPopRecord(DSWPQueue *queue, void *record) { 
+    queue->waitPopRecord(record); 
+
+    return ;
+  }
+
+  void queueBatchedFlushRecord(DSWPQueue *queue) { 
+    queue->flush(); 
+
+    return ;
+  }
+
+
+  /**********************************************************************
+   *                DOALL
+   **********************************************************************/
+
+  /*
+   * Run task instances of a DOALL loop that uses the deterministic scheduling until all of them have been claimed.
+   *
+   * The chunks of iterations of a task instance, and therefore the values it accumulates to its private copies of reduced variables, do not depend on the thread that runs it.
+   * The private copies are combined as soon as the task instance ends.
+   */
+  static void NOELLE_DOALL_runTaskInstances (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *), 
+    void *env, 
+    int64_t chunkSize,
+    DOALL_schedule_t *schedule,
+    ReductionTree *reductionTree
+    ){
+    while (true){
+
+      /*
+       * Claim the next task instance.
+       */
+      auto instanceID = schedule->nextTaskInstance.fetch_add(1, std::memory_order_relaxed);
+      if (instanceID >= schedule->numberOfTaskInstances){
+        break ;
+      }
+
+      /*
+       * Run it.
+       */
+      {
+        IterationArena::TaskScope arenaScope;
+        parallelizedLoop(env, instanceID, schedule->numberOfTaskInstances, chunkSize, nullptr);
+      }
+      if (reductionTree != nullptr){
+        reductionTree->arrive(instanceID);
+      }
+    }
+
+    return ;
+  }
+
+  static void NOELLE_DOALL_runTask (DOALL_args_t *DOALLArgs){
+    if (RuntimeTelemetry::enabled){
+      DOALLArgs->startTime = RuntimeTelemetry::now();
+    }
+
+    /*
+     * Invoke
+     *
+     * Parallelized loops invoked by the task can use the cores of the budget given to this thread.
+     */
+    auto previousCoreBudget = runtime.getCoreBudget();
+    runtime.setCoreBudget(DOALLArgs->coreBudget);
+    if (  true
+          && (DOALLArgs->schedule != nullptr)
+          && (DOALLArgs->schedule->scheduling == DOALL_DETERMINISTIC_SCHEDULING)
+       ){
+      NOELLE_DOALL_runTaskInstances(DOALLArgs->parallelizedLoop, DOALLArgs->env, DOALLArgs->chunkSize, DOALLArgs->schedule, DOALLArgs->reductionTree);
+
+    } else {
+      {
+        IterationArena::TaskScope arenaScope;
+        DOALLArgs->parallelizedLoop(DOALLArgs->env, DOALLArgs->coreID, DOALLArgs->numCores, DOALLArgs->chunkSize, DOALLArgs->schedule);
+      }
+      if (DOALLArgs->reductionTree != nullptr){
+        DOALLArgs->reductionTree->arrive(DOALLArgs->coreID);
+      }
+    }
+    runtime.setCoreBudget(previousCoreBudget);
+    if (RuntimeTelemetry::enabled){
+      DOALLArgs->endTime = RuntimeTelemetry::now();
+    }
+
+    return ;
+  }
+
+  static void NOELLE_DOALLTrampoline (void *args){
+
+    /*
+     * Fetch the arguments.
+     */
+    auto DOALLArgs = (DOALL_args_t *) args;
+    runtime.placeCurrentWorker();
+
+    /*
+     * Invoke
+     */
+    NOELLE_DOALL_runTask(DOALLArgs);
+
+    DOALLArgs->endLock.signal();
+    return ;
+  }
+
+  /*
+   * Trampoline used by the hot team, which notices the end of the tasks on its own (see HotTeam::join).
+   */
+  static void NOELLE_DOALLHotTeamTrampoline (void *args){
+    NOELLE_DOALL_runTask((DOALL_args_t *) args);
+
+    return ;
+  }
+
+  DOALLChunkInfo NOELLE_DOALL_claimChunk (
+    void *schedule
+    ){
+
+    /*
+     * Fetch the state shared among the threads of the current invocation.
+     */
+    auto doallSchedule = (DOALL_schedule_t *) schedule;
+
+    /*
+     * The objects allocated by the iterations of the previous chunk are dead.
+     */
+    iterationArenaOfCurrentThread.rewindToTheStartOfTheCurrentTask();
+
+    /*
+     * Compute the size of the chunk to claim.
+     *
+     * The guided scheduling shrinks the chunks as the remaining iterations run out.
+     * It never goes below the chunk size chosen by the compiler.
+     */
+    auto chunkSize = doallSchedule->chunkSize;
+    if (  true
+          && (doallSchedule->scheduling == DOALL_GUIDED_SCHEDULING)
+          && (doallSchedule->numberOfIterations > 0)
+       ){
+      auto iterationsAssigned = doallSchedule->nextIteration.load(std::memory_order_relaxed);
+      auto iterationsLeft = doallSchedule->numberOfIterations - iterationsAssigned;
+      auto guidedChunkSize = iterationsLeft / (2 * doallSchedule->numCores);
+      if (guidedChunkSize > chunkSize){
+        chunkSize = guidedChunkSize;
+      }
+    }
+
+    /*
+     * Claim the chunk.
+     *
+     * The task checks on its own whether the chunk starts after the last iteration of the loop.
+     */
+    DOALLChunkInfo chunk;
+    chunk.firstIteration = doallSchedule->nextIteration.fetch_add(chunkSize, std::memory_order_relaxed);
+    chunk.numberOfIterations = chunkSize;
+
+    /*
+     * Check if the chunk has been cancelled because an earlier iteration left the loop.
+     */
+    if (chunk.firstIteration > doallSchedule->firstExitingIteration.load(std::memory_order_relaxed)){
+      chunk.numberOfIterations = 0;
+    }
+
+    return chunk;
+  }
+
+  void NOELLE_DOALL_cancel (
+    void *schedule,
+    int64_t iteration,
+    int32_t exitBlockID,
+    int32_t *exitBlockTaken
+    ){
+
+    /*
+     * Fetch the state shared among the threads of the current invocation.
+     */
+    auto doallSchedule = (DOALL_schedule_t *) schedule;
+
+    /*
+     * Only the earliest iteration that leaves the loop decides the exit taken.
+     * The caller reads the exit taken after the join of the threads.
+     */
+    std::lock_guard<std::mutex> exitGuard(doallSchedule->exitLock);
+    if (iteration < doallSchedule->firstExitingIteration.load(std::memory_order_relaxed)){
+      doallSchedule->firstExitingIteration.store(iteration, std::memory_order_relaxed);
+      *exitBlockTaken = exitBlockID;
+    }
+
+    return ;
+  }
+
+  void * NOELLE_arena_malloc (
+    uint64_t bytes
+    ){
+    return iterationArenaOfCurrentThread.allocate(bytes);
+  }
+
+  void * NOELLE_arena_calloc (
+    uint64_t numberOfElements,
+    uint64_t elementBytes
+    ){
+    auto bytes = numberOfElements * elementBytes;
+    if (  true
+          && (elementBytes != 0)
+          && ((bytes / elementBytes) != numberOfElements)
+       ){
+      return nullptr;
+    }
+    auto object = iterationArenaOfCurrentThread.allocate(bytes);
+    if (object != nullptr){
+      memset(object, 0, bytes);
+    }
+
+    return object;
+  }
+
+  void NOELLE_arena_free (
+    void *object
+    ){
+    iterationArenaOfCurrentThread.free(object);
+
+    return ;
+  }
+
+  /*
+   * Run all iterations of a DOALL loop in the current thread (see LoopCostModel).
+   * The dispatcher has been invoked at "dispatchTime".
+   */
+  static DispatcherInfo NOELLE_DOALL_runInCurrentThread (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *), 
+    void *env, 
+    void (*combineReductions)(void *, int64_t, int64_t),
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize,
+    int64_t scheduling,
+    int64_t numberOfIterations,
+    int64_t loopID,
+    uint64_t dispatchTime
+    ){
+
+    /*
+     * Run the task.
+     *
+     * The deterministic scheduling runs all task instances, one after the other, and it combines their private copies the way the threads would.
+     */
+    DOALL_schedule_t doallSchedule;
+    doallSchedule.nextIteration.store(0, std::memory_order_relaxed);
+    doallSchedule.nextTaskInstance.store(0, std::memory_order_relaxed);
+    doallSchedule.firstExitingIteration.store(INT64_MAX, std::memory_order_relaxed);
+    doallSchedule.scheduling = scheduling;
+    doallSchedule.chunkSize = (chunkSize > 0) ? chunkSize : 1;
+    doallSchedule.numCores = 1;
+    doallSchedule.numberOfIterations = numberOfIterations;
+    doallSchedule.numberOfTaskInstances = 1;
+    if (scheduling == DOALL_DETERMINISTIC_SCHEDULING){
+      doallSchedule.numberOfTaskInstances = std::max<int64_t>(maxNumberOfCores, 1);
+      std::unique_ptr<ReductionTree> reductionTree;
+      if (combineReductions != nullptr){
+        reductionTree.reset(new ReductionTree(combineReductions, env, doallSchedule.numberOfTaskInstances));
+      }
+      NOELLE_DOALL_runTaskInstances(parallelizedLoop, env, chunkSize, &doallSchedule, reductionTree.get());
+
+    } else {
+      auto schedule = (scheduling == DOALL_STATIC_SCHEDULING) ? nullptr : &doallSchedule;
+      IterationArena::TaskScope arenaScope;
+      parallelizedLoop(env, 0, 1, chunkSize, schedule);
+    }
+    auto endTime = RuntimeTelemetry::now();
+
+    /*
+     * Learn from the invocation.
+     */
+    runtime.loopCostModel.learn(loopID, numberOfIterations, 1, endTime - dispatchTime, endTime - dispatchTime);
+    if (RuntimeTelemetry::enabled){
+      RuntimeTelemetry::InvocationRecord telemetry;
+      telemetry.loopID = loopID;
+      telemetry.technique = "DOALL";
+      telemetry.dispatchTime = dispatchTime;
+      telemetry.forkTime = dispatchTime;
+      telemetry.joinedTime = endTime;
+      telemetry.taskStartTimes.push_back(dispatchTime);
+      telemetry.taskEndTimes.push_back(endTime);
+      runtime.telemetry.record(telemetry);
+    }
+
+    DispatcherInfo dispatcherInfo;
+    dispatcherInfo.numberOfThreadsUsed = doallSchedule.numberOfTaskInstances;
+    return dispatcherInfo;
+  }
+
+  /*
+   * Fork the threads of an invocation of a DOALL loop that uses "threadsToUse" threads.
+   *
+   * If "isAsynchronous" is false, the caller runs the last task instance between the fork and the join, and it needs to set "callerStartTime" and "callerEndTime" of the invocation.
+   * Otherwise, all task instances run in threads of the runtime.
+   */
+  static void NOELLE_DOALL_forkTasks (
+    DOALLInvocation *invocation,
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *), 
+    void *env, 
+    void (*combineReductions)(void *, int64_t, int64_t),
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize,
+    int64_t scheduling,
+    uint32_t threadsToUse,
+    bool isAsynchronous
+    ){
+
+    /*
+     * Reserve the cores.
+     */
+    invocation->reservedCores = runtime.reserveCores(threadsToUse, &invocation->coresFromBudget);
+
+    /*
+     * Set the number of threads to use.
+     *
+     * There is no point in having more threads than chunks of iterations.
+     * The reserved cores that do not get a thread are given to the threads we create so the parallelized loops they invoke can use them.
+     */
+    int64_t numCores = invocation->reservedCores;
+    auto chunkSizeToClaim = (chunkSize > 0) ? chunkSize : 1;
+    if (invocation->numberOfIterations > 0){
+      auto numberOfChunks = (invocation->numberOfIterations + chunkSizeToClaim - 1) / chunkSizeToClaim;
+      if (numberOfChunks < numCores){
+        numCores = numberOfChunks;
+      }
+    }
+    invocation->numCores = numCores;
+    auto coreBudgetPerThread = invocation->reservedCores / numCores;
+    auto coresLeftOver = invocation->reservedCores % numCores;
+    invocation->callerCoreBudget = coreBudgetPerThread + (((numCores - 1) < coresLeftOver) ? 1 : 0);
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Starting dispatcher: num cores " << numCores << " (" << invocation->reservedCores << " reserved), chunk size: " << chunkSize << ", scheduling: " << scheduling << std::endl;
+    #endif
+
+    /*
+     * Allocate the memory to store the arguments.
+     */
+    invocation->numberOfTasks = isAsynchronous ? numCores : (numCores - 1);
+    invocation->argsForAllCores = runtime.getDOALLArgs(invocation->numberOfTasks, &invocation->doallMemoryIndex);
+    auto argsForAllCores = invocation->argsForAllCores;
+
+    /*
+     * Prepare the state shared among the threads to claim chunks dynamically.
+     */
+    auto &doallSchedule = invocation->doallSchedule;
+    doallSchedule.nextIteration.store(0, std::memory_order_relaxed);
+    doallSchedule.nextTaskInstance.store(0, std::memory_order_relaxed);
+    doallSchedule.firstExitingIteration.store(INT64_MAX, std::memory_order_relaxed);
+    doallSchedule.scheduling = scheduling;
+    doallSchedule.chunkSize = chunkSizeToClaim;
+    doallSchedule.numCores = numCores;
+    doallSchedule.numberOfIterations = invocation->numberOfIterations;
+    doallSchedule.numberOfTaskInstances = numCores;
+    if (scheduling == DOALL_DETERMINISTIC_SCHEDULING){
+      doallSchedule.numberOfTaskInstances = std::max<int64_t>(maxNumberOfCores, numCores);
+    }
+    invocation->schedule = (scheduling == DOALL_STATIC_SCHEDULING) ? nullptr : &doallSchedule;
+
+    /*
+     * Prepare the combination of the private copies of reduced live-out variables.
+     */
+    if (combineReductions != nullptr){
+      invocation->reductionTree.reset(new ReductionTree(combineReductions, env, doallSchedule.numberOfTaskInstances));
+    }
+
+    /*
+     * Prepare the arguments of the DOALL tasks.
+     */
+    for (auto i = 0; i < invocation->numberOfTasks; ++i) {
+      auto argsPerCore = &argsForAllCores[i];
+      argsPerCore->parallelizedLoop = parallelizedLoop;
+      argsPerCore->env = env;
+      argsPerCore->numCores = numCores;
+      argsPerCore->chunkSize = chunkSize;
+      argsPerCore->schedule = invocation->schedule;
+      argsPerCore->reductionTree = invocation->reductionTree.get();
+      argsPerCore->coreBudget = coreBudgetPerThread + ((i < coresLeftOver) ? 1 : 0);
+    }
+
+    /*
+     * Submit DOALL tasks.
+     *
+     * The hot team runs them if it is enabled and it is not running another loop (e.g., the one this loop is nested in).
+     * Otherwise, they are submitted to the thread pool one by one.
+     */
+    if (RuntimeTelemetry::enabled){
+      invocation->telemetry.forkTime = RuntimeTelemetry::now();
+    }
+    invocation->isRunByHotTeam = true
+      && (runtime.hotTeam != nullptr)
+      && runtime.hotTeam->tryToStart(NOELLE_DOALLHotTeamTrampoline, argsForAllCores, sizeof(DOALL_args_t), invocation->numberOfTasks);
+    for (auto i = 0; (!invocation->isRunByHotTeam) && (i < invocation->numberOfTasks); ++i) {
+      runtime.submitAndDetach(NOELLE_DOALLTrampoline, &argsForAllCores[i], i);
+      #ifdef RUNTIME_PRINT
+      std::cerr << "Submitted DOALL task on core " << i << std::endl;
+      #endif
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Submitted pool" << std::endl;
+    #endif
+
+    return ;
+  }
+
+  /*
+   * Wait for the threads forked by NOELLE_DOALL_forkTasks, and free the resources of the invocation.
+   */
+  static void NOELLE_DOALL_joinTasks (
+    DOALLInvocation *invocation
+    ){
+
+    /*
+     * Wait for the DOALL tasks.
+     */
+    if (invocation->isRunByHotTeam){
+      runtime.hotTeam->join();
+
+    } else {
+      for (auto i = 0; i < invocation->numberOfTasks; ++i) {
+        runtime.waitForTask(invocation->argsForAllCores[i].endLock);
+      }
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "All tasks completed" << std::endl;
+    #endif
+
+    /*
+     * Learn from the invocation and record it.
+     *
+     * Asynchronous invocations do not teach anything to the cost model as the invoking thread runs code that does not belong to the loop while the tasks run.
+     */
+    auto &telemetry = invocation->telemetry;
+    if (invocation->isTimed){
+      telemetry.joinedTime = RuntimeTelemetry::now();
+      if (!invocation->isAsynchronous){
+        runtime.loopCostModel.learn(invocation->loopID, invocation->numberOfIterations, invocation->numCores, invocation->callerEndTime - invocation->callerStartTime, telemetry.joinedTime - telemetry.dispatchTime);
+      }
+    }
+    if (RuntimeTelemetry::enabled){
+      telemetry.loopID = invocation->loopID;
+      telemetry.technique = "DOALL";
+      for (auto i = 0; i < invocation->numberOfTasks; ++i) {
+        telemetry.taskStartTimes.push_back(invocation->argsForAllCores[i].startTime);
+        telemetry.taskEndTimes.push_back(invocation->argsForAllCores[i].endTime);
+      }
+      if (!invocation->isAsynchronous){
+        telemetry.taskStartTimes.push_back(invocation->callerStartTime);
+        telemetry.taskEndTimes.push_back(invocation->callerEndTime);
+      }
+      runtime.telemetry.record(telemetry);
+    }
+
+    /*
+     * Free the cores and memory.
+     */
+    runtime.releaseCores(invocation->reservedCores, invocation->coresFromBudget);
+    runtime.releaseDOALLArgs(invocation->doallMemoryIndex);
+
+    return ;
+  }
+
+  DispatcherInfo NOELLE_DOALLDispatcher (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *), 
+    void *env, 
+    void (*combineReductions)(void *, int64_t, int64_t),
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize,
+    int64_t scheduling,
+    int64_t numberOfIterations,
+    int64_t loopID
+    ){
+    DOALLInvocation invocation;
+    invocation.isTimed = RuntimeTelemetry::enabled || LoopCostModel::enabled;
+    if (invocation.isTimed){
+      invocation.telemetry.dispatchTime = RuntimeTelemetry::now();
+    }
+    invocation.loopID = loopID;
+    invocation.numberOfIterations = numberOfIterations;
+    invocation.isAsynchronous = false;
+
+    /*
+     * Choose the number of threads.
+     * Invocations that are not worth forking run in the current thread.
+     */
+    auto threadsToUse = runtime.loopCostModel.chooseNumberOfThreads(loopID, numberOfIterations, maxNumberOfCores);
+    if (threadsToUse == 1){
+      return NOELLE_DOALL_runInCurrentThread(parallelizedLoop, env, combineReductions, maxNumberOfCores, chunkSize, scheduling, numberOfIterations, loopID, invocation.telemetry.dispatchTime);
+    }
+
+    /*
+     * Fork the threads.
+     */
+    NOELLE_DOALL_forkTasks(&invocation, parallelizedLoop, env, combineReductions, maxNumberOfCores, chunkSize, scheduling, threadsToUse, false);
+    auto numCores = invocation.numCores;
+    auto schedule = invocation.schedule;
+    auto reductionTree = invocation.reductionTree.get();
+
+    /*
+     * Run a task.
+     */
+    if (invocation.isTimed){
+      invocation.callerStartTime = RuntimeTelemetry::now();
+    }
+    auto previousCoreBudget = runtime.getCoreBudget();
+    runtime.setCoreBudget(invocation.callerCoreBudget);
+    if (scheduling == DOALL_DETERMINISTIC_SCHEDULING){
+      NOELLE_DOALL_runTaskInstances(parallelizedLoop, env, chunkSize, schedule, reductionTree);
+
+    } else {
+      {
+        IterationArena::TaskScope arenaScope;
+        parallelizedLoop(env, numCores - 1, numCores, chunkSize, schedule);
+      }
+      if (reductionTree != nullptr){
+        reductionTree->arrive(numCores - 1);
+      }
+    }
+    runtime.setCoreBudget(previousCoreBudget);
+    if (invocation.isTimed){
+      invocation.callerEndTime = RuntimeTelemetry::now();
+    }
+
+    /*
+     * Wait for the remaining DOALL tasks.
+     */
+    NOELLE_DOALL_joinTasks(&invocation);
+
+    /*
+     * Prepare the return value.
+     */
+    DispatcherInfo dispatcherInfo;
+    dispatcherInfo.numberOfThreadsUsed = invocation.doallSchedule.numberOfTaskInstances;
+
+    return dispatcherInfo;
+  }
+
+  void * NOELLE_DOALLDispatcherAsync (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *), 
+    void *env, 
+    void (*combineReductions)(void *, int64_t, int64_t),
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize,
+    int64_t scheduling,
+    int64_t numberOfIterations,
+    int64_t loopID
+    ){
+    void *invocationMemory = nullptr;
+    if (posix_memalign(&invocationMemory, CACHE_LINE_SIZE, sizeof(DOALLInvocation)) != 0){
+      fprintf(stderr, "NOELLE: Runtime: ERROR = not enough memory to allocate an asynchronous DOALL invocation\n");
+      abort();
+    }
+    auto invocation = new (invocationMemory) DOALLInvocation();
+    invocation->isTimed = RuntimeTelemetry::enabled;
+    if (invocation->isTimed){
+      invocation->telemetry.dispatchTime = RuntimeTelemetry::now();
+    }
+    invocation->loopID = loopID;
+    invocation->numberOfIterations = numberOfIterations;
+    invocation->isAsynchronous = true;
+
+    /*
+     * Choose the number of threads.
+     * Invocations that are not worth forking run in the current thread right away.
+     */
+    auto threadsToUse = runtime.loopCostModel.chooseNumberOfThreads(loopID, numberOfIterations, maxNumberOfCores);
+    if (threadsToUse == 1){
+      NOELLE_DOALL_runInCurrentThread(parallelizedLoop, env, combineReductions, maxNumberOfCores, chunkSize, scheduling, numberOfIterations, loopID, invocation->telemetry.dispatchTime);
+      invocation->~DOALLInvocation();
+      free(invocation);
+      return nullptr;
+    }
+
+    /*
+     * Fork the threads.
+     */
+    NOELLE_DOALL_forkTasks(invocation, parallelizedLoop, env, combineReductions, maxNumberOfCores, chunkSize, scheduling, threadsToUse, true);
+
+    return invocation;
+  }
+
+  void NOELLE_DOALL_join (
+    void *invocation
+    ){
+    if (invocation == nullptr){
+      return ;
+    }
+    auto doallInvocation = (DOALLInvocation *)invocation;
+    NOELLE_DOALL_joinTasks(doallInvocation);
+    doallInvocation->~DOALLInvocation();
+    free(doallInvocation);
+
+    return ;
+  }
+
+  #ifdef RUNTIME_PRINT
+  void *mySSGlobal = nullptr;
+  #endif
+
+
+  /**********************************************************************
+   *                HELIX
+   **********************************************************************/
+  typedef struct {
+    void (*parallelizedLoop)(void *, void *, void *, int64_t, int64_t, uint64_t *);
+    void *env ;
+    void *loopCarriedArray;
+    int64_t loopCarriedArrayBytes;
+    void *ssArray;
+    uint64_t coreID;
+    uint64_t numCores;
+    uint64_t *loopIsOverFlag;
+    int64_t numOfsequentialSegments;
+    uint64_t *ssWaitTimes;
+    ReductionTree *reductionTree;
+    uint64_t startTime;
+    uint64_t endTime;
+    AdaptiveSemaphore endLock;
+  } NOELLE_HELIX_args_t ;
+
+  /*
+   * Sequential segments the current thread waits on and where to add the time it waits on each of them (see HELIX_wait).
+   * This is used only by the telemetry.
+   */
+  typedef struct {
+    void *ssArray;
+    int64_t numOfsequentialSegments;
+    uint64_t *waitTimes;
+  } NOELLE_HELIX_telemetry_t ;
+
+  static thread_local NOELLE_HELIX_telemetry_t HELIX_telemetryOfCurrentThread = {nullptr, 0, nullptr};
+
+  static void NOELLE_HELIX_invokeTask (NOELLE_HELIX_args_t *HELIX_args){
+
+    /*
+     * Invoke the task.
+     */
+    if (!RuntimeTelemetry::enabled){
+      HELIX_args->parallelizedLoop(
+        HELIX_args->env, 
+        HELIX_args->loopCarriedArray, 
+        HELIX_args->ssArray, 
+        HELIX_args->coreID,
+        HELIX_args->numCores,
+        HELIX_args->loopIsOverFlag
+        );
+      return ;
+    }
+
+    /*
+     * Invoke the task keeping track of the time it waits on sequential segments.
+     *
+     * The telemetry of an outer HELIX loop run by the current thread is restored when the task returns.
+     */
+    auto outerTelemetry = HELIX_telemetryOfCurrentThread;
+    HELIX_telemetryOfCurrentThread.ssArray = HELIX_args->ssArray;
+    HELIX_telemetryOfCurrentThread.numOfsequentialSegments = HELIX_args->numOfsequentialSegments;
+    HELIX_telemetryOfCurrentThread.waitTimes = HELIX_args->ssWaitTimes;
+    HELIX_args->startTime = RuntimeTelemetry::now();
+    HELIX_args->parallelizedLoop(
+      HELIX_args->env, 
+      HELIX_args->loopCarriedArray, 
+      HELIX_args->ssArray, 
+      HELIX_args->coreID,
+      HELIX_args->numCores,
+      HELIX_args->loopIsOverFlag
+      );
+    HELIX_args->endTime = RuntimeTelemetry::now();
+    HELIX_telemetryOfCurrentThread = outerTelemetry;
+
+    return ;
+  }
+
+  static void NOELLE_HELIX_runTask (NOELLE_HELIX_args_t *HELIX_args){
+
+    /*
+     * Check if the task can have a helper thread (see HELIXHelperThread).
+     * A task that runs alone does not exchange cache lines with other tasks.
+     */
+    HELIXHelperThread *helper = nullptr;
+    if (HELIX_args->numCores > 1){
+      helper = runtime.getHELIXHelperOfCurrentThread(HELIX_args->numCores);
+    }
+    if (  true
+          && (helper != nullptr)
+          && (!helper->tryToStart((HELIXSequentialSegment *)HELIX_args->ssArray, HELIX_args->numOfsequentialSegments, HELIX_args->loopCarriedArray, HELIX_args->loopCarriedArrayBytes, HELIX_args->coreID, HELIX_args->numCores))
+       ){
+      helper = nullptr;
+    }
+
+    /*
+     * Run the task.
+     */
+    NOELLE_HELIX_invokeTask(HELIX_args);
+
+    /*
+     * Stop the helper.
+     */
+    if (helper != nullptr){
+      helper->stop();
+    }
+
+    return ;
+  }
+
+  static void NOELLE_HELIXTrampoline (void *args){
+
+    /*
+     * Fetch the arguments.
+     */
+    auto HELIX_args = (NOELLE_HELIX_args_t *) args;
+    runtime.placeCurrentWorker();
+
+    /*
+     * Invoke
+     */
+    NOELLE_HELIX_runTask(HELIX_args);
+    if (HELIX_args->reductionTree != nullptr){
+      HELIX_args->reductionTree->arrive(HELIX_args->coreID);
+    }
+
+    HELIX_args->endLock.signal();
+    return ;
+  }
+
+  /*
+   * Prefetch the cache lines a HELIX task needs next (see HELIXHelperThread).
+   *
+   * The task runs the iterations with tickets firstTicket, firstTicket + ticketStep, and so on.
+   * For each of them, we wait for the previous iterations to leave each sequential segment and then we fetch its cache line.
+   * Once the previous iterations have left all sequential segments, they have also stored the spilled loop-carried values the task loads next.
+   *
+   * Lines are fetched with the intent to write them: other cores cannot write them until the task signals the current ticket.
+   */
+  static void HELIX_helperThread (
+    HELIXSequentialSegment *ssArray,
+    int64_t numOfsequentialSegments,
+    void *loopCarriedArray,
+    int64_t loopCarriedArrayBytes,
+    int64_t firstTicket,
+    int64_t ticketStep,
+    std::atomic<bool> *isStopRequested
+    ){
+
+    auto ticket = firstTicket;
+    while (!isStopRequested->load(std::memory_order_relaxed)){
+
+      /*
+       * Prefetch the cache lines of the sequential segments of the current ticket.
+       */
+      for (auto i = 0 ; i < numOfsequentialSegments; i++){
+        auto ss = &ssArray[i];
+        while (!ss->canEnter(ticket)){
+          if (isStopRequested->load(std::memory_order_relaxed)){
+            return ;
+          }
+          cpu_relax();
+        }
+        __builtin_prefetch(ss, 1, 3);
+      }
+
+      /*
+       * Prefetch the spilled loop-carried values.
+       */
+      for (auto offset = 0; offset < loopCarriedArrayBytes; offset += CACHE_LINE_SIZE){
+        __builtin_prefetch(((uint8_t *)loopCarriedArray) + offset, 1, 3);
+      }
+
+      /*
+       * Move to the next ticket of the task.
+       */
+      ticket += ticketStep;
+    }
+
+    return ;
+  }
+
+  static DispatcherInfo NOELLE_HELIX_dispatcher (
+    void (*parallelizedLoop)(void *, void *, void *, int64_t, int64_t, uint64_t *), 
+    void *env,
+    void (*combineReductions)(void *, int64_t, int64_t),
+    void *loopCarriedArray,
+    int64_t loopCarriedArrayBytes,
+    int64_t maxNumberOfCores, 
+    int64_t numOfsequentialSegments,
+    int64_t numberOfIterations,
+    int64_t loopID
+    ){
+    RuntimeTelemetry::InvocationRecord telemetry;
+    auto isTimed = RuntimeTelemetry::enabled || LoopCostModel::enabled;
+    if (isTimed){
+      telemetry.dispatchTime = RuntimeTelemetry::now();
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "HELIX: dispatcher: Start" << std::endl;
+    std::cerr << "HELIX: dispatcher:  Number of sequential segments = " << numOfsequentialSegments << std::endl;
+    std::cerr << "HELIX: dispatcher:  Number of cores = " << numCores << std::endl;
+    #endif
+
+    /*
+     * Assumptions.
+     */
+    assert(parallelizedLoop != NULL);
+    assert(env != NULL);
+    assert(maxNumberOfCores > 1);
+
+    /*
+     * Choose the number of threads and reserve the cores.
+     * Invocations that are not worth forking run in the current thread.
+     */
+    auto threadsToUse = runtime.loopCostModel.chooseNumberOfThreads(loopID, numberOfIterations, maxNumberOfCores);
+    bool coresFromBudget = false;
+    uint32_t numCores = 1;
+    if (threadsToUse > 1){
+      numCores = runtime.reserveCores(threadsToUse, &coresFromBudget);
+    }
+    assert(numCores >= 1);
+
+    /*
+     * Fetch the sequential segments.
+     * All cores share them: the ticket of an iteration tells a core when it can enter a sequential segment.
+     */
+    uint64_t ssArrayCapacity = 0;
+    HELIXSequentialSegment *ssArray = nullptr;
+    if (numOfsequentialSegments > 0){
+      ssArray = runtime.getHELIXSequentialSegments(numOfsequentialSegments, &ssArrayCapacity);
+    }
+
+    #ifdef RUNTIME_PRINT
+    mySSGlobal = ssArray;
+    #endif
+
+    /*
+     * Allocate the arguments for the cores.
+     * The last ones are for the task run by the dispatcher.
+     */
+    NOELLE_HELIX_args_t *argsForAllCores;
+    posix_memalign((void **)&argsForAllCores, CACHE_LINE_SIZE, sizeof(NOELLE_HELIX_args_t) * numCores);
+
+    /*
+     * Allocate the wait times of the sequential segments of the telemetry.
+     * Each core has its own.
+     */
+    std::vector<uint64_t> ssWaitTimes;
+    if (RuntimeTelemetry::enabled){
+      ssWaitTimes.resize(numCores * numOfsequentialSegments, 0);
+    }
+
+    /*
+     * Prepare the combination of the private copies of reduced live-out variables.
+     */
+    std::unique_ptr<ReductionTree> reductionTree;
+    if (combineReductions != nullptr){
+      reductionTree.reset(new ReductionTree(combineReductions, env, numCores));
+    }
+
+    /*
+     * Launch threads
+     */
+    if (RuntimeTelemetry::enabled){
+      telemetry.forkTime = RuntimeTelemetry::now();
+    }
+    uint64_t loopIsOverFlag = 0;
+    for (auto i = 0; i < (numCores - 1); ++i) {
+      #ifdef RUNTIME_PRINT
+      fprintf(stderr, "HelixDispatcher: Creating future for core %d\n", i);
+      #endif
+
+      /*
+       * Prepare the arguments.
+       */
+      auto argsPerCore = &argsForAllCores[i];
+      argsPerCore->parallelizedLoop = parallelizedLoop;
+      argsPerCore->env = env;
+      argsPerCore->loopCarriedArray = loopCarriedArray;
+      argsPerCore->loopCarriedArrayBytes = loopCarriedArrayBytes;
+      argsPerCore->ssArray = ssArray;
+      argsPerCore->coreID = i;
+      argsPerCore->numCores = numCores;
+      argsPerCore->loopIsOverFlag = &loopIsOverFlag;
+      argsPerCore->numOfsequentialSegments = numOfsequentialSegments;
+      argsPerCore->ssWaitTimes = RuntimeTelemetry::enabled ? (ssWaitTimes.data() + (i * numOfsequentialSegments)) : nullptr;
+      argsPerCore->reductionTree = reductionTree.get();
+      argsPerCore->endLock.initialize(false);
+
+      /*
+       * Launch the thread.
+       *
+       * Consecutive cores exchange sequential segments.
+       * Hence, they run on workers that are placed close to each other.
+       */
+      runtime.submitAndDetach(NOELLE_HELIXTrampoline, argsPerCore, i);
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Submitted pool\n";
+    int futureGotten = 0;
+    #endif
+
+    /*
+     * Run a task.
+     */
+    auto argsOfDispatcher = &argsForAllCores[numCores - 1];
+    argsOfDispatcher->parallelizedLoop = parallelizedLoop;
+    argsOfDispatcher->env = env;
+    argsOfDispatcher->loopCarriedArray = loopCarriedArray;
+    argsOfDispatcher->loopCarriedArrayBytes = loopCarriedArrayBytes;
+    argsOfDispatcher->ssArray = ssArray;
+    argsOfDispatcher->coreID = numCores - 1;
+    argsOfDispatcher->numCores = numCores;
+    argsOfDispatcher->loopIsOverFlag = &loopIsOverFlag;
+    argsOfDispatcher->numOfsequentialSegments = numOfsequentialSegments;
+    argsOfDispatcher->ssWaitTimes = RuntimeTelemetry::enabled ? (ssWaitTimes.data() + ((numCores - 1) * numOfsequentialSegments)) : nullptr;
+    argsOfDispatcher->reductionTree = reductionTree.get();
+    uint64_t startTime = 0;
+    if (isTimed){
+      startTime = RuntimeTelemetry::now();
+    }
+    NOELLE_HELIX_runTask(argsOfDispatcher);
+    if (reductionTree != nullptr){
+      reductionTree->arrive(numCores - 1);
+    }
+    uint64_t endTime = 0;
+    if (isTimed){
+      endTime = RuntimeTelemetry::now();
+    }
+
+    /*
+     * Wait for the remaining HELIX tasks.
+     */
+    for (auto i = 0; i < (numCores - 1); ++i) {
+      runtime.waitForTask(argsForAllCores[i].endLock);
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Got all futures\n";
+    #endif
+
+    /*
+     * Learn from the invocation and record it.
+     */
+    if (isTimed){
+      telemetry.joinedTime = RuntimeTelemetry::now();
+      runtime.loopCostModel.learn(loopID, numberOfIterations, numCores, endTime - startTime, telemetry.joinedTime - telemetry.dispatchTime);
+    }
+    if (RuntimeTelemetry::enabled){
+      telemetry.loopID = loopID;
+      telemetry.technique = "HELIX";
+      telemetry.sequentialSegmentWaitTimes.resize(numOfsequentialSegments, 0);
+      for (uint32_t i = 0; i < numCores; ++i) {
+        telemetry.taskStartTimes.push_back(argsForAllCores[i].startTime);
+        telemetry.taskEndTimes.push_back(argsForAllCores[i].endTime);
+        for (auto ssID = 0; ssID < numOfsequentialSegments; ssID++){
+          telemetry.sequentialSegmentWaitTimes[ssID] += ssWaitTimes[i * numOfsequentialSegments + ssID];
+        }
+      }
+      runtime.telemetry.record(telemetry);
+    }
+
+    /*
+     * Free the cores and memory.
+     */
+    if (threadsToUse > 1){
+      runtime.releaseCores(numCores, coresFromBudget);
+    }
+
+    /*
+     * Free the memory.
+     */
+    free(argsForAllCores);
+    if (ssArray != nullptr){
+      runtime.releaseHELIXSequentialSegments(ssArray, ssArrayCapacity);
+    }
+
+    DispatcherInfo dispatcherInfo;
+    dispatcherInfo.numberOfThreadsUsed = numCores;
+    return dispatcherInfo;
+  }
+
+  /*
+   * Dispatch threads to run a HELIX loop.
+   * "combineReductions" is as for NOELLE_DOALLDispatcher.
+   * "loopCarriedArrayBytes" is the size of the array of spilled loop-carried values (see HELIX_helperThread).
+   */
+  DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegments (
+    void (*parallelizedLoop)(void *, void *, void *, int64_t, int64_t, uint64_t *), 
+    void *env,
+    void (*combineReductions)(void *, int64_t, int64_t),
+    void *loopCarriedArray,
+    int64_t loopCarriedArrayBytes,
+    int64_t numCores, 
+    int64_t numOfsequentialSegments,
+    int64_t numberOfIterations,
+    int64_t loopID
+    ){
+    return NOELLE_HELIX_dispatcher(parallelizedLoop, env, combineReductions, loopCarriedArray, loopCarriedArrayBytes, numCores, numOfsequentialSegments, numberOfIterations, loopID);
+  }
+
+  DispatcherInfo NOELLE_HELIX_dispatcher_criticalSections (
+    void (*parallelizedLoop)(void *, void *, void *, int64_t, int64_t, uint64_t *), 
+    void *env,
+    void (*combineReductions)(void *, int64_t, int64_t),
+    void *loopCarriedArray,
+    int64_t loopCarriedArrayBytes,
+    int64_t numCores, 
+    int64_t numOfsequentialSegments,
+    int64_t numberOfIterations,
+    int64_t loopID
+    ){
+    /*
+     * Sequential segments entered in the order of the iterations are also entered by one core at a time.
+     * Hence, critical sections are sequential segments.
+     */
+    return NOELLE_HELIX_dispatcher(parallelizedLoop, env, combineReductions, loopCarriedArray, loopCarriedArrayBytes, numCores, numOfsequentialSegments, numberOfIterations, loopID);
+  }
+
+  void HELIX_wait (
+    void *sequentialSegment,
+    int64_t ticket
+    ){
+
+    /*
+     * Fetch the sequential segment.
+     */
+    auto ss = (HELIXSequentialSegment *) sequentialSegment;
+
+    #ifdef RUNTIME_PRINT
+    assert(ss != NULL);
+    fprintf(stderr, "HelixDispatcher: Waiting on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
+    #endif
+
+    /*
+     * Wait
+     */
+    if (  false
+          || (!RuntimeTelemetry::enabled)
+          || (HELIX_telemetryOfCurrentThread.waitTimes == nullptr)
+       ){
+      ss->wait(ticket);
+
+    } else {
+      auto startTime = RuntimeTelemetry::now();
+      ss->wait(ticket);
+      auto ssID = ((int64_t)sequentialSegment - (int64_t)HELIX_telemetryOfCurrentThread.ssArray) / CACHE_LINE_SIZE;
+      if (  true
+            && (ssID >= 0)
+            && (ssID < HELIX_telemetryOfCurrentThread.numOfsequentialSegments)
+         ){
+        HELIX_telemetryOfCurrentThread.waitTimes[ssID] += RuntimeTelemetry::now() - startTime;
+      }
+    }
+
+    #ifdef RUNTIME_PRINT
+    fprintf(stderr, "HelixDispatcher: Waited on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
+    #endif
+
+    return ;
+  }
+
+  void HELIX_signal (
+    void *sequentialSegment,
+    int64_t ticket
+    ){
+
+    /*
+     * Fetch the sequential segment.
+     */
+    auto ss = (HELIXSequentialSegment *) sequentialSegment;
+
+    #ifdef RUNTIME_PRINT
+    assert(ss != NULL);
+    fprintf(stderr, "HelixDispatcher: Signaling on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
+    #endif
+
+    /*
+     * Signal
+     */
+    ss->signal(ticket);
+
+    #ifdef RUNTIME_PRINT
+    fprintf(stderr, "HelixDispatcher: Signaled on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
+    #endif
+
+    return ;
+  }
+
+
+  /**********************************************************************
+   *                DSWP
+   **********************************************************************/
+  typedef struct {
+    stageFunctionPtr_t funcToInvoke;
+    void *env;
+    void *localQueues;
+    uint64_t startTime;
+    uint64_t endTime;
+    AdaptiveSemaphore endLock;
+  } NOELLE_DSWP_args_t ;
+
+  void stageExecuter(void (*stage)(void *, void *), void *env, void *queues){ 
+    return stage(env, queues);
+  }
+
+  static void NOELLE_DSWPTrampoline (void *args){
+
+    /*
+     * Fetch the arguments.
+     */
+    auto DSWPArgs = (NOELLE_DSWP_args_t *) args;
+    runtime.placeCurrentWorker();
+
+    /*
+     * Invoke
+     */
+    if (RuntimeTelemetry::enabled){
+      DSWPArgs->startTime = RuntimeTelemetry::now();
+    }
+    DSWPArgs->funcToInvoke(DSWPArgs->env, DSWPArgs->localQueues);
+    DSWPQueue::forgetQueuesOfCurrentThread();
+    if (RuntimeTelemetry::enabled){
+      DSWPArgs->endTime = RuntimeTelemetry::now();
+    }
+
+    DSWPArgs->endLock.signal();
+    return ;
+  }
+
+  /*
+   * A stage can be replicated (see @stageReplicas) if it has no loop-carried dependence.
+   * Replica r of a stage with R replicas runs the iterations i such that i % R == r.
+   * Hence, a queue (i.e., @queueSizes) that connects a replicated stage to a not-replicated one is implemented by R runtime queues (one per replica).
+   * @queueReplicatedStages specifies, for each queue, the replicated stage it is connected to (-1 if none).
+   *
+   * Every stage instance receives an array with a pointer per runtime queue where the runtime queues of a queue are consecutive.
+   * Replica r of a stage finds its own runtime queue in the first position of the group of a queue.
+   * A not-replicated stage finds the runtime queue of replica r in the position r of the group.
+   */
+  static DispatcherInfo NOELLE_DSWP_dispatcher (
+    void *env, 
+    int64_t *queueSizes, 
+    int64_t *queueReplicatedStages,
+    void *stages, 
+    int64_t *stageReplicas,
+    int64_t numberOfStages, 
+    int64_t numberOfQueues,
+    bool batchedQueues,
+    int64_t loopID
+    ){
+    RuntimeTelemetry::InvocationRecord telemetry;
+    if (RuntimeTelemetry::enabled){
+      telemetry.dispatchTime = RuntimeTelemetry::now();
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Starting dispatcher: num stages " << numberOfStages << ", num queues: " << numberOfQueues << std::endl;
+    #endif
+
+    /*
+     * Compute the number of stage instances.
+     */
+    int64_t numberOfInstances = 0;
+    for (auto i = 0; i < numberOfStages; ++i) {
+      assert(stageReplicas[i] >= 1);
+      numberOfInstances += stageReplicas[i];
+    }
+
+    /*
+     * Reserve the cores.
+     */
+    bool coresFromBudget;
+    auto numCores = runtime.reserveCores(numberOfInstances, &coresFromBudget);
+    assert(numCores >= 1);
+
+    /*
+     * Compute the position of the runtime queues of each queue.
+     */
+    int64_t firstRuntimeQueue[numberOfQueues];
+    int64_t numberOfRuntimeQueues = 0;
+    for (auto i = 0; i < numberOfQueues; ++i) {
+      firstRuntimeQueue[i] = numberOfRuntimeQueues;
+      numberOfRuntimeQueues += (queueReplicatedStages[i] >= 0) ? stageReplicas[queueReplicatedStages[i]] : 1;
+    }
+
+    /*
+     * Allocate the communication queues.
+     */
+    void *localQueues[numberOfRuntimeQueues];
+    for (auto i = 0; i < numberOfQueues; ++i) {
+      if (queueSizes[i] <= 0){
+        std::cerr << "NOELLE: Runtime: QUEUE SIZE INCORRECT" << std::endl;
+        abort();
+      }
+      auto valueBytes = (queueSizes[i] + 7) / 8;
+      auto runtimeQueues = (queueReplicatedStages[i] >= 0) ? stageReplicas[queueReplicatedStages[i]] : 1;
+      for (auto j = 0; j < runtimeQueues; ++j){
+        localQueues[firstRuntimeQueue[i] + j] = runtime.getDSWPQueue(valueBytes, batchedQueues);
+      }
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Made queues" << std::endl;
+    #endif
+
+    /*
+     * Allocate the memory to store the arguments and the queues seen by each stage instance.
+     */
+    auto argsForAllCores = (NOELLE_DSWP_args_t *) malloc(sizeof(NOELLE_DSWP_args_t) * numberOfInstances);
+    auto queuesForAllCores = (void **) malloc(sizeof(void *) * numberOfRuntimeQueues * numberOfInstances);
+
+    /*
+     * Submit DSWP tasks
+     */
+    if (RuntimeTelemetry::enabled){
+      telemetry.forkTime = RuntimeTelemetry::now();
+    }
+    auto allStages = (void **)stages;
+    auto instance = 0;
+    for (auto i = 0; i < numberOfStages; ++i) {
+      for (auto r = 0; r < stageReplicas[i]; ++r, ++instance) {
+
+        /*
+         * Compose the queues of the current stage instance.
+         */
+        auto queuesPerCore = &queuesForAllCores[numberOfRuntimeQueues * instance];
+        for (auto q = 0; q < numberOfQueues; ++q) {
+          auto runtimeQueues = (queueReplicatedStages[q] >= 0) ? stageReplicas[queueReplicatedStages[q]] : 1;
+          for (auto j = 0; j < runtimeQueues; ++j){
+            auto runtimeQueue = (queueReplicatedStages[q] == i) ? r : j;
+            queuesPerCore[firstRuntimeQueue[q] + j] = localQueues[firstRuntimeQueue[q] + runtimeQueue];
+          }
+        }
+
+        /*
+         * Prepare the arguments.
+         */
+        auto argsPerCore = &argsForAllCores[instance];
+        argsPerCore->funcToInvoke = reinterpret_cast<stageFunctionPtr_t>(reinterpret_cast<long long>(allStages[i]));
+        argsPerCore->env = env;
+        argsPerCore->localQueues = (void *) queuesPerCore;
+        argsPerCore->endLock.initialize(false);
+
+        /*
+         * Submit
+         */
+        runtime.submitAndDetach(NOELLE_DSWPTrampoline, argsPerCore, instance);
+        #ifdef RUNTIME_PRINT
+        std::cerr << "Submitted stage" << std::endl;
+        #endif
+      }
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Submitted pool" << std::endl;
+    #endif
+
+    /*
+     * Wait for the tasks to complete.
+     */
+    for (auto i = 0; i < numberOfInstances; ++i) {
+      runtime.waitForTask(argsForAllCores[i].endLock);
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Got all futures" << std::endl;
+    #endif
+
+    /*
+     * Record the invocation.
+     */
+    if (RuntimeTelemetry::enabled){
+      telemetry.joinedTime = RuntimeTelemetry::now();
+      telemetry.loopID = loopID;
+      telemetry.technique = "DSWP";
+      for (auto i = 0; i < numberOfInstances; ++i) {
+        telemetry.taskStartTimes.push_back(argsForAllCores[i].startTime);
+        telemetry.taskEndTimes.push_back(argsForAllCores[i].endTime);
+      }
+      for (auto i = 0; i < numberOfRuntimeQueues; ++i) {
+        telemetry.queues.push_back(((DSWPQueue *)(localQueues[i]))->getTelemetry());
+      }
+      runtime.telemetry.record(telemetry);
+    }
+
+    /*
+     * Free the cores and memory.
+     */
+    runtime.releaseCores(numCores, coresFromBudget);
+    for (int i = 0; i < numberOfRuntimeQueues; ++i) {
+      runtime.releaseDSWPQueue((DSWPQueue *)(localQueues[i]));
+    }
+    free(argsForAllCores);
+    free(queuesForAllCores);
+
+    #ifdef DSWP_STATS
+    std::cout << "DSWP: 1 Byte pushes = " << numberOfPushes8 << std::endl;
+    std::cout << "DSWP: 2 Bytes pushes = " << numberOfPushes16 << std::endl;
+    std::cout << "DSWP: 4 Bytes pushes = " << numberOfPushes32 << std::endl;
+    std::cout << "DSWP: 8 Bytes pushes = " << numberOfPushes64 << std::endl;
+    #endif
+
+    DispatcherInfo dispatcherInfo;
+    dispatcherInfo.numberOfThreadsUsed = numberOfInstances;
+    return dispatcherInfo;
+  }
+
+  DispatcherInfo NOELLE_DSWPDispatcher (
+    void *env, 
+    int64_t *queueSizes, 
+    int64_t *queueReplicatedStages,
+    void *stages, 
+    int64_t *stageReplicas,
+    int64_t numberOfStages, 
+    int64_t numberOfQueues,
+    int64_t loopID
+    ){
+    return NOELLE_DSWP_dispatcher(env, queueSizes, queueReplicatedStages, stages, stageReplicas, numberOfStages, numberOfQueues, false, loopID);
+  }
+
+  /*
+   * Dispatch the stages of a pipeline whose queues are accessed with queueBatchedPush*, queueBatchedPop*, and queueBatchedFlush*.
+   */
+  DispatcherInfo NOELLE_DSWPDispatcher_batchedQueues (
+    void *env, 
+    int64_t *queueSizes, 
+    int64_t *queueReplicatedStages,
+    void *stages, 
+    int64_t *stageReplicas,
+    int64_t numberOfStages, 
+    int64_t numberOfQueues,
+    int64_t loopID
+    ){
+    return NOELLE_DSWP_dispatcher(env, queueSizes, queueReplicatedStages, stages, stageReplicas, numberOfStages, numberOfQueues, true, loopID);
+  }
+
+  /**********************************************************************
+   *                Array reductions
+   **********************************************************************/
+
+  /*
+   * Allocate a dense private copy of an array reduced through @operation (see ArrayReductionElement::Operation).
+   * The copy has @numberOfElements elements of @elementBytes bytes each, and all of them are initialized to the identity of @operation.
+   */
+  void * NOELLE_arrayReduction_allocateDense (
+    int64_t numberOfElements,
+    int64_t elementBytes,
+    int64_t isFloatingPoint,
+    int64_t operation
+    ){
+
+    /*
+     * Allocate the copy.
+     */
+    auto bytes = numberOfElements * elementBytes;
+    void *privateCopy = nullptr;
+    if (posix_memalign(&privateCopy, CACHE_LINE_SIZE, std::max<int64_t>(bytes, CACHE_LINE_SIZE)) != 0){
+      fprintf(stderr, "NOELLE: Runtime: ERROR = not enough memory to allocate the private copy of a reduced array\n");
+      abort();
+    }
+
+    /*
+     * Initialize the elements.
+     */
+    auto identity = ArrayReductionElement::getIdentity(elementBytes, isFloatingPoint, operation);
+    if (identity == 0){
+      memset(privateCopy, 0, bytes);
+
+    } else {
+      for (auto i = 0; i < numberOfElements; i++){
+        ArrayReductionElement::store(((uint8_t *)privateCopy) + (i * elementBytes), elementBytes, identity);
+      }
+    }
+
+    return privateCopy;
+  }
+
+  /*
+   * Accumulate the dense private copy @privateCopy to the array @shared, and free the copy.
+   *
+   * Tasks merge their copies concurrently.
+   * To avoid having all of them contend on the same elements, each task starts from a different element, which depends on @taskInstanceID, and it wraps around.
+   * Elements that have not been updated by the task are skipped.
+   */
+  void NOELLE_arrayReduction_mergeDense (
+    void *privateCopy,
+    void *shared,
+    int64_t numberOfElements,
+    int64_t elementBytes,
+    int64_t isFloatingPoint,
+    int64_t operation,
+    int64_t taskInstanceID
+    ){
+
+    auto identity = ArrayReductionElement::getIdentity(elementBytes, isFloatingPoint, operation);
+    auto mergeOperation = ArrayReductionElement::getMergeOperation(operation);
+
+    /*
+     * Choose the first element to merge.
+     * It is aligned to a cache line to avoid false sharing with other tasks.
+     */
+    auto elementsPerCacheLine = std::max<int64_t>(CACHE_LINE_SIZE / elementBytes, 1);
+    auto fraction = std::fmod(((double)taskInstanceID) * 0.6180339887498949, 1.0);
+    auto firstElement = (((int64_t)(fraction * numberOfElements)) / elementsPerCacheLine) * elementsPerCacheLine;
+
+    /*
+     * Merge.
+     */
+    for (auto i = 0; i < numberOfElements; i++){
+      auto elementIndex = firstElement + i;
+      if (elementIndex >= numberOfElements){
+        elementIndex -= numberOfElements;
+      }
+      auto offset = elementIndex * elementBytes;
+      auto bits = ArrayReductionElement::load(((uint8_t *)privateCopy) + offset, elementBytes);
+      if (bits == identity){
+        continue ;
+      }
+      ArrayReductionElement::accumulateAtomically(((uint8_t *)shared) + offset, elementBytes, isFloatingPoint, mergeOperation, bits);
+    }
+
+    /*
+     * Free the copy.
+     */
+    free(privateCopy);
+
+    return ;
+  }
+
+  /*
+   * Allocate a sparse private copy of an array reduced through @operation (see ArrayReductionTable).
+   */
+  void * NOELLE_arrayReduction_allocateSparse (
+    int64_t elementBytes,
+    int64_t isFloatingPoint,
+    int64_t operation
+    ){
+    auto table = new ArrayReductionTable(elementBytes, isFloatingPoint, operation);
+
+    return table;
+  }
+
+  /*
+   * Accumulate the value whose raw bits are @valueBits to the element @index of the sparse private copy @table.
+   */
+  void NOELLE_arrayReduction_accumulateSparse (
+    void *table,
+    int64_t index,
+    int64_t valueBits
+    ){
+    ((ArrayReductionTable *)table)->accumulate(index, (uint64_t)valueBits);
+
+    return ;
+  }
+
+  /*
+   * Accumulate the sparse private copy @table to the array @shared, and free the copy.
+   */
+  void NOELLE_arrayReduction_mergeSparse (
+    void *table,
+    void *shared
+    ){
+    auto arrayTable = (ArrayReductionTable *)table;
+    arrayTable->mergeInto(shared);
+    delete arrayTable;
+
+    return ;
+  }
+
+}
+
+NoelleRuntime::NoelleRuntime()
+  : nextWorkerToPlace{0}
+  {
+  this->maxCores = this->getMaximumNumberOfCores();
+  this->NOELLE_idleCores = maxCores;
+
+  pthread_spin_init(&this->spinLock, 0);
+  pthread_spin_init(&this->doallMemoryLock, 0);
+  pthread_spin_init(&this->dswpQueuesLock, 0);
+  pthread_spin_init(&this->helixSequentialSegmentsLock, 0);
+  pthread_spin_init(&this->helixHelperThreadsLock, 0);
+  AdaptiveWait::initialize();
+
+  /*
+   * Fetch the size of the blocks of batched DSWP queues and the capacity of DSWP queues.
+   * The capacity is rounded up to a power of 2.
+   */
+  this->dswpQueueBlockBytes = CACHE_LINE_SIZE;
+  auto blockEnvVar = getenv("NOELLE_DSWP_QUEUE_BLOCK_BYTES");
+  if (  true
+        && (blockEnvVar != nullptr)
+        && (atoi(blockEnvVar) > 0)
+     ){
+    this->dswpQueueBlockBytes = atoi(blockEnvVar);
+  }
+  this->dswpQueueCapacity = 1;
+  uint64_t capacityRequested = 1024;
+  auto capacityEnvVar = getenv("NOELLE_DSWP_QUEUE_CAPACITY");
+  if (  true
+        && (capacityEnvVar != nullptr)
+        && (atoll(capacityEnvVar) > 0)
+     ){
+    capacityRequested = atoll(capacityEnvVar);
+  }
+  while (this->dswpQueueCapacity < capacityRequested){
+    this->dswpQueueCapacity *= 2;
+  }
+
+  /*
+   * Enable the telemetry if NOELLE_TELEMETRY is set.
+   */
+  this->telemetry.initialize();
+  this->loopCostModel.initialize();
+
+  /*
+   * Choose the logical cores of the workers.
+   * The first logical core of the placement is left to the thread that started the process.
+   */
+  auto pinEnvVar = getenv("NOELLE_PIN_THREADS");
+  if (  true
+        && (pinEnvVar != nullptr)
+        && (std::string(pinEnvVar) == "1")
+     ){
+    auto &placement = this->topology.placement;
+    auto firstWorkerCore = (placement.size() > 1) ? 1 : 0;
+    for (uint64_t i = firstWorkerCore; i < placement.size(); i++){
+      this->workerCores.push_back(placement[i]);
+    }
+  }
+
+  /*
+   * Allocate the thread pool.
+   */
+  this->workStealingPool = nullptr;
+  this->virgil = nullptr;
+  auto poolEnvVar = getenv("NOELLE_THREAD_POOL");
+  if (  true
+        && (poolEnvVar != nullptr)
+        && (std::string(poolEnvVar) == "virgil")
+     ){
+    this->virgil = new ThreadPoolForCSingleQueue(false, maxCores);
+  } else {
+    this->workStealingPool = new WorkStealingThreadPool(maxCores, this->workerCores);
+  }
+
+  /*
+   * Allocate the hot team.
+   * The thread that invokes a loop runs a task of it, so the team needs one worker less than the cores we can use.
+   */
+  this->hotTeam = nullptr;
+  auto hotTeamEnvVar = getenv("NOELLE_HOT_TEAM");
+  if (  true
+        && (hotTeamEnvVar != nullptr)
+        && (std::string(hotTeamEnvVar) == "1")
+        && (maxCores > 1)
+     ){
+    void *hotTeamMemory = nullptr;
+    if (posix_memalign(&hotTeamMemory, CACHE_LINE_SIZE, sizeof(HotTeam)) != 0){
+      fprintf(stderr, "NOELLE: Runtime: ERROR = not enough memory to allocate the hot team\n");
+      abort();
+    }
+    this->hotTeam = new (hotTeamMemory) HotTeam(maxCores - 1, this->workerCores);
+  }
+
+  /*
+   * Enable the helper threads of HELIX tasks.
+   * A helper needs to know the logical core of its task, so threads need to be pinned.
+   */
+  auto helixHelpersEnvVar = getenv("NOELLE_HELIX_HELPER_THREADS");
+  this->areHELIXHelperThreadsEnabled = true
+    && (helixHelpersEnvVar != nullptr)
+    && (std::string(helixHelpersEnvVar) == "1")
+    && (this->workerCores.size() > 0);
+
+  return ;
+}
+
+void NoelleRuntime::waitForTask (AdaptiveSemaphore &endLock){
+
+  /*
+   * Threads outside the work-stealing pool just wait.
+   */
+  if (  false
+        || (this->workStealingPool == nullptr)
+        || (!WorkStealingThreadPool::isCurrentThreadAWorker())
+     ){
+    endLock.wait();
+    return ;
+  }
+
+  /*
+   * Run pending tasks until the one we wait for ends.
+   * The worker never sleeps here because the tasks it has to run can show up in the pool while it waits.
+   */
+  for (int64_t i = 0; !endLock.tryWait(); i++){
+    if (this->workStealingPool->runPendingTask()){
+      i = 0;
+      continue ;
+    }
+    if (AdaptiveWait::shouldKeepSpinning(i)){
+      cpu_relax();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  return ;
+}
+
+void NoelleRuntime::submitAndDetach (void (*task)(void *), void *args, int64_t preferredWorker){
+  if (this->workStealingPool != nullptr){
+    this->workStealingPool->submitAndDetach(task, args, preferredWorker);
+    return ;
+  }
+  this->virgil->submitAndDetach(task, args);
+
+  return ;
+}
+
+void NoelleRuntime::placeCurrentWorker (void){
+
+  /*
+   * Check if the current thread needs to be placed.
+   */
+  if (  false
+        || (this->virgil == nullptr)
+        || (this->workerCores.size() == 0)
+        || NoelleRuntime::isCurrentWorkerPlaced
+     ){
+    return ;
+  }
+
+  /*
+   * VIRGIL does not tell us which of its workers runs a task.
+   * Hence, workers are pinned in the order they run their first task.
+   */
+  auto workerID = this->nextWorkerToPlace.fetch_add(1);
+  CoreTopology::pinCurrentThread(this->workerCores[workerID % this->workerCores.size()]);
+  NoelleRuntime::isCurrentWorkerPlaced = true;
+
+  return ;
+}
+
+DSWPQueue * NoelleRuntime::getDSWPQueue (uint64_t valueBytes, bool isBatched){
+  DSWPQueue *queue = nullptr;
+
+  /*
+   * Compute how many values are published at a time and the capacity of the queue.
+   */
+  uint64_t valuesPerPublish = 1;
+  if (isBatched){
+    valuesPerPublish = std::max(this->dswpQueueBlockBytes / valueBytes, (uint64_t)1);
+  }
+  auto capacity = this->dswpQueueCapacity;
+  while (capacity < (2 * valuesPerPublish)){
+    capacity *= 2;
+  }
+  auto bytesNeeded = capacity * valueBytes;
+
+  /*
+   * Check if we can reuse a queue that has been allocated by a previous invocation of a pipeline.
+   */
+  pthread_spin_lock(&this->dswpQueuesLock);
+  auto &pool = this->availableDSWPQueues;
+  for (uint64_t i = 0; i < pool.size(); i++){
+    if (pool[i]->getBufferBytes() >= bytesNeeded){
+      queue = pool[i];
+      pool[i] = pool.back();
+      pool.pop_back();
+      break ;
+    }
+  }
+  pthread_spin_unlock(&this->dswpQueuesLock);
+
+  /*
+   * Allocate a new queue if we couldn't find anything available.
+   */
+  if (queue == nullptr){
+    void *queueMemory = nullptr;
+    if (posix_memalign(&queueMemory, CACHE_LINE_SIZE, sizeof(DSWPQueue)) != 0){
+      fprintf(stderr, "NOELLE: Runtime: ERROR = not enough memory to allocate a DSWP queue\n");
+      abort();
+    }
+    queue = new (queueMemory) DSWPQueue(bytesNeeded);
+  }
+
+  /*
+   * Initialize the queue.
+   */
+  queue->initialize(valueBytes, capacity, valuesPerPublish);
+
+  return queue;
+}
+
+void NoelleRuntime::releaseDSWPQueue (DSWPQueue *queue){
+  pthread_spin_lock(&this->dswpQueuesLock);
+  this->availableDSWPQueues.push_back(queue);
+  pthread_spin_unlock(&this->dswpQueuesLock);
+
+  return ;
+}
+
+HELIXSequentialSegment * NoelleRuntime::getHELIXSequentialSegments (uint64_t numOfsequentialSegments, uint64_t *capacity){
+  HELIXSequentialSegment *sequentialSegments = nullptr;
+
+  /*
+   * Check if we can reuse the sequential segments of a previous invocation of a HELIX loop.
+   */
+  pthread_spin_lock(&this->helixSequentialSegmentsLock);
+  auto &pool = this->availableHELIXSequentialSegments;
+  for (uint64_t i = 0; i < pool.size(); i++){
+    if (pool[i].second >= numOfsequentialSegments){
+      sequentialSegments = pool[i].first;
+      *capacity = pool[i].second;
+      pool[i] = pool.back();
+      pool.pop_back();
+      break ;
+    }
+  }
+  pthread_spin_unlock(&this->helixSequentialSegmentsLock);
+
+  /*
+   * Allocate new sequential segments if we couldn't find anything available.
+   */
+  if (sequentialSegments == nullptr){
+    posix_memalign((void **)&sequentialSegments, CACHE_LINE_SIZE, sizeof(HELIXSequentialSegment) * numOfsequentialSegments);
+    if (sequentialSegments == nullptr){
+      fprintf(stderr, "HELIX: dispatcher: ERROR = not enough memory to allocate %lld sequential segments\n", (long long)numOfsequentialSegments);
+      abort();
+    }
+    *capacity = numOfsequentialSegments;
+  }
+
+  /*
+   * Initialize the sequential segments.
+   */
+  for (uint64_t ssID = 0; ssID < numOfsequentialSegments; ssID++){
+    sequentialSegments[ssID].initialize();
+  }
+
+  return sequentialSegments;
+}
+
+void NoelleRuntime::releaseHELIXSequentialSegments (HELIXSequentialSegment *sequentialSegments, uint64_t capacity){
+  pthread_spin_lock(&this->helixSequentialSegmentsLock);
+  this->availableHELIXSequentialSegments.push_back(std::make_pair(sequentialSegments, capacity));
+  pthread_spin_unlock(&this->helixSequentialSegmentsLock);
+
+  return ;
+}
+
+HELIXHelperThread * NoelleRuntime::getHELIXHelperOfCurrentThread (uint32_t threadsOfTheLoop){
+  if (  false
+        || (!this->areHELIXHelperThreadsEnabled)
+        || (threadsOfTheLoop > this->topology.getNumberOfPhysicalCores())
+     ){
+    return nullptr;
+  }
+
+  /*
+   * Fetch the SMT sibling of the logical core of the current thread.
+   */
+  auto currentCore = sched_getcpu();
+  if (currentCore < 0){
+    return nullptr;
+  }
+  auto siblingCore = this->topology.getSMTSibling(currentCore);
+  if (siblingCore < 0){
+    return nullptr;
+  }
+
+  /*
+   * Fetch the helper of the sibling.
+   */
+  pthread_spin_lock(&this->helixHelperThreadsLock);
+  auto &helper = this->helixHelperThreads[siblingCore];
+  if (helper == nullptr){
+    void *helperMemory = nullptr;
+    if (posix_memalign(&helperMemory, CACHE_LINE_SIZE, sizeof(HELIXHelperThread)) != 0){
+      fprintf(stderr, "NOELLE: Runtime: ERROR = not enough memory to allocate a HELIX helper thread\n");
+      abort();
+    }
+    helper = new (helperMemory) HELIXHelperThread(siblingCore);
+  }
+  auto helperOfCurrentThread = helper;
+  pthread_spin_unlock(&this->helixHelperThreadsLock);
+
+  return helperOfCurrentThread;
+}
+
+DOALL_args_t * NoelleRuntime::getDOALLArgs (uint32_t cores, uint32_t *index){
+  DOALL_args_t *argsForAllCores = nullptr;
+
+  /*
+   * Check if we can reuse a previously-allocated memory region.
+   */
+  pthread_spin_lock(&this->doallMemoryLock);
+  auto doallMemoryNumberOfChunks = this->doallMemoryAvailability.size();
+  for (auto i=0; i < doallMemoryNumberOfChunks; i++){
+    auto currentSize = this->doallMemorySizes[i];
+    if (  true
+          && (this->doallMemoryAvailability[i])
+          && (currentSize >= cores)
+       ){
+
+      /*
+       * Found a memory block that can be reused.
+       */
+      argsForAllCores = this->doallMemory[i];
+
+      /*
+       * Set the block as in use.
+       */
+      this->doallMemoryAvailability[i] = false;
+      (*index) = i;
+      pthread_spin_unlock(&this->doallMemoryLock);
+
+      return argsForAllCores;
+    }
+  }
+
+  /*
+   * We couldn't find anything available.
+   *
+   * Allocate a new memory region.
+   */
+  this->doallMemorySizes.push_back(cores);
+  this->doallMemoryAvailability.push_back(false);
+  posix_memalign((void **)&argsForAllCores, CACHE_LINE_SIZE, sizeof(DOALL_args_t) * cores);
+  this->doallMemory.push_back(argsForAllCores);
+  pthread_spin_unlock(&this->doallMemoryLock);
+
+  /*
+   * Set the index.
+   */
+  (*index) = doallMemoryNumberOfChunks;
+
+  /*
+   * Initialize the memory.
+   */ 
+  for (auto i = 0; i < cores; ++i) {
+    auto argsPerCore = &argsForAllCores[i];
+    argsPerCore->coreID = i;
+    argsPerCore->endLock.initialize(false);
+  }
+
+  return argsForAllCores;
+}
+
+void NoelleRuntime::releaseDOALLArgs (uint32_t index){
+  pthread_spin_lock(&this->doallMemoryLock);
+  this->doallMemoryAvailability[index] = true;
+  pthread_spin_unlock(&this->doallMemoryLock);
+  return ;
+}
+
+uint32_t NoelleRuntime::reserveCores (uint32_t coresRequested, bool *fromBudget){
+
+  /*
+   * Check if the current thread runs within a parallelized loop that gave it cores to spare.
+   *
+   * The current thread keeps one core of its budget for itself as it will run a task of the loop it is about to dispatch.
+   */
+  if (NoelleRuntime::coreBudget > 1){
+    auto numCores = (NoelleRuntime::coreBudget >= coresRequested) ? coresRequested : NoelleRuntime::coreBudget;
+    if (numCores < 1){
+      numCores = 1;
+    }
+    NoelleRuntime::coreBudget -= (numCores - 1);
+    (*fromBudget) = true;
+
+    return numCores;
+  }
+  (*fromBudget) = false;
+ 
+  /*
+   * Reserve the number of cores available.
+   */
+  pthread_spin_lock(&this->spinLock);
+  auto numCores = (this->NOELLE_idleCores >= coresRequested) ? coresRequested : NOELLE_idleCores;
+  if (numCores < 1){
+    numCores = 1;
+  }
+  this->NOELLE_idleCores -= numCores;
+  pthread_spin_unlock(&this->spinLock);
+
+  return numCores;
+}
+    
+void NoelleRuntime::releaseCores (uint32_t coresReleased, bool fromBudget){
+  assert(coresReleased > 0);
+
+  /*
+   * Give the cores back to the budget they have been taken from.
+   */
+  if (fromBudget){
+    NoelleRuntime::coreBudget += (coresReleased - 1);
+    return ;
+  }
+
+  pthread_spin_lock(&this->spinLock);
+  this->NOELLE_idleCores += coresReleased;
+  #ifdef DEBUG
+  if (this->NOELLE_idleCores >= 0){
+    assert(this->NOELLE_idleCores <= ((uint32_t)this->maxCores));
+  }
+  #endif
+  pthread_spin_unlock(&this->spinLock);
+
+  return ;
+}
+
+uint32_t NoelleRuntime::getCoreBudget (void) const {
+  return NoelleRuntime::coreBudget;
+}
+
+void NoelleRuntime::setCoreBudget (uint32_t cores){
+  NoelleRuntime::coreBudget = cores;
+
+  return ;
+}
+
+uint32_t NoelleRuntime::getMaximumNumberOfCores (void){
+  static int cores = 0;
+
+  /*
+   * Check if we have already computed the number of cores.
+   */
+  if (cores == 0){
+
+    /*
+     * Compute the number of cores.
+     */
+    auto envVar = getenv("NOELLE_CORES");
+    if (envVar == nullptr){
+
+      /*
+       * Leave a physical core to the thread that started the process.
+       */
+      cores = this->topology.getNumberOfPhysicalCores() - 1;
+      if (cores < 1){
+        cores = 1;
+      }
+    } else {
+      cores = atoi(envVar);
+    }
+  }
+
+  return cores;
+}
+    
+NoelleRuntime::~NoelleRuntime(void){
+  this->telemetry.dump();
+  if (this->hotTeam != nullptr){
+    this->hotTeam->~HotTeam();
+    free(this->hotTeam);
+  }
+  delete this->workStealingPool;
+  delete this->virgil;
+  for (auto queue : this->availableDSWPQueues){
+    queue->~DSWPQueue();
+    free(queue);
+  }
+  for (auto sequentialSegments : this->availableHELIXSequentialSegments){
+    free(sequentialSegments.first);
+  }
+  for (auto &helper : this->helixHelperThreads){
+    helper.second->~HELIXHelperThread();
+    free(helper.second);
+  }
+}
+
+thread_local uint32_t NoelleRuntime::coreBudget = 0;
+
+bool RuntimeTelemetry::enabled = false;
+
+bool LoopCostModel::enabled = true;
+
+void LoopCostModel::initialize (void){
+  auto envVar = getenv("NOELLE_ADAPTIVE_THREADS");
+  if (  true
+        && (envVar != nullptr)
+        && (std::string(envVar) == "0")
+     ){
+    LoopCostModel::enabled = false;
+    return ;
+  }
+  for (auto &cost : this->loopCosts){
+    cost.loopID.store(-1, std::memory_order_relaxed);
+    cost.nanosecondsPerIteration.store(0, std::memory_order_relaxed);
+    cost.overheadPerThread.store(0, std::memory_order_relaxed);
+    cost.sequentialInvocations.store(0, std::memory_order_relaxed);
+  }
+
+  return ;
+}
+
+uint32_t LoopCostModel::chooseNumberOfThreads (int64_t loopID, int64_t numberOfIterations, uint32_t maximumNumberOfThreads){
+  if (  false
+        || (!LoopCostModel::enabled)
+        || (numberOfIterations <= 0)
+        || (maximumNumberOfThreads <= 1)
+     ){
+    return maximumNumberOfThreads;
+  }
+
+  /*
+   * Fetch the history of the loop.
+   */
+  auto &cost = this->fetchLoopCost(loopID);
+  if (cost.loopID.load(std::memory_order_relaxed) != loopID){
+    return maximumNumberOfThreads;
+  }
+  auto nanosecondsPerIteration = cost.nanosecondsPerIteration.load(std::memory_order_relaxed);
+  auto overheadPerThread = cost.overheadPerThread.load(std::memory_order_relaxed);
+  if (  false
+        || (nanosecondsPerIteration <= 0)
+        || (overheadPerThread <= 0)
+     ){
+    return maximumNumberOfThreads;
+  }
+
+  /*
+   * Choose the number of threads.
+   */
+  auto threads = std::sqrt((numberOfIterations * nanosecondsPerIteration) / overheadPerThread);
+  if (threads >= maximumNumberOfThreads){
+    return maximumNumberOfThreads;
+  }
+  if (threads >= 2){
+    return (uint32_t)threads;
+  }
+
+  /*
+   * The invocation is not worth forking.
+   */
+  auto sequentialInvocations = cost.sequentialInvocations.fetch_add(1, std::memory_order_relaxed) + 1;
+  if ((sequentialInvocations % LoopCostModel::probingPeriod) == 0){
+    return 2;
+  }
+
+  return 1;
+}
+
+void LoopCostModel::learn (int64_t loopID, int64_t numberOfIterations, uint32_t threads, uint64_t taskTime, uint64_t invocationTime){
+  if (  false
+        || (!LoopCostModel::enabled)
+        || (numberOfIterations <= 0)
+     ){
+    return ;
+  }
+
+  /*
+   * Fetch the history of the loop.
+   */
+  auto &cost = this->fetchLoopCost(loopID);
+  if (cost.loopID.load(std::memory_order_relaxed) != loopID){
+    cost.loopID.store(loopID, std::memory_order_relaxed);
+    cost.nanosecondsPerIteration.store(0, std::memory_order_relaxed);
+    cost.overheadPerThread.store(0, std::memory_order_relaxed);
+    cost.sequentialInvocations.store(0, std::memory_order_relaxed);
+  }
+
+  /*
+   * Learn the time of an iteration.
+   * The task run by the invoking thread is assumed to represent the work done by each thread.
+   */
+  auto nanosecondsPerIteration = ((double)taskTime * threads) / numberOfIterations;
+  cost.nanosecondsPerIteration.store(LoopCostModel::average(cost.nanosecondsPerIteration.load(std::memory_order_relaxed), nanosecondsPerIteration), std::memory_order_relaxed);
+
+  /*
+   * Learn the overhead of a thread.
+   * This includes waiting for threads that end after the invoking one.
+   */
+  if (threads > 1){
+    auto overhead = (invocationTime > taskTime) ? (invocationTime - taskTime) : 1;
+    auto overheadPerThread = ((double)overhead) / (threads - 1);
+    cost.overheadPerThread.store(LoopCostModel::average(cost.overheadPerThread.load(std::memory_order_relaxed), overheadPerThread), std::memory_order_relaxed);
+  }
+
+  return ;
+}
+
+LoopCostModel::LoopCost & LoopCostModel::fetchLoopCost (int64_t loopID){
+  return this->loopCosts[((uint64_t)loopID) % LoopCostModel::numberOfLoopCosts];
+}
+
+double LoopCostModel::average (double currentAverage, double sample){
+  if (currentAverage <= 0){
+    return sample;
+  }
+
+  return currentAverage + ((sample - currentAverage) / 4);
+}
+
+void RuntimeTelemetry::initialize (void){
+  auto fileName = getenv("NOELLE_TELEMETRY");
+  if (  false
+        || (fileName == nullptr)
+        || (std::string(fileName) == "")
+     ){
+    return ;
+  }
+  this->outputFileName = fileName;
+  this->maximumInvocationsPerLoop = 1000;
+  auto invocations = getenv("NOELLE_TELEMETRY_INVOCATIONS");
+  if (invocations != nullptr){
+    this->maximumInvocationsPerLoop = atoll(invocations);
+  }
+  RuntimeTelemetry::enabled = true;
+
+  return ;
+}
+
+void RuntimeTelemetry::record (InvocationRecord &invocation){
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  /*
+   * Fetch the record of the loop.
+   */
+  auto loopIt = this->loops.find(invocation.loopID);
+  if (loopIt == this->loops.end()){
+    LoopRecord newLoop;
+    newLoop.technique = invocation.technique;
+    newLoop.invocations = 0;
+    newLoop.totalTime = 0;
+    newLoop.setupTime = 0;
+    newLoop.forkTime = 0;
+    newLoop.joinTime = 0;
+    loopIt = this->loops.insert({invocation.loopID, newLoop}).first;
+  }
+  auto &loop = loopIt->second;
+
+  /*
+   * Add the invocation to the totals of the loop.
+   */
+  loop.invocations++;
+  loop.totalTime += invocation.joinedTime - invocation.dispatchTime;
+  loop.setupTime += invocation.getSetupTime();
+  loop.forkTime += invocation.getForkTime();
+  loop.joinTime += invocation.getJoinTime();
+
+  /*
+   * Keep the invocation.
+   */
+  if (loop.invocationRecords.size() < this->maximumInvocationsPerLoop){
+    loop.invocationRecords.push_back(std::move(invocation));
+  }
+
+  return ;
+}
+
+void RuntimeTelemetry::dump (void){
+  if (!RuntimeTelemetry::enabled){
+    return ;
+  }
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  /*
+   * Open the output.
+   */
+  std::ofstream file;
+  std::ostream *stream = &std::cerr;
+  if (this->outputFileName != "stderr"){
+    file.open(this->outputFileName);
+    if (!file.is_open()){
+      std::cerr << "NOELLE: Runtime: telemetry cannot be written to " << this->outputFileName << std::endl;
+      return ;
+    }
+    stream = &file;
+  }
+
+  /*
+   * Write the loops.
+   * Each invocation is written in a line of its own so they can be processed by line-oriented tools (e.g., tests/scripts/runtime_profiler.sh).
+   */
+  *stream << "{\n  \"loops\": [";
+  auto isFirstLoop = true;
+  for (auto &loopPair : this->loops){
+    auto &loop = loopPair.second;
+    *stream << (isFirstLoop ? "\n" : ",\n");
+    isFirstLoop = false;
+    *stream << "    {\n";
+    *stream << "      \"id\": " << loopPair.first << ",\n";
+    *stream << "      \"technique\": \"" << loop.technique << "\",\n";
+    *stream << "      \"invocations\": " << loop.invocations << ",\n";
+    *stream << "      \"totalNanoseconds\": " << loop.totalTime << ",\n";
+    *stream << "      \"totalSetupNanoseconds\": " << loop.setupTime << ",\n";
+    *stream << "      \"totalForkNanoseconds\": " << loop.forkTime << ",\n";
+    *stream << "      \"totalJoinNanoseconds\": " << loop.joinTime << ",\n";
+    *stream << "      \"invocationRecords\": [";
+    for (uint64_t i = 0; i < loop.invocationRecords.size(); i++){
+      *stream << ((i == 0) ? "\n" : ",\n") << "        ";
+      RuntimeTelemetry::dumpInvocation(*stream, loop.invocationRecords[i]);
+    }
+    *stream << "\n      ]\n";
+    *stream << "    }";
+  }
+  *stream << "\n  ]\n}\n";
+
+  return ;
+}
+
+void RuntimeTelemetry::dumpInvocation (std::ostream &stream, const InvocationRecord &invocation){
+  stream << "{\"threads\": " << invocation.taskStartTimes.size();
+  stream << ", \"totalNanoseconds\": " << (invocation.joinedTime - invocation.dispatchTime);
+  stream << ", \"setupNanoseconds\": " << invocation.getSetupTime();
+  stream << ", \"forkNanoseconds\": " << invocation.getForkTime();
+  stream << ", \"joinNanoseconds\": " << invocation.getJoinTime();
+  stream << ", \"imbalance\": " << invocation.getImbalance();
+
+  stream << ", \"busyNanoseconds\": [";
+  for (uint64_t i = 0; i < invocation.taskStartTimes.size(); i++){
+    stream << ((i == 0) ? "" : ", ") << (invocation.taskEndTimes[i] - invocation.taskStartTimes[i]);
+  }
+  stream << "]";
+
+  if (invocation.sequentialSegmentWaitTimes.size() > 0){
+    stream << ", \"sequentialSegmentWaitNanoseconds\": [";
+    for (uint64_t i = 0; i < invocation.sequentialSegmentWaitTimes.size(); i++){
+      stream << ((i == 0) ? "" : ", ") << invocation.sequentialSegmentWaitTimes[i];
+    }
+    stream << "]";
+  }
+
+  if (invocation.queues.size() > 0){
+    stream << ", \"queues\": [";
+    for (uint64_t i = 0; i < invocation.queues.size(); i++){
+      auto &queue = invocation.queues[i];
+      auto averageOccupancy = (queue.values > 0) ? (((double)queue.occupancySum) / queue.values) : 0;
+      stream << ((i == 0) ? "" : ", ");
+      stream << "{\"valueBytes\": " << queue.valueBytes;
+      stream << ", \"capacity\": " << queue.capacity;
+      stream << ", \"values\": " << queue.values;
+      stream << ", \"averageOccupancy\": " << averageOccupancy;
+      stream << ", \"maximumOccupancy\": " << queue.maximumOccupancy;
+      stream << ", \"fullWaits\": " << queue.fullWaits;
+      stream << ", \"emptyWaits\": " << queue.emptyWaits << "}";
+    }
+    stream << "]";
+  }
+  stream << "}";
+
+  return ;
+}
+
+uint64_t RuntimeTelemetry::InvocationRecord::getSetupTime (void) const {
+  return this->forkTime - this->dispatchTime;
+}
+
+uint64_t RuntimeTelemetry::InvocationRecord::getForkTime (void) const {
+  uint64_t lastStart = this->forkTime;
+  for (auto startTime : this->taskStartTimes){
+    lastStart = std::max(lastStart, startTime);
+  }
+
+  return lastStart - this->forkTime;
+}
+
+uint64_t RuntimeTelemetry::InvocationRecord::getJoinTime (void) const {
+  uint64_t lastEnd = 0;
+  for (auto endTime : this->taskEndTimes){
+    lastEnd = std::max(lastEnd, endTime);
+  }
+  if (lastEnd > this->joinedTime){
+    return 0;
+  }
+
+  return this->joinedTime - lastEnd;
+}
+
+double RuntimeTelemetry::InvocationRecord::getImbalance (void) const {
+  uint64_t maximumBusyTime = 0;
+  uint64_t totalBusyTime = 0;
+  for (uint64_t i = 0; i < this->taskStartTimes.size(); i++){
+    auto busyTime = this->taskEndTimes[i] - this->taskStartTimes[i];
+    maximumBusyTime = std::max(maximumBusyTime, busyTime);
+    totalBusyTime += busyTime;
+  }
+  if (totalBusyTime == 0){
+    return 1;
+  }
+  auto averageBusyTime = ((double)totalBusyTime) / this->taskStartTimes.size();
+
+  return maximumBusyTime / averageBusyTime;
+}
+
+int64_t AdaptiveWait::spinIterations = 4096;
+
+void AdaptiveWait::initialize (void){
+  auto policy = getenv("NOELLE_WAIT_POLICY");
+  if (policy == nullptr){
+    policy = (char *)"adaptive";
+  }
+  if (std::string(policy) == "spin"){
+    AdaptiveWait::spinIterations = -1;
+
+  } else if (std::string(policy) == "park"){
+    AdaptiveWait::spinIterations = 0;
+
+  } else {
+    auto iterations = getenv("NOELLE_WAIT_SPIN_ITERATIONS");
+    if (iterations != nullptr){
+      AdaptiveWait::spinIterations = atoll(iterations);
+    }
+  }
+
+  return ;
+}
+
+void AdaptiveWait::futexWait (std::atomic<uint32_t> *word, uint32_t expectedValue){
+  syscall(SYS_futex, (uint32_t *)word, FUTEX_WAIT_PRIVATE, expectedValue, nullptr, nullptr, 0);
+
+  return ;
+}
+
+void AdaptiveWait::futexWake (std::atomic<uint32_t> *word, int32_t numberOfThreads){
+  syscall(SYS_futex, (uint32_t *)word, FUTEX_WAKE_PRIVATE, numberOfThreads, nullptr, nullptr, 0);
+
+  return ;
+}
+
+void AdaptiveSemaphore::initialize (bool isAvailable){
+  this->state.store(isAvailable ? 0 : 1);
+
+  return ;
+}
+
+void AdaptiveSemaphore::wait (void){
+
+  /*
+   * Spin.
+   */
+  for (int64_t i = 0; AdaptiveWait::shouldKeepSpinning(i); i++){
+    uint32_t available = 0;
+    if (  true
+          && (this->state.load(std::memory_order_relaxed) == 0)
+          && this->state.compare_exchange_weak(available, 1, std::memory_order_acquire)
+       ){
+      return ;
+    }
+    cpu_relax();
+  }
+
+  /*
+   * Sleep.
+   *
+   * Once a thread sleeps, the semaphore is taken with state 2 so whoever signals it knows it has to wake somebody up.
+   */
+  auto previousState = this->state.exchange(2, std::memory_order_acquire);
+  while (previousState != 0){
+    AdaptiveWait::futexWait(&this->state, 2);
+    previousState = this->state.exchange(2, std::memory_order_acquire);
+  }
+
+  return ;
+}
+
+bool AdaptiveSemaphore::tryWait (void){
+  uint32_t available = 0;
+
+  return this->state.compare_exchange_strong(available, 1, std::memory_order_acquire);
+}
+
+void AdaptiveSemaphore::signal (void){
+  if (this->state.exchange(0, std::memory_order_release) == 2){
+    AdaptiveWait::futexWake(&this->state, 1);
+  }
+
+  return ;
+}
+
+void HELIXSequentialSegment::initialize (void){
+  new (&this->ticketCompleted) AdaptiveEventCount();
+  this->completedTickets.store(0);
+
+  return ;
+}
+
+void HELIXSequentialSegment::wait (int64_t ticket){
+  this->ticketCompleted.waitUntil([this, ticket](void) -> bool {
+    return this->canEnter(ticket);
+  });
+
+  return ;
+}
+
+bool HELIXSequentialSegment::canEnter (int64_t ticket) const {
+  return this->completedTickets.load(std::memory_order_acquire) >= ticket;
+}
+
+void HELIXSequentialSegment::signal (int64_t ticket){
+
+  /*
+   * Signaling a ticket that has already been completed (e.g., when leaving the loop) has no effect.
+   *
+   * The caller waited for its ticket before signaling it.
+   * Hence, only the caller can change the counter if it has not completed its ticket yet.
+   */
+  if (this->completedTickets.load(std::memory_order_relaxed) > ticket){
+    return ;
+  }
+  this->completedTickets.store(ticket + 1, std::memory_order_release);
+  this->ticketCompleted.notifyAll();
+
+  return ;
+}
+
+AdaptiveEventCount::AdaptiveEventCount ()
+  : epoch{0}
+  , sleepers{0}
+  {
+  return ;
+}
+
+void AdaptiveEventCount::notifyAll (void){
+
+  /*
+   * The fence orders the update of the condition done by the caller with the check of the sleepers (see waitUntil).
+   */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (this->sleepers.load() == 0){
+    return ;
+  }
+  this->epoch.fetch_add(1);
+  AdaptiveWait::futexWake(&this->epoch, INT_MAX);
+
+  return ;
+}
+
+thread_local bool NoelleRuntime::isCurrentWorkerPlaced = false;
+
+thread_local int64_t WorkStealingThreadPool::currentWorkerID = -1;
+
+WorkStealingThreadPool::WorkStealingThreadPool (uint32_t numberOfWorkers, const std::vector<int32_t> &cores)
+  : nextQueue{0}
+  , pendingTasks{0}
+  , sleepingWorkers{0}
+  , isAlive{true}
+  {
+  if (numberOfWorkers == 0){
+    numberOfWorkers = 1;
+  }
+
+  /*
+   * Allocate the queues.
+   * Each queue starts a cache line, which new does not guarantee for over-aligned types in C++14.
+   */
+  for (uint32_t i = 0; i < numberOfWorkers; i++){
+    void *queueMemory = nullptr;
+    if (posix_memalign(&queueMemory, CACHE_LINE_SIZE, sizeof(WorkerQueue)) != 0){
+      fprintf(stderr, "NOELLE: Runtime: ERROR = not enough memory to allocate the queues of the thread pool\n");
+      abort();
+    }
+    auto queue = new (queueMemory) WorkerQueue();
+    pthread_spin_init(&queue->lock, PTHREAD_PROCESS_PRIVATE);
+    this->queues.push_back(queue);
+  }
+
+  /*
+   * Start the workers.
+   */
+  for (uint32_t i = 0; i < numberOfWorkers; i++){
+    auto logicalCore = (cores.size() > 0) ? cores[i % cores.size()] : -1;
+    this->workers.push_back(std::thread(&WorkStealingThreadPool::workerLoop, this, i, logicalCore));
+  }
+
+  return ;
+}
+
+void WorkStealingThreadPool::submitAndDetach (void (*task)(void *), void *args, int64_t preferredWorker){
+
+  /*
+   * Choose the queue.
+   * Workers submit to their own queue; other threads use the preferred worker if any, or spread their tasks among all queues otherwise.
+   */
+  uint64_t queueID;
+  if (currentWorkerID >= 0){
+    queueID = currentWorkerID;
+  } else if (preferredWorker >= 0){
+    queueID = preferredWorker % this->queues.size();
+  } else {
+    queueID = this->nextQueue.fetch_add(1, std::memory_order_relaxed) % this->queues.size();
+  }
+  auto queue = this->queues[queueID];
+
+  /*
+   * Append the task.
+   */
+  WorkStealingTask_t t;
+  t.task = task;
+  t.args = args;
+  pthread_spin_lock(&queue->lock);
+  queue->tasks.push_back(t);
+  pthread_spin_unlock(&queue->lock);
+
+  /*
+   * Wake up a worker if some of them are sleeping.
+   */
+  this->pendingTasks.fetch_add(1);
+  if (this->sleepingWorkers.load() > 0){
+    std::lock_guard<std::mutex> guard(this->sleepLock);
+    this->sleepCondition.notify_one();
+  }
+
+  return ;
+}
+
+bool WorkStealingThreadPool::fetchTask (uint32_t workerID, WorkStealingTask_t &task){
+
+  /*
+   * Try the most recent task of our own queue.
+   */
+  auto myQueue = this->queues[workerID];
+  pthread_spin_lock(&myQueue->lock);
+  if (!myQueue->tasks.empty()){
+    task = myQueue->tasks.back();
+    myQueue->tasks.pop_back();
+    pthread_spin_unlock(&myQueue->lock);
+    return true;
+  }
+  pthread_spin_unlock(&myQueue->lock);
+
+  /*
+   * Steal the oldest task of another queue.
+   */
+  auto numberOfQueues = this->queues.size();
+  for (uint64_t i = 1; i < numberOfQueues; i++){
+    auto victim = this->queues[(workerID + i) % numberOfQueues];
+    pthread_spin_lock(&victim->lock);
+    if (!victim->tasks.empty()){
+      task = victim->tasks.front();
+      victim->tasks.pop_front();
+      pthread_spin_unlock(&victim->lock);
+      return true;
+    }
+    pthread_spin_unlock(&victim->lock);
+  }
+
+  return false;
+}
+
+bool WorkStealingThreadPool::runPendingTask (void){
+  if (currentWorkerID < 0){
+    return false;
+  }
+
+  /*
+   * Fetch a task, starting from the most recent ones of our own queue.
+   */
+  WorkStealingTask_t task;
+  if (!this->fetchTask(currentWorkerID, task)){
+    return false;
+  }
+
+  /*
+   * Run it.
+   */
+  this->pendingTasks.fetch_sub(1);
+  task.task(task.args);
+
+  return true;
+}
+
+void WorkStealingThreadPool::workerLoop (uint32_t workerID, int32_t logicalCore){
+  currentWorkerID = workerID;
+  if (logicalCore >= 0){
+    CoreTopology::pinCurrentThread(logicalCore);
+  }
+
+  while (this->isAlive.load(std::memory_order_relaxed)){
+
+    /*
+     * Fetch a task.
+     */
+    WorkStealingTask_t task;
+    if (this->fetchTask(workerID, task)){
+      this->pendingTasks.fetch_sub(1);
+      task.task(task.args);
+      continue ;
+    }
+
+    /*
+     * There is no task.
+     * Spin for a while before going to sleep.
+     */
+    auto spins = 0;
+    while (  true
+             && (this->pendingTasks.load(std::memory_order_relaxed) <= 0)
+             && (spins < 1024)
+             ){
+      spins++;
+      cpu_relax();
+    }
+    if (this->pendingTasks.load(std::memory_order_relaxed) > 0){
+      continue ;
+    }
+
+    /*
+     * Sleep until a new task is submitted.
+     */
+    std::unique_lock<std::mutex> guard(this->sleepLock);
+    this->sleepingWorkers.fetch_add(1);
+    this->sleepCondition.wait(guard, [this](void) -> bool {
+      return (this->pendingTasks.load() > 0) || (!this->isAlive.load());
+    });
+    this->sleepingWorkers.fetch_sub(1);
+  }
+
+  return ;
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool (void){
+
+  /*
+   * Stop the workers.
+   */
+  {
+    std::lock_guard<std::mutex> guard(this->sleepLock);
+    this->isAlive.store(false);
+    this->sleepCondition.notify_all();
+  }
+  for (auto &worker : this->workers){
+    worker.join();
+  }
+
+  /*
+   * Free the memory.
+   */
+  for (auto queue : this->queues){
+    pthread_spin_destroy(&queue->lock);
+    queue->~WorkerQueue();
+    free(queue);
+  }
+
+  return ;
+}
+
+HotTeam::HotTeam (uint32_t numberOfWorkers, const std::vector<int32_t> &cores)
+  : generation{0}
+  , sleepingWorkers{0}
+  , runningWorkers{0}
+  , isJoinerSleeping{0}
+  , isBusy{false}
+  , task{nullptr}
+  , args{nullptr}
+  , argsBytes{0}
+  , isAlive{true}
+  {
+  if (numberOfWorkers > HotTeam::workersMask){
+    numberOfWorkers = HotTeam::workersMask;
+  }
+
+  /*
+   * Start the workers.
+   */
+  for (uint32_t i = 0; i < numberOfWorkers; i++){
+    auto logicalCore = (cores.size() > 0) ? cores[i % cores.size()] : -1;
+    this->workers.push_back(std::thread(&HotTeam::workerLoop, this, i, logicalCore));
+  }
+
+  return ;
+}
+
+bool HotTeam::tryToStart (void (*task)(void *), void *args, uint64_t argsBytes, uint32_t numberOfWorkers){
+
+  /*
+   * Check if the team can run the task.
+   */
+  if (  false
+        || (numberOfWorkers == 0)
+        || (numberOfWorkers > this->workers.size())
+     ){
+    return false;
+  }
+  if (this->isBusy.exchange(true, std::memory_order_acquire)){
+    return false;
   }
 
+  /*
+   * Publish the task.
+   * Only the workers that take part in the new generation read it, and they do it after noticing the generation.
+   */
+  this->task = task;
+  this->args = (uint8_t *)args;
+  this->argsBytes = argsBytes;
+  this->runningWorkers.store(numberOfWorkers, std::memory_order_relaxed);
 
-  /**********************************************************************
-   *                DSWP
-   **********************************************************************/
-  typedef struct {
-    stageFunctionPtr_t funcToInvoke;
-    void *env;
-    void *localQueues;
-    pthread_mutex_t endLock;
-  } NOELLE_DSWP_args_t ;
-
-  void stageExecuter(void (*stage)(void *, void *), void *env, void *queues){ 
-    return stage(env, queues);
+  /*
+   * Start the generation.
+   */
+  auto nextSequence = (this->generation.load(std::memory_order_relaxed) >> HotTeam::workersBits) + 1;
+  this->generation.store((nextSequence << HotTeam::workersBits) | numberOfWorkers);
+  if (this->sleepingWorkers.load() > 0){
+    AdaptiveWait::futexWake(&this->generation, INT_MAX);
   }
 
-  static void NOELLE_DSWPTrampoline (void *args){
-
-    /*
-     * Fetch the arguments.
-     */
-    auto DSWPArgs = (NOELLE_DSWP_args_t *) args;
+  return true;
+}
 
-    /*
-     * Invoke
-     */
-    DSWPArgs->funcToInvoke(DSWPArgs->env, DSWPArgs->localQueues);
+void HotTeam::join (void){
 
-    pthread_mutex_unlock(&(DSWPArgs->endLock));
-    return ;
+  /*
+   * Wait for the workers of the current generation.
+   *
+   * We announce ourselves as sleeper before checking the counter one last time.
+   * This way, the last worker will see us and wake us up.
+   */
+  auto isDone = false;
+  for (int64_t i = 0; AdaptiveWait::shouldKeepSpinning(i); i++){
+    if (this->runningWorkers.load(std::memory_order_acquire) == 0){
+      isDone = true;
+      break ;
+    }
+    cpu_relax();
+  }
+  if (!isDone){
+    this->isJoinerSleeping.store(1);
+    while (true){
+      auto running = this->runningWorkers.load();
+      if (running == 0){
+        break ;
+      }
+      AdaptiveWait::futexWait(&this->runningWorkers, running);
+    }
+    this->isJoinerSleeping.store(0, std::memory_order_relaxed);
   }
 
-  DispatcherInfo NOELLE_DSWPDispatcher (
-    void *env, 
-    int64_t *queueSizes, 
-    void *stages, 
-    int64_t numberOfStages, 
-    int64_t numberOfQueues
-    ){
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Starting dispatcher: num stages " << numberOfStages << ", num queues: " << numberOfQueues << std::endl;
-    #endif
+  /*
+   * The team can start a new generation.
+   */
+  this->isBusy.store(false, std::memory_order_release);
 
-    /*
-     * Fetch VIRGIL
-     */
-    auto virgil = runtime.virgil;
+  return ;
+}
+
+void HotTeam::workerLoop (uint32_t workerID, int32_t logicalCore){
+  if (logicalCore >= 0){
+    CoreTopology::pinCurrentThread(logicalCore);
+  }
+
+  uint32_t lastGeneration = 0;
+  while (true){
 
     /*
-     * Reserve the cores.
+     * Wait for a new generation.
      */
-    auto numCores = runtime.reserveCores(numberOfStages);
-    assert(numCores >= 1);
+    auto currentGeneration = this->generation.load(std::memory_order_acquire);
+    for (int64_t i = 0; (currentGeneration == lastGeneration) && AdaptiveWait::shouldKeepSpinning(i); i++){
+      cpu_relax();
+      currentGeneration = this->generation.load(std::memory_order_acquire);
+    }
+    if (currentGeneration == lastGeneration){
+      this->sleepingWorkers.fetch_add(1);
+      while (true){
+        currentGeneration = this->generation.load();
+        if (currentGeneration != lastGeneration){
+          break ;
+        }
+        AdaptiveWait::futexWait(&this->generation, lastGeneration);
+      }
+      this->sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+    }
+    lastGeneration = currentGeneration;
+    if (!this->isAlive.load(std::memory_order_relaxed)){
+      break ;
+    }
 
     /*
-     * Allocate the communication queues.
+     * Check if we take part in the generation.
      */
-    void *localQueues[numberOfQueues];
-    for (auto i = 0; i < numberOfQueues; ++i) {
-      switch (queueSizes[i]) {
-        case 1:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int8_t>();
-          break;
-        case 8:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int8_t>();
-          break;
-        case 16:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int16_t>();
-          break;
-        case 32:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int32_t>();
-          break;
-        case 64:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int64_t>();
-          break;
-        default:
-          std::cerr << "NOELLE: Runtime: QUEUE SIZE INCORRECT" << std::endl;
-          abort();
-          break;
-      }
+    auto numberOfWorkers = currentGeneration & HotTeam::workersMask;
+    if (workerID >= numberOfWorkers){
+      continue ;
     }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Made queues" << std::endl;
-    #endif
 
     /*
-     * Allocate the memory to store the arguments.
+     * Run the task.
      */
-    auto argsForAllCores = (NOELLE_DSWP_args_t *) malloc(sizeof(NOELLE_DSWP_args_t) * numberOfStages);
+    this->task(this->args + (workerID * this->argsBytes));
 
     /*
-     * Submit DSWP tasks
+     * Notify the thread that started the generation if we are the last worker.
      */
-    auto allStages = (void **)stages;
-    for (auto i = 0; i < numberOfStages; ++i) {
+    if (  true
+          && (this->runningWorkers.fetch_sub(1) == 1)
+          && (this->isJoinerSleeping.load() != 0)
+       ){
+      AdaptiveWait::futexWake(&this->runningWorkers, 1);
+    }
+  }
 
-      /*
-       * Prepare the arguments.
-       */
-      auto argsPerCore = &argsForAllCores[i];
-      argsPerCore->funcToInvoke = reinterpret_cast<stageFunctionPtr_t>(reinterpret_cast<long long>(allStages[i]));
-      argsPerCore->env = env;
-      argsPerCore->localQueues = (void *) localQueues;
-      pthread_mutex_init(&(argsPerCore->endLock), NULL);
-      pthread_mutex_lock(&(argsPerCore->endLock));
+  return ;
+}
 
-      /*
-       * Submit
-       */
-      virgil->submitAndDetach(NOELLE_DSWPTrampoline, argsPerCore);
-      #ifdef RUNTIME_PRINT
-      std::cerr << "Submitted stage" << std::endl;
-      #endif
-    }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Submitted pool" << std::endl;
-    #endif
+HELIXHelperThread::HELIXHelperThread (int32_t logicalCore)
+  : isBusy{false}
+  , ssArray{nullptr}
+  , numOfsequentialSegments{0}
+  , loopCarriedArray{nullptr}
+  , loopCarriedArrayBytes{0}
+  , firstTicket{0}
+  , ticketStep{1}
+  , isStopRequested{false}
+  , isAlive{true}
+  {
+  this->startLock.initialize(false);
+  this->stoppedLock.initialize(false);
+  this->helper = std::thread(&HELIXHelperThread::helperLoop, this, logicalCore);
+
+  return ;
+}
+
+bool HELIXHelperThread::tryToStart (
+  HELIXSequentialSegment *ssArray,
+  int64_t numOfsequentialSegments,
+  void *loopCarriedArray,
+  int64_t loopCarriedArrayBytes,
+  int64_t firstTicket,
+  int64_t ticketStep
+  ){
+
+  /*
+   * Check if the helper is available.
+   */
+  auto expected = false;
+  if (!this->isBusy.compare_exchange_strong(expected, true)){
+    return false;
+  }
+
+  /*
+   * Describe the task to help and wake up the helper.
+   */
+  this->ssArray = ssArray;
+  this->numOfsequentialSegments = numOfsequentialSegments;
+  this->loopCarriedArray = loopCarriedArray;
+  this->loopCarriedArrayBytes = loopCarriedArrayBytes;
+  this->firstTicket = firstTicket;
+  this->ticketStep = ticketStep;
+  this->isStopRequested.store(false, std::memory_order_relaxed);
+  this->startLock.signal();
+
+  return true;
+}
+
+void HELIXHelperThread::stop (void){
+
+  /*
+   * Wait for the helper to stop touching the memory of the task.
+   */
+  this->isStopRequested.store(true, std::memory_order_relaxed);
+  this->stoppedLock.wait();
+  this->isBusy.store(false);
+
+  return ;
+}
+
+void HELIXHelperThread::helperLoop (int32_t logicalCore){
+  CoreTopology::pinCurrentThread(logicalCore);
+
+  while (true){
 
     /*
-     * Wait for the tasks to complete.
+     * Wait for a task to help.
      */
-    for (auto i = 0; i < numberOfStages; ++i) {
-      pthread_mutex_lock(&(argsForAllCores[i].endLock));
+    this->startLock.wait();
+    if (!this->isAlive.load()){
+      break ;
     }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Got all futures" << std::endl;
-    #endif
 
     /*
-     * Free the cores and memory.
+     * Help the task.
      */
-    runtime.releaseCores(numCores);
-    for (int i = 0; i < numberOfQueues; ++i) {
-      switch (queueSizes[i]) {
-        case 1:
-          delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
-          break;
-        case 8:
-          delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
-          break;
-        case 16:
-          delete (ThreadSafeLockFreeQueue<int16_t> *)(localQueues[i]);
-          break;
-        case 32:
-          delete (ThreadSafeLockFreeQueue<int32_t> *)(localQueues[i]);
-          break;
-        case 64:
-          delete (ThreadSafeLockFreeQueue<int64_t> *)(localQueues[i]);
-          break;
-      }
-    }
-    free(argsForAllCores);
-
-    #ifdef DSWP_STATS
-    std::cout << "DSWP: 1 Byte pushes = " << numberOfPushes8 << std::endl;
-    std::cout << "DSWP: 2 Bytes pushes = " << numberOfPushes16 << std::endl;
-    std::cout << "DSWP: 4 Bytes pushes = " << numberOfPushes32 << std::endl;
-    std::cout << "DSWP: 8 Bytes pushes = " << numberOfPushes64 << std::endl;
-    #endif
-
-    DispatcherInfo dispatcherInfo;
-    dispatcherInfo.numberOfThreadsUsed = numberOfStages;
-    return dispatcherInfo;
+    HELIX_helperThread(this->ssArray, this->numOfsequentialSegments, this->loopCarriedArray, this->loopCarriedArrayBytes, this->firstTicket, this->ticketStep, &this->isStopRequested);
+    this->stoppedLock.signal();
   }
 
+  return ;
 }
 
-NoelleRuntime::NoelleRuntime() {
-  this->maxCores = this->getMaximumNumberOfCores();
-  this->NOELLE_idleCores = maxCores;
+HELIXHelperThread::~HELIXHelperThread (void){
+  this->isAlive.store(false);
+  this->startLock.signal();
+  this->helper.join();
 
-  pthread_spin_init(&this->spinLock, 0);
-  pthread_spin_init(&this->doallMemoryLock, 0);
-  #ifdef RUNTIME_PROFILE
-  pthread_spin_init(&printLock, 0);
-  #endif
+  return ;
+}
+
+HotTeam::~HotTeam (void){
 
   /*
-   * Allocate VIRGIL
+   * Stop the workers.
+   * They notice it with a new generation without workers.
    */
-  this->virgil = new ThreadPoolForCSingleQueue(false, maxCores);
+  this->isAlive.store(false, std::memory_order_relaxed);
+  auto nextSequence = (this->generation.load(std::memory_order_relaxed) >> HotTeam::workersBits) + 1;
+  this->generation.store(nextSequence << HotTeam::workersBits);
+  AdaptiveWait::futexWake(&this->generation, INT_MAX);
+  for (auto &worker : this->workers){
+    worker.join();
+  }
 
   return ;
 }
 
-DOALL_args_t * NoelleRuntime::getDOALLArgs (uint32_t cores, uint32_t *index){
-  DOALL_args_t *argsForAllCores = nullptr;
+CoreTopology::CoreTopology (){
 
   /*
-   * Check if we can reuse a previously-allocated memory region.
+   * Fetch the logical cores the process can run on.
    */
-  pthread_spin_lock(&this->doallMemoryLock);
-  auto doallMemoryNumberOfChunks = this->doallMemoryAvailability.size();
-  for (auto i=0; i < doallMemoryNumberOfChunks; i++){
-    auto currentSize = this->doallMemorySizes[i];
-    if (  true
-          && (this->doallMemoryAvailability[i])
-          && (currentSize >= cores)
-       ){
-
-      /*
-       * Found a memory block that can be reused.
-       */
-      argsForAllCores = this->doallMemory[i];
-
-      /*
-       * Set the block as in use.
-       */
-      this->doallMemoryAvailability[i] = false;
-      (*index) = i;
-      pthread_spin_unlock(&this->doallMemoryLock);
-
-      return argsForAllCores;
+  std::vector<int32_t> logicalCores;
+  cpu_set_t allowedCores;
+  CPU_ZERO(&allowedCores);
+  if (sched_getaffinity(0, sizeof(allowedCores), &allowedCores) == 0){
+    for (auto i = 0; i < CPU_SETSIZE; i++){
+      if (CPU_ISSET(i, &allowedCores)){
+        logicalCores.push_back(i);
+      }
+    }
+  }
+  if (logicalCores.size() == 0){
+    auto numberOfLogicalCores = std::thread::hardware_concurrency();
+    for (uint32_t i = 0; i < numberOfLogicalCores; i++){
+      logicalCores.push_back(i);
     }
   }
 
   /*
-   * We couldn't find anything available.
-   *
-   * Allocate a new memory region.
+   * Fetch the NUMA node of each logical core.
    */
-  this->doallMemorySizes.push_back(cores);
-  this->doallMemoryAvailability.push_back(false);
-  posix_memalign((void **)&argsForAllCores, CACHE_LINE_SIZE, sizeof(DOALL_args_t) * cores);
-  this->doallMemory.push_back(argsForAllCores);
-  pthread_spin_unlock(&this->doallMemoryLock);
+  auto NUMANodes = SysfsTopology::readNUMANodes();
 
   /*
-   * Set the index.
+   * Describe every logical core by the physical core, the caches, and the NUMA node it belongs to.
    */
-  (*index) = doallMemoryNumberOfChunks;
+  typedef std::tuple<int32_t, int32_t, int32_t, int32_t> CoreLocation_t;
+  std::unordered_map<int32_t, CoreLocation_t> locations;
+  auto isTopologyAvailable = true;
+  for (auto core : logicalCores){
+    SysfsTopology::LogicalCore location;
+    if (!SysfsTopology::readLogicalCore(core, location)){
+      isTopologyAvailable = false;
+      break ;
+    }
+    for (auto sibling : location.SMTSiblings){
+      if (  true
+            && (static_cast<int32_t>(sibling) != core)
+            && (std::find(logicalCores.begin(), logicalCores.end(), sibling) != logicalCores.end())
+         ){
+        this->smtSiblings[core] = sibling;
+        break ;
+      }
+    }
 
-  /*
-   * Initialize the memory.
-   */ 
-  for (auto i = 0; i < cores; ++i) {
-    auto argsPerCore = &argsForAllCores[i];
-    argsPerCore->coreID = i;
-    pthread_spin_init(&(argsPerCore->endLock), 0);
-    pthread_spin_lock(&(argsPerCore->endLock));
+    auto node = (NUMANodes.find(core) != NUMANodes.end()) ? NUMANodes[core] : 0;
+    locations[core] = std::make_tuple(node, location.lastLevelCache, location.secondLevelCache, location.physicalCore);
   }
 
-  return argsForAllCores;
-}
-
-void NoelleRuntime::releaseDOALLArgs (uint32_t index){
-  pthread_spin_lock(&this->doallMemoryLock);
-  this->doallMemoryAvailability[index] = true;
-  pthread_spin_unlock(&this->doallMemoryLock);
-  return ;
-}
-
-uint32_t NoelleRuntime::reserveCores (uint32_t coresRequested){
- 
   /*
-   * Reserve the number of cores available.
+   * Check if we could read the topology.
    */
-  pthread_spin_lock(&this->spinLock);
-  auto numCores = (this->NOELLE_idleCores >= coresRequested) ? coresRequested : NOELLE_idleCores;
-  if (numCores < 1){
-    numCores = 1;
+  if (!isTopologyAvailable){
+    this->placement = logicalCores;
+    this->physicalCores = logicalCores.size() / 2;
+    if (this->physicalCores == 0){
+      this->physicalCores = 1;
+    }
+    return ;
   }
-  this->NOELLE_idleCores -= numCores;
-  pthread_spin_unlock(&this->spinLock);
 
-  return numCores;
-}
-    
-void NoelleRuntime::releaseCores (uint32_t coresReleased){
-  assert(coresReleased > 0);
+  /*
+   * Fetch the location of the logical core the process started on.
+   */
+  auto startingCore = sched_getcpu();
+  if (locations.find(startingCore) == locations.end()){
+    startingCore = logicalCores[0];
+  }
+  auto startingLocation = locations[startingCore];
 
-  pthread_spin_lock(&this->spinLock);
-  this->NOELLE_idleCores += coresReleased;
-  #ifdef DEBUG
-  if (this->NOELLE_idleCores >= 0){
-    assert(this->NOELLE_idleCores <= ((uint32_t)this->maxCores));
+  /*
+   * Sort the logical cores.
+   *
+   * A location closer to the starting one comes first.
+   * SMT siblings of a physical core that is already in the placement come after all physical cores.
+   */
+  std::set<int32_t> physicalCoresPlaced;
+  std::vector<int32_t> firstSiblings;
+  std::vector<int32_t> otherSiblings;
+  auto distance = [&locations, &startingLocation, startingCore](int32_t core) -> std::tuple<bool, int32_t, bool, int32_t, bool, int32_t, bool, int32_t, bool, int32_t> {
+    auto &l = locations[core];
+    return std::make_tuple(
+      std::get<0>(l) != std::get<0>(startingLocation), std::get<0>(l),
+      std::get<1>(l) != std::get<1>(startingLocation), std::get<1>(l),
+      std::get<2>(l) != std::get<2>(startingLocation), std::get<2>(l),
+      std::get<3>(l) != std::get<3>(startingLocation), std::get<3>(l),
+      core != startingCore, core
+    );
+  };
+  std::sort(logicalCores.begin(), logicalCores.end(), [&distance](int32_t c1, int32_t c2) -> bool {
+    return distance(c1) < distance(c2);
+  });
+  for (auto core : logicalCores){
+    auto physicalCore = std::get<3>(locations[core]);
+    if (physicalCoresPlaced.find(physicalCore) == physicalCoresPlaced.end()){
+      physicalCoresPlaced.insert(physicalCore);
+      firstSiblings.push_back(core);
+    } else {
+      otherSiblings.push_back(core);
+    }
   }
-  #endif
-  pthread_spin_unlock(&this->spinLock);
+  this->placement = firstSiblings;
+  this->placement.insert(this->placement.end(), otherSiblings.begin(), otherSiblings.end());
+  this->physicalCores = physicalCoresPlaced.size();
 
   return ;
 }
 
-uint32_t NoelleRuntime::getMaximumNumberOfCores (void){
-  static int cores = 0;
-
-  /*
-   * Check if we have already computed the number of cores.
-   */
-  if (cores == 0){
+uint32_t CoreTopology::getNumberOfPhysicalCores (void) const {
+  return this->physicalCores;
+}
 
-    /*
-     * Compute the number of cores.
-     */
-    auto envVar = getenv("NOELLE_CORES");
-    if (envVar == nullptr){
-      cores = (std::thread::hardware_concurrency() / 2) - 1;
-    } else {
-      cores = atoi(envVar);
-    }
+int32_t CoreTopology::getSMTSibling (int32_t logicalCore) const {
+  auto siblingIt = this->smtSiblings.find(logicalCore);
+  if (siblingIt == this->smtSiblings.end()){
+    return -1;
   }
 
-  return cores;
+  return siblingIt->second;
 }
-    
-NoelleRuntime::~NoelleRuntime(void){
-  delete this->virgil;
+
+void CoreTopology::pinCurrentThread (int32_t logicalCore){
+  cpu_set_t cores;
+  CPU_ZERO(&cores);
+  CPU_SET(logicalCore, &cores);
+  pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores);
+
+  return ;
 }
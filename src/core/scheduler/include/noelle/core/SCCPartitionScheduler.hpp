@@ -29,6 +29,12 @@ namespace llvm::noelle {
 
       bool squeezePartitions (void) ;
 
+      /*
+       * Move the instructions that belong to no partition out of the code that goes from the first to the last instruction of a partition within a basic block.
+       * Instructions the rest of the partition depends on are hoisted before it, the others are sunk after it.
+       */
+      bool moveUnrelatedInstructionsOutOfPartitions (void) ;
+
     private:
       SCCDAG *loopSCCDAG;
       std::unordered_set<SCCSet *> sccPartitions;
@@ -47,10 +53,15 @@ namespace llvm::noelle {
 
       SCCSet *getPartition (Instruction *I) ;
 
+      void mapSCCsToPartitions (void) ;
+
+      bool moveUnrelatedInstructionsOutOfPartition (SCCSet *partition, BasicBlock *B) ;
+
       Instruction *hoistInstructionTowards (Instruction *instructionToMove, Instruction *target) ;
       Instruction *sinkInstructionTowards (Instruction *instructionToMove, Instruction *target) ;
 
       std::unordered_set<Instruction *> collectDependedOnInstructionsWithinBlock (Instruction *I) ;
+      std::unordered_set<Instruction *> collectDependentInstructionsWithinBlock (Instruction *I) ;
 
   };
 
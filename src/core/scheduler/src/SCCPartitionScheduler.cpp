@@ -20,17 +20,23 @@ SCCPartitionScheduler::SCCPartitionScheduler(
 ) : loopSCCDAG{loopSCCDAG}, sccPartitions{sccPartitions}, reachabilityDFR{reachabilityDFR} {
 }
 
+void SCCPartitionScheduler::mapSCCsToPartitions (void) {
+  for (auto partition : sccPartitions) {
+    for (auto scc : partition->sccs) {
+      sccToPartitionMap[scc] = partition;
+    }
+  }
+
+  return ;
+}
+
 bool SCCPartitionScheduler::squeezePartitions (void) {
   auto modified = false;
 
   /*
    * Collect a mapping between a SCC and its partition
    */
-  for (auto partition : sccPartitions) {
-    for (auto scc : partition->sccs) {
-      sccToPartitionMap[scc] = partition;
-    }
-  }
+  this->mapSCCsToPartitions();
 
   /*
    * Collect reverse reachability OUT sets
@@ -155,6 +161,115 @@ bool SCCPartitionScheduler::squeezePartitions (void) {
   return modified;
 }
 
+bool SCCPartitionScheduler::moveUnrelatedInstructionsOutOfPartitions (void) {
+  auto modified = false;
+
+  /*
+   * Collect a mapping between a SCC and its partition
+   */
+  this->mapSCCsToPartitions();
+
+  /*
+   * Fetch the function that includes the partitions.
+   */
+  Function *function = nullptr;
+  for (auto partition : sccPartitions) {
+    for (auto scc : partition->sccs) {
+      scc->iterateOverInstructions([&function](Instruction *I) -> bool {
+        function = I->getFunction();
+        return true;
+      });
+      if (function != nullptr) break;
+    }
+    if (function != nullptr) break;
+  }
+  if (function == nullptr) return false;
+
+  /*
+   * Visit the basic blocks and the partitions within them in the order they appear.
+   * This way, the same code is generated at every compilation.
+   */
+  for (auto &B : *function) {
+    std::vector<SCCSet *> partitionsInBlock{};
+    for (auto &I : B) {
+      if (isa<PHINode>(&I) || I.isTerminator()) continue;
+      auto partitionOfI = getPartition(&I);
+      if (partitionOfI == nullptr) continue;
+      if (std::find(partitionsInBlock.begin(), partitionsInBlock.end(), partitionOfI) != partitionsInBlock.end()) continue;
+      partitionsInBlock.push_back(partitionOfI);
+    }
+
+    /*
+     * Moving an instruction out of a partition might move it within another one that interleaves with the first.
+     * We do not iterate until nothing changes as hoisting and sinking the same instruction for different partitions might never end.
+     */
+    for (auto partition : partitionsInBlock) {
+      modified |= moveUnrelatedInstructionsOutOfPartition(partition, &B);
+    }
+  }
+
+  return modified;
+}
+
+bool SCCPartitionScheduler::moveUnrelatedInstructionsOutOfPartition (SCCSet *partition, BasicBlock *B) {
+  auto modified = false;
+
+  /*
+   * Find the first and the last instructions of the partition within the block.
+   */
+  Instruction *firstInst = nullptr;
+  Instruction *lastInst = nullptr;
+  for (auto &I : *B) {
+    if (isa<PHINode>(&I) || I.isTerminator()) continue;
+    if (getPartition(&I) != partition) continue;
+    if (firstInst == nullptr) firstInst = &I;
+    lastInst = &I;
+  }
+  if (firstInst == lastInst) return false;
+
+  /*
+   * Collect the instructions in between that belong to no partition.
+   * Instructions that are not in the SCCDAG (e.g., added after the dependences have been computed) stay where they are.
+   */
+  auto collectUnrelatedInstructions = [this, &firstInst, &lastInst]() -> std::vector<Instruction *> {
+    std::vector<Instruction *> unrelatedInstructions{};
+    for (auto I = firstInst->getNextNode(); I != lastInst; I = I->getNextNode()) {
+      if (!loopSCCDAG->doesItContain(I)) continue;
+      if (getPartition(I) != nullptr) continue;
+      unrelatedInstructions.push_back(I);
+    }
+    return unrelatedInstructions;
+  };
+
+  /*
+   * Sink the instructions that the rest of the partition does not depend on right after the partition.
+   * They are visited bottom-up so each of them ends up before the ones sunk earlier, which keeps their original order.
+   */
+  auto instructionsToSink = collectUnrelatedInstructions();
+  for (auto it = instructionsToSink.rbegin(); it != instructionsToSink.rend(); ++it) {
+    auto I = *it;
+    auto initialNextNode = I->getNextNode();
+    sinkInstructionTowards(I, lastInst);
+    modified |= initialNextNode != I->getNextNode();
+  }
+
+  /*
+   * Hoist the remaining ones before the partition, if their dependences allow it.
+   * Each instruction hoisted all the way becomes the target of the next one to keep their original order.
+   */
+  auto hoistTarget = firstInst->getPrevNode();
+  for (auto I : collectUnrelatedInstructions()) {
+    auto initialNextNode = I->getNextNode();
+    hoistInstructionTowards(I, hoistTarget);
+    modified |= initialNextNode != I->getNextNode();
+    if (I->getPrevNode() == hoistTarget) {
+      hoistTarget = I;
+    }
+  }
+
+  return modified;
+}
+
 SCCSet *SCCPartitionScheduler::getPartition (Instruction *I) {
   auto scc = loopSCCDAG->sccOfValue(I);
   if (sccToPartitionMap.find(scc) == sccToPartitionMap.end()) return nullptr;
@@ -176,6 +291,17 @@ Instruction *SCCPartitionScheduler::hoistInstructionTowards (Instruction *instru
   auto instructionToHoistTo = instructionToMove;
   while (instructionToHoistTo && (target != instructionToHoistTo)) {
     if (consumedInstructions.find(instructionToHoistTo) != consumedInstructions.end()) break;
+
+    /*
+     * Instructions cannot be hoisted above PHIs.
+     * Also, we do not know the dependences of instructions that are not in the SCCDAG.
+     */
+    if (  false
+          || isa<PHINode>(instructionToHoistTo)
+          || ((instructionToHoistTo != instructionToMove) && !loopSCCDAG->doesItContain(instructionToHoistTo))
+       ) {
+      break;
+    }
     instructionToHoistTo = instructionToHoistTo->getPrevNode();
   }
 
@@ -201,7 +327,40 @@ Instruction *SCCPartitionScheduler::hoistInstructionTowards (Instruction *instru
 }
 
 Instruction *SCCPartitionScheduler::sinkInstructionTowards (Instruction *instructionToMove, Instruction *target) {
-  return nullptr;
+  if (target == instructionToMove) return instructionToMove;
+
+  /*
+   * Identify all instructions of the block that depend on the instruction to move
+   */
+  std::unordered_set<Instruction *> dependentInstructions = collectDependentInstructionsWithinBlock(instructionToMove);
+
+  /*
+   * Search the basic block from the instruction to move down
+   * until the target, a dependent instruction, or the terminator is reached
+   */
+  auto instructionToSinkTo = instructionToMove->getNextNode();
+  while (!instructionToSinkTo->isTerminator()) {
+    if (dependentInstructions.find(instructionToSinkTo) != dependentInstructions.end()) break;
+    if (!loopSCCDAG->doesItContain(instructionToSinkTo)) break;
+
+    /*
+     * The target has been reached, so we sink right after it
+     */
+    if (instructionToSinkTo == target) {
+      instructionToMove->moveAfter(target);
+      return instructionToMove;
+    }
+    instructionToSinkTo = instructionToSinkTo->getNextNode();
+  }
+
+  /*
+   * Some instruction we cannot sink past was found,
+   * so we sink right before that instruction
+   */
+  if (instructionToSinkTo != instructionToMove->getNextNode()) {
+    instructionToMove->moveBefore(instructionToSinkTo);
+  }
+  return instructionToMove;
 }
 
 std::unordered_set<Instruction *> SCCPartitionScheduler::collectDependedOnInstructionsWithinBlock (Instruction *I) {
@@ -244,3 +403,44 @@ std::unordered_set<Instruction *> SCCPartitionScheduler::collectDependedOnInstru
 
   return consumedInstructions;
 }
+
+std::unordered_set<Instruction *> SCCPartitionScheduler::collectDependentInstructionsWithinBlock (Instruction *I) {
+
+  std::unordered_set<Instruction *> dependentInstructions;
+  auto blockOfI = I->getParent();
+  auto sccOfI = loopSCCDAG->sccOfValue(I);
+  auto nodeOfI = sccOfI->fetchNode(I);
+
+  std::queue<DGNode<Value> *> nodes;
+  nodes.push(nodeOfI);
+  while (!nodes.empty()) {
+    auto node = nodes.front();
+    nodes.pop();
+
+    for (auto edge : node->getOutgoingEdges()) {
+
+      /*
+       * Ignore self edges
+       */
+      auto dependentNode = edge->getIncomingNode();
+      auto dependentValue = edge->getIncomingT();
+      if (dependentValue == I) continue;
+
+      /*
+       * Only catalog dependent instructions within the producer's basic block
+       * Ignore already cataloged instructions
+       */
+      if (auto dependentInst = dyn_cast<Instruction>(dependentValue)) {
+        auto dependentBlock = dependentInst->getParent();
+        if (dependentBlock != blockOfI) continue;
+
+        if (dependentInstructions.find(dependentInst) != dependentInstructions.end()) continue;
+        dependentInstructions.insert(dependentInst);
+
+        nodes.push(dependentNode);
+      }
+    }
+  }
+
+  return dependentInstructions;
+}
@@ -33,7 +33,8 @@ namespace llvm::noelle {
 
   enum LoopDependenceInfoOptimization {
     MEMORY_CLONING_ID,
-    THREAD_SAFE_LIBRARY_ID
+    THREAD_SAFE_LIBRARY_ID,
+    RUNTIME_ALIAS_CHECKS_ID
   };
 
 }
@@ -18,6 +18,7 @@
 #include "noelle/core/PDGAnalysis.hpp"
 #include "noelle/core/Noelle.hpp"
 #include "noelle/core/IVStepperUtility.hpp"
+#include "noelle/core/Utils.hpp"
 #include "noelle/tools/ParallelizationTechnique.hpp"
 #include "HeuristicsPass.hpp"
 
@@ -26,11 +27,22 @@ namespace llvm::noelle {
   class DOALL : public ParallelizationTechnique {
     public:
 
+      /*
+       * Policies to assign chunks of iterations to threads.
+       * These values must match the ones used by NOELLE_DOALLDispatcher.
+       *
+       * DETERMINISTIC assigns chunks to task instances like STATIC does, but the number of task instances does not depend on the number of threads that run them.
+       * Hence, reduced variables are accumulated the same way by every invocation of the loop.
+       */
+      enum ChunkScheduling {STATIC = 0, DYNAMIC = 1, GUIDED = 2, DETERMINISTIC = 3};
+
       /*
        * Methods
        */
       DOALL (
-        Noelle &noelle
+        Noelle &noelle,
+        bool deterministicReductions,
+        bool asynchronousDispatch
       );
 
       bool apply (
@@ -48,9 +60,38 @@ namespace llvm::noelle {
         Noelle &par
       ) ;
 
+      /*
+       * Objects allocated by the loop (e.g., with malloc) that are never used outside the iteration that allocates them.
+       * The returned map goes from every pointer to such objects to the call that allocates the object pointed to.
+       */
+      static std::unordered_map<Value *, CallBase *> getPointersToIterationPrivateObjects (
+        LoopStructure *loopStructure
+      ) ;
+
+      static bool accessesOnlyIterationPrivateObjects (
+        Instruction *inst,
+        const std::unordered_map<Value *, CallBase *> &privatePointers
+      ) ;
+
+      ChunkScheduling chooseChunkScheduling (
+        LoopDependenceInfo *LDI
+      ) const ;
+
+      Function * getTaskFunction (void) const ;
+
     protected:
       bool enabled;
       Function *taskDispatcher;
+      Function *asynchronousTaskDispatcher;
+      Function *joinTasks;
+      Function *claimChunk;
+      Function *cancelLoop;
+      Function *arenaMalloc;
+      Function *arenaCalloc;
+      Function *arenaFree;
+      ChunkScheduling scheduling;
+      bool deterministicReductions;
+      bool asynchronousDispatch;
       Noelle &n;
 
       /*
@@ -68,6 +109,46 @@ namespace llvm::noelle {
 
       void addJumpToLoop (LoopDependenceInfo *LDI, Task *t);
 
+      /*
+       * Allocate the objects private to iterations (see getPointersToIterationPrivateObjects) from the per-thread arena of the runtime.
+       */
+      void allocateIterationPrivateObjectsFromArena (
+        LoopDependenceInfo *LDI
+      );
+
+      /*
+       * Asynchronous dispatch.
+       *
+       * The parallelized loop is started without waiting for it to end.
+       * The code that follows the loop and that does not depend on it runs while the loop does, and the join is postponed to the latest point where it is needed.
+       */
+      bool canDeferTheJoin (
+        LoopDependenceInfo *LDI
+      ) const ;
+
+      Instruction * findTheLatestPointToJoin (
+        LoopDependenceInfo *LDI
+      ) ;
+
+      /*
+       * Early exits (i.e., exits other than the one taken when the loop-governing IV reaches its last value).
+       *
+       * The earliest iteration that takes an early exit cancels the chunks of iterations that start after it.
+       * Task instances check whether their next chunk has been cancelled when they claim it.
+       */
+      bool canCancelTheLoopAtEarlyExits (
+        LoopDependenceInfo *LDI
+      ) const ;
+
+      uint32_t getIndexOfTheExitOfTheLoopGoverningIV (
+        LoopDependenceInfo *LDI
+      ) const ;
+
+      void cancelTheLoopAtEarlyExits (
+        LoopDependenceInfo *LDI,
+        Value *currentIteration
+      );
+
       /*
        * Helpers
        */
@@ -33,6 +33,11 @@ namespace llvm::noelle {
        */
       Value *coreArg, *numCoresArg, *chunkSizeArg;
 
+      /*
+       * State used to claim chunks at run time (null for the static scheduling)
+       */
+      Value *scheduleArg;
+
       /*
        * Clone of original IV loop, new outer loop
        */
@@ -13,6 +13,100 @@
 
 namespace llvm::noelle { 
 
+void DOALL::allocateIterationPrivateObjectsFromArena (
+  LoopDependenceInfo *LDI
+  ){
+
+  /*
+   * Check if the runtime provides the arena.
+   */
+  if (  false
+        || (this->arenaMalloc == nullptr)
+        || (this->arenaCalloc == nullptr)
+        || (this->arenaFree == nullptr)
+     ){
+    return ;
+  }
+
+  /*
+   * Fetch the objects that never outlive their iteration.
+   */
+  auto task = tasks[0];
+  auto loopStructure = LDI->getLoopStructure();
+  auto privatePointers = DOALL::getPointersToIterationPrivateObjects(loopStructure);
+
+  /*
+   * Fetch the calls that free them.
+   */
+  std::unordered_map<CallBase *, std::vector<CallBase *>> deallocatorCalls;
+  for (auto inst : loopStructure->getInstructions()){
+    auto callInst = dyn_cast<CallBase>(inst);
+    if (!Utils::isDeallocator(callInst)){
+      continue ;
+    }
+    auto freedObject = Utils::getFreedObject(callInst);
+    if (privatePointers.find(freedObject) == privatePointers.end()){
+      continue ;
+    }
+    auto allocatorCall = privatePointers.at(freedObject);
+    deallocatorCalls[allocatorCall].push_back(callInst);
+  }
+
+  /*
+   * Redirect the clones of the allocations and deallocations to the arena.
+   *
+   * An object must be both allocated and freed by the arena.
+   * Hence, an object is redirected only if the arena can replace all functions used for it.
+   */
+  auto arenaFunctionOf = [this](CallBase *call) -> Function * {
+    auto callee = call->getCalledFunction();
+    Function *arenaFunction = nullptr;
+    if (Utils::isDeallocator(call)){
+      arenaFunction = this->arenaFree;
+    } else if (callee->getName() == "malloc"){
+      arenaFunction = this->arenaMalloc;
+    } else if (callee->getName() == "calloc"){
+      arenaFunction = this->arenaCalloc;
+    }
+    if (  false
+          || (arenaFunction == nullptr)
+          || (arenaFunction->getFunctionType() != callee->getFunctionType())
+       ){
+      return nullptr;
+    }
+
+    return arenaFunction;
+  };
+  for (auto &pointerAndAllocator : privatePointers){
+    auto allocatorCall = pointerAndAllocator.second;
+    if (pointerAndAllocator.first != allocatorCall){
+      continue ;
+    }
+    std::vector<CallBase *> callsToRedirect{ allocatorCall };
+    auto &deallocatorsOfObject = deallocatorCalls[allocatorCall];
+    callsToRedirect.insert(callsToRedirect.end(), deallocatorsOfObject.begin(), deallocatorsOfObject.end());
+    auto canBeRedirected = true;
+    for (auto call : callsToRedirect){
+      if (arenaFunctionOf(call) == nullptr){
+        canBeRedirected = false;
+        break ;
+      }
+    }
+    if (!canBeRedirected){
+      continue ;
+    }
+    for (auto call : callsToRedirect){
+      auto callClone = cast<CallBase>(task->getCloneOfOriginalInstruction(call));
+      callClone->setCalledFunction(arenaFunctionOf(call));
+    }
+    if (this->verbose >= Verbosity::Maximal) {
+      errs() << "DOALL:  Allocate " << *allocatorCall << " from the arena of the runtime\n";
+    }
+  }
+
+  return ;
+}
+
 void DOALL::rewireLoopToIterateChunks (
   LoopDependenceInfo *LDI
   ){
@@ -34,13 +128,88 @@ void DOALL::rewireLoopToIterateChunks (
   auto allIVInfo = LDI->getInductionVariableManager();
 
   /*
-   * Generate PHI to track progress on the current chunk
+   * Check if chunks are assigned to task instances statically.
+   * This is the case for the deterministic scheduling too, which only changes how the runtime assigns task instances to threads.
+   */
+  auto hasStaticChunks = false
+    || (this->scheduling == ChunkScheduling::STATIC)
+    || (this->scheduling == ChunkScheduling::DETERMINISTIC);
+
+  /*
+   * Fetch the first iteration of the first chunk executed by the task.
+   *
+   * With the static scheduling, this is core_id * chunk_size.
+   * Otherwise, the chunk (and its size) is claimed from the runtime.
    */
   IRBuilder<> entryBuilder(task->getEntry());
   auto jumpToLoop = task->getEntry()->getTerminator();
   entryBuilder.SetInsertPoint(jumpToLoop);
   auto chunkCounterType = task->chunkSizeArg->getType();
-  auto chunkPHI = IVUtility::createChunkPHI(preheaderClone, headerClone, chunkCounterType, task->chunkSizeArg);
+  Value *firstIterationOfChunk = nullptr;
+  Value *chunkSize = task->chunkSizeArg;
+  PHINode *chunkSizePHI = nullptr;
+  if (hasStaticChunks){
+    firstIterationOfChunk = entryBuilder.CreateMul(task->coreArg, task->chunkSizeArg, "coreIdx_X_chunkSize");
+
+  } else {
+    auto firstChunk = entryBuilder.CreateCall(this->claimChunk, ArrayRef<Value *>({ task->scheduleArg }));
+    firstIterationOfChunk = entryBuilder.CreateExtractValue(firstChunk, (uint64_t)0, "firstIterationOfChunk");
+    auto sizeOfFirstChunk = entryBuilder.CreateExtractValue(firstChunk, (uint64_t)1, "sizeOfFirstChunk");
+
+    /*
+     * The first chunk is empty if an earlier iteration left the loop before the task started (see cancelTheLoopAtEarlyExits).
+     * In this case, the task ends without taking any exit of the loop.
+     *
+     * The code that prepares the loop moves to a new block that becomes the predecessor of the header within the task.
+     */
+    if (loopSummary->getLoopExitBasicBlocks().size() > 1){
+      auto entryBB = task->getEntry();
+      preheaderClone = entryBB->splitBasicBlock(jumpToLoop->getIterator(), "firstChunk");
+      task->addBasicBlock(loopPreHeader, preheaderClone);
+      entryBB->getTerminator()->eraseFromParent();
+      IRBuilder<> cancelBuilder(entryBB);
+      auto isCancelled = cancelBuilder.CreateICmpEQ(sizeOfFirstChunk, ConstantInt::get(chunkCounterType, 0));
+      cancelBuilder.CreateCondBr(isCancelled, task->getExit(), preheaderClone);
+    }
+
+    /*
+     * The size of chunks can change over time (e.g., guided scheduling).
+     * Keep track of the size of the current chunk.
+     */
+    IRBuilder<> headerBuilder(headerClone->getFirstNonPHI());
+    chunkSizePHI = headerBuilder.CreatePHI(chunkCounterType, pred_size(headerClone), "chunkSize");
+    for (auto B : predecessors(headerClone)){
+      chunkSizePHI->addIncoming(B == preheaderClone ? sizeOfFirstChunk : chunkSizePHI, B);
+    }
+    chunkSize = chunkSizePHI;
+  }
+
+  /*
+   * Keep track of the iteration executed if the loop has more than one exit.
+   * This is needed to tell the runtime which iteration left the loop (see cancelTheLoopAtEarlyExits).
+   *
+   * The iteration starts from the first one of the chunk and it is incremented at every latch.
+   * Chunks are claimed at run time for such loops, so the claim of a new chunk resets it (see below).
+   */
+  PHINode *iterationPHI = nullptr;
+  Instruction *nextIteration = nullptr;
+  auto hasMoreThanOneExit = (loopSummary->getLoopExitBasicBlocks().size() > 1);
+  if (hasMoreThanOneExit){
+    assert(!hasStaticChunks);
+    IRBuilder<> headerBuilder(headerClone->getFirstNonPHI());
+    iterationPHI = headerBuilder.CreatePHI(chunkCounterType, pred_size(headerClone), "iteration");
+    headerBuilder.SetInsertPoint(headerClone->getFirstNonPHI());
+    nextIteration = cast<Instruction>(headerBuilder.CreateAdd(iterationPHI, ConstantInt::get(chunkCounterType, 1), "nextIteration"));
+    for (auto B : predecessors(headerClone)){
+      iterationPHI->addIncoming(B == preheaderClone ? firstIterationOfChunk : nextIteration, B);
+    }
+    this->cancelTheLoopAtEarlyExits(LDI, iterationPHI);
+  }
+
+  /*
+   * Generate PHI to track progress on the current chunk
+   */
+  auto chunkPHI = IVUtility::createChunkPHI(preheaderClone, headerClone, chunkCounterType, chunkSize);
 
   /*
    * Collect clones of step size deriving values for all induction variables
@@ -50,7 +219,7 @@ void DOALL::rewireLoopToIterateChunks (
 
   /*
    * Determine start value of the IV for the task
-   * core_start: original_start + original_step_size * core_id * chunk_size
+   * core_start: original_start + original_step_size * first_iteration_of_chunk
    */
   for (auto ivInfo : allIVInfo->getInductionVariables(*loopSummary)) {
     auto startOfIV = fetchClone(ivInfo->getStartValue());
@@ -66,8 +235,7 @@ void DOALL::rewireLoopToIterateChunks (
     //   ),
     //   "stepSize_X_coreIdx_X_chunkSize"
     // );
-    auto nthCoreOffset = IVUtility::scaleInductionVariableStep(preheaderClone, ivPHI, stepOfIV,
-        entryBuilder.CreateMul(task->coreArg, task->chunkSizeArg, "coreIdx_X_chunkSize"));
+    auto nthCoreOffset = IVUtility::scaleInductionVariableStep(preheaderClone, ivPHI, stepOfIV, firstIterationOfChunk);
 
     auto offsetStartValue = IVUtility::offsetIVPHI(preheaderClone, ivPHI, startOfIV, nthCoreOffset);
     ivPHI->setIncomingValueForBlock(preheaderClone, offsetStartValue);
@@ -77,8 +245,14 @@ void DOALL::rewireLoopToIterateChunks (
    * Determine additional step size from the beginning of the next core's chunk
    * to the start of this core's next chunk
    * chunk_step_size: original_step_size * (num_cores - 1) * chunk_size
+   *
+   * This is needed only by the static scheduling.
+   * Other schedulings jump to the next chunk claimed from the runtime (see below).
    */
   for (auto ivInfo : allIVInfo->getInductionVariables(*loopSummary)) {
+    if (!hasStaticChunks){
+      break ;
+    }
     auto stepOfIV = clonedStepSizeMap.at(ivInfo);
     auto ivPHI = cast<PHINode>(fetchClone(ivInfo->getLoopEntryPHI()));
     auto onesValueForChunking = ConstantInt::get(chunkCounterType, 1);
@@ -113,6 +287,9 @@ void DOALL::rewireLoopToIterateChunks (
   auto cmpInst = cast<CmpInst>(task->getCloneOfOriginalInstruction(loopGoverningIVAttr->getHeaderCompareInstructionToComputeExitCondition()));
   auto brInst = cast<BranchInst>(task->getCloneOfOriginalInstruction(loopGoverningIVAttr->getHeaderBrInst()));
   auto basicBlockToJumpToWhenTheLoopEnds = task->getLastBlock(0);
+  if (hasMoreThanOneExit){
+    basicBlockToJumpToWhenTheLoopEnds = task->getLastBlock(this->getIndexOfTheExitOfTheLoopGoverningIV(LDI));
+  }
   ivUtility.updateConditionAndBranchToCatchIteratingPastExitValue(cmpInst, brInst, basicBlockToJumpToWhenTheLoopEnds);
   auto updatedCmpInst = cmpInst;
 
@@ -194,6 +371,13 @@ void DOALL::rewireLoopToIterateChunks (
 	 * Collect (2)
 	 */
   repeatableInstructions.insert(chunkPHI);
+  if (chunkSizePHI != nullptr){
+    repeatableInstructions.insert(chunkSizePHI);
+  }
+  if (iterationPHI != nullptr){
+    repeatableInstructions.insert(iterationPHI);
+    repeatableInstructions.insert(nextIteration);
+  }
 
 	/*
 	 * Collect (3) by identifying all reducible SCCs
@@ -258,6 +442,117 @@ void DOALL::rewireLoopToIterateChunks (
     }
   }
 
+  /*
+   * Define the code that claims a new chunk from the runtime every time the current one is completed.
+   * This is needed by the dynamic and guided schedulings.
+   *
+   * Latch -> (chunk completed?) -> claim the next chunk -> header.
+   *
+   * NOTE: This has to be invoked after the latches have been finalized.
+   */
+  auto claimChunksAtRunTime = [&](void) -> void {
+    if (hasStaticChunks){
+      return ;
+    }
+    auto &cxt = headerClone->getContext();
+    auto taskFunction = task->getTaskBody();
+    std::vector<BasicBlock *> latchClones;
+    for (auto B : predecessors(headerClone)){
+      if (B == preheaderClone){
+        continue ;
+      }
+      latchClones.push_back(B);
+    }
+    for (auto latchClone : latchClones){
+
+      /*
+       * Fetch whether the current chunk has been completed at this latch.
+       */
+      auto chunkIncomingIdx = chunkPHI->getBasicBlockIndex(latchClone);
+      auto isChunkCompleted = cast<SelectInst>(chunkPHI->getIncomingValue(chunkIncomingIdx))->getCondition();
+
+      /*
+       * Redirect the edge latch -> header to go through the check of the completion of the chunk.
+       */
+      auto checkBB = BasicBlock::Create(cxt, "checkEndOfChunk", taskFunction);
+      auto claimBB = BasicBlock::Create(cxt, "claimNextChunk", taskFunction);
+      auto latchTerminator = latchClone->getTerminator();
+      for (uint32_t i = 0; i < latchTerminator->getNumSuccessors(); i++){
+        if (latchTerminator->getSuccessor(i) == headerClone){
+          latchTerminator->setSuccessor(i, checkBB);
+        }
+      }
+      IRBuilder<> checkBuilder(checkBB);
+      checkBuilder.CreateCondBr(isChunkCompleted, claimBB, headerClone);
+
+      /*
+       * Claim the next chunk.
+       */
+      IRBuilder<> claimBuilder(claimBB);
+      auto jumpToHeader = claimBuilder.CreateBr(headerClone);
+      claimBuilder.SetInsertPoint(jumpToHeader);
+      auto nextChunk = claimBuilder.CreateCall(this->claimChunk, ArrayRef<Value *>({ task->scheduleArg }));
+      auto firstIterationOfNextChunk = claimBuilder.CreateExtractValue(nextChunk, (uint64_t)0, "firstIterationOfNextChunk");
+      auto sizeOfNextChunk = claimBuilder.CreateExtractValue(nextChunk, (uint64_t)1, "sizeOfNextChunk");
+
+      /*
+       * Fix the PHIs of the header.
+       * IVs jump to the first iteration of the new chunk: original_start + original_step_size * first_iteration_of_next_chunk
+       * All other values flow from the latch unchanged.
+       */
+      std::unordered_map<PHINode *, Value *> ivStartValues;
+      for (auto ivInfo : allIVInfo->getInductionVariables(*loopSummary)) {
+        auto startOfIV = fetchClone(ivInfo->getStartValue());
+        auto stepOfIV = clonedStepSizeMap.at(ivInfo);
+        auto ivPHI = cast<PHINode>(fetchClone(ivInfo->getLoopEntryPHI()));
+        auto nextChunkStartValue = IVUtility::computeInductionVariableValueForIteration(claimBB, ivPHI, startOfIV, stepOfIV, firstIterationOfNextChunk);
+        ivStartValues[ivPHI] = nextChunkStartValue;
+      }
+      for (auto &phi : headerClone->phis()){
+        auto latchIdx = phi.getBasicBlockIndex(latchClone);
+        auto valueFromLatch = phi.getIncomingValue(latchIdx);
+        phi.setIncomingBlock(latchIdx, checkBB);
+        Value *valueFromClaim = valueFromLatch;
+        if (&phi == chunkSizePHI){
+          valueFromClaim = sizeOfNextChunk;
+        } else if (&phi == iterationPHI){
+          valueFromClaim = firstIterationOfNextChunk;
+        } else if (ivStartValues.find(&phi) != ivStartValues.end()){
+          valueFromClaim = ivStartValues[&phi];
+        }
+        phi.addIncoming(valueFromClaim, claimBB);
+      }
+
+      /*
+       * The new chunk is empty if an earlier iteration left the loop.
+       * In this case, the task ends without taking any exit of the loop.
+       */
+      if (hasMoreThanOneExit){
+        auto sizeOfNextChunkInst = cast<Instruction>(sizeOfNextChunk);
+        auto claimedBB = claimBB->splitBasicBlock(sizeOfNextChunkInst->getNextNode()->getIterator(), "claimedNextChunk");
+        claimBB->getTerminator()->eraseFromParent();
+        IRBuilder<> cancelBuilder(claimBB);
+        auto isCancelled = cancelBuilder.CreateICmpEQ(sizeOfNextChunk, ConstantInt::get(chunkCounterType, 0));
+        cancelBuilder.CreateCondBr(isCancelled, task->getExit(), claimedBB);
+      }
+
+      /*
+       * The new chunk might start after the last iteration of the loop.
+       * If the header cannot be executed after the last iteration, we need to check it before jumping to the header.
+       */
+      if (!requiresConditionBeforeEnteringHeader){
+        continue ;
+      }
+      auto nextIVValue = ivStartValues.at(cast<PHINode>(loopGoverningPHI));
+      auto prevIterationValue = ivUtility.generateCodeToComputePreviousValueUsedToCompareAgainstExitConditionValue(claimBuilder, nextIVValue, claimBB, stepSize);
+      auto clonedCmpInst = updatedCmpInst->clone();
+      clonedCmpInst->replaceUsesOfWith(valueUsedToCompareAgainstExitConditionValue, prevIterationValue);
+      claimBuilder.Insert(clonedCmpInst);
+      claimBuilder.CreateCondBr(clonedCmpInst, basicBlockToJumpToWhenTheLoopEnds, headerClone);
+      jumpToHeader->eraseFromParent();
+    }
+  };
+
   if (!requiresConditionBeforeEnteringHeader) {
 
     /*
@@ -298,7 +593,7 @@ void DOALL::rewireLoopToIterateChunks (
        *  ? header phi // this will contain the pre-header value or the previous latch value
        *  : original producer // this will be the live out value from the header
        */
-      IRBuilder<> exitBuilder(task->getLastBlock(0)->getFirstNonPHIOrDbgOrLifetime());
+      IRBuilder<> exitBuilder(basicBlockToJumpToWhenTheLoopEnds->getFirstNonPHIOrDbgOrLifetime());
       auto prevIterationValue = ivUtility.generateCodeToComputeValueToUseForAnIterationAgo(exitBuilder, loopGoverningPHI, stepSize);
       auto headerToExitCmp = updatedCmpInst->clone();
       headerToExitCmp->replaceUsesOfWith(valueUsedToCompareAgainstExitConditionValue, prevIterationValue);
@@ -331,6 +626,7 @@ void DOALL::rewireLoopToIterateChunks (
      * There is no need for pre-header / latch guards, so we return
      * TODO: Isolate reducible live out guards and pre-header / latch guards to helper methods so this function's control flow is simpler
      */
+    claimChunksAtRunTime();
     return ;
   }
 
@@ -390,7 +686,7 @@ void DOALL::rewireLoopToIterateChunks (
     auto clonedCmpInst = updatedCmpInst->clone();
     clonedCmpInst->replaceUsesOfWith(valueUsedToCompareAgainstExitConditionValue, prevIterationValue);
     latchBuilder.Insert(clonedCmpInst);
-    latchBuilder.CreateCondBr(clonedCmpInst, task->getLastBlock(0), headerClone);
+    latchBuilder.CreateCondBr(clonedCmpInst, basicBlockToJumpToWhenTheLoopEnds, headerClone);
   }
 
   /*
@@ -417,6 +713,11 @@ void DOALL::rewireLoopToIterateChunks (
     headerClone
   );
 
+  /*
+   * Claim chunks at run time if needed.
+   */
+  claimChunksAtRunTime();
+
   return ;
 }
 
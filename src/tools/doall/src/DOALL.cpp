@@ -14,11 +14,23 @@
 namespace llvm::noelle{
 
 DOALL::DOALL (
-  Noelle &noelle
+  Noelle &noelle,
+  bool deterministicReductions,
+  bool asynchronousDispatch
 ) :
     ParallelizationTechnique{noelle}
   , enabled{true}
   , taskDispatcher{nullptr}
+  , asynchronousTaskDispatcher{nullptr}
+  , joinTasks{nullptr}
+  , claimChunk{nullptr}
+  , cancelLoop{nullptr}
+  , arenaMalloc{nullptr}
+  , arenaCalloc{nullptr}
+  , arenaFree{nullptr}
+  , scheduling{ChunkScheduling::STATIC}
+  , deterministicReductions{deterministicReductions}
+  , asynchronousDispatch{asynchronousDispatch}
   , n{noelle}
   {
 
@@ -30,7 +42,8 @@ DOALL::DOALL (
     tm->getVoidPointerType(),
     tm->getIntegerType(64),
     tm->getIntegerType(64),
-    tm->getIntegerType(64)
+    tm->getIntegerType(64),
+    tm->getVoidPointerType()
   });
   this->taskSignature = FunctionType::get(tm->getVoidType(), funcArgTypes, false);
 
@@ -45,6 +58,44 @@ DOALL::DOALL (
     }
   }
 
+  /*
+   * Fetch the function to use to claim chunks of iterations at run time.
+   * Without it, only the static scheduling of chunks can be used.
+   */
+  this->claimChunk = this->n.getProgram()->getFunction("NOELLE_DOALL_claimChunk");
+
+  /*
+   * Fetch the function to use to cancel the iterations that follow an early exit of a loop.
+   * Without it, only loops with a single exit can be parallelized.
+   */
+  this->cancelLoop = this->n.getProgram()->getFunction("NOELLE_DOALL_cancel");
+
+  /*
+   * Fetch the functions to use to allocate objects that never outlive their iteration.
+   * Without them, such objects are allocated by the C library as in the original loop.
+   */
+  this->arenaMalloc = this->n.getProgram()->getFunction("NOELLE_arena_malloc");
+  this->arenaCalloc = this->n.getProgram()->getFunction("NOELLE_arena_calloc");
+  this->arenaFree = this->n.getProgram()->getFunction("NOELLE_arena_free");
+
+  /*
+   * Fetch the functions to use to start a parallelized DOALL loop without waiting for it, and to wait for it later.
+   * Without them, every parallelized loop ends before the code that follows it starts.
+   */
+  if (this->asynchronousDispatch){
+    this->asynchronousTaskDispatcher = this->n.getProgram()->getFunction("NOELLE_DOALLDispatcherAsync");
+    this->joinTasks = this->n.getProgram()->getFunction("NOELLE_DOALL_join");
+    if (  false
+          || (this->asynchronousTaskDispatcher == nullptr)
+          || (this->joinTasks == nullptr)
+       ){
+      this->asynchronousDispatch = false;
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL: WARNING: the runtime cannot dispatch DOALL loops asynchronously\n";
+      }
+    }
+  }
+
   return ;
 }
 
@@ -62,7 +113,7 @@ bool DOALL::canBeAppliedToLoop (
   auto loopStructure = LDI->getLoopStructure();
 
   /*
-   * The loop must have one single exit path.
+   * The loop must have one single exit path, unless the runtime can cancel the iterations that follow an early exit.
    */
   auto numOfExits = 0;
   for (auto bb : loopStructure->getLoopExitBasicBlocks()){
@@ -91,13 +142,38 @@ bool DOALL::canBeAppliedToLoop (
     }
     numOfExits++;
   }
-  if (numOfExits != 1){ 
+  if (numOfExits == 0){ 
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   No loop exit blocks\n";
+    }
+    return false;
+  }
+  if (  true
+        && (numOfExits > 1)
+        && (!this->canCancelTheLoopAtEarlyExits(LDI))
+     ){
     if (this->verbose != Verbosity::Disabled) {
       errs() << "DOALL:   More than 1 loop exit blocks\n";
     }
     return false;
   }
 
+  /*
+   * The exit taken needs to be recorded by the runtime even if all exits but one end the program (e.g., by calling exit()).
+   */
+  if (  true
+        && (loopStructure->getLoopExitBasicBlocks().size() > 1)
+        && (  false
+              || (this->claimChunk == nullptr)
+              || (this->cancelLoop == nullptr)
+           )
+     ){
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The runtime cannot cancel DOALL loops\n";
+    }
+    return false;
+  }
+
   /*
    * The loop must have all live-out variables to be reducable.
    */
@@ -109,6 +185,30 @@ bool DOALL::canBeAppliedToLoop (
     return false;
   }
 
+  /*
+   * Arrays of floating point values are merged concurrently by the task instances (see privatizeArrayReductions).
+   * Hence, their final values depend on the order the task instances end.
+   */
+  if (  true
+        && this->deterministicReductions
+        && this->doesReduceFloatingPointArrays(LDI)
+     ){
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The loop reduces arrays of floating point values, which cannot be reduced deterministically\n";
+    }
+    return false;
+  }
+  if (  true
+        && this->deterministicReductions
+        && this->doesReduceFloatingPointVariables(LDI)
+        && (loopStructure->getLoopExitBasicBlocks().size() > 1)
+     ){
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The loop has more than one exit, so its chunks cannot be assigned deterministically to reduce floating point variables\n";
+    }
+    return false;
+  }
+
   /*
    * The compiler must be able to remove loop-carried data dependences of all SCCs with loop-carried data dependences.
    */
@@ -230,6 +330,11 @@ bool DOALL::apply (
   auto ltm = LDI->getLoopTransformationsManager();
   auto maxCores = ltm->getMaximumNumberOfCores();
 
+  /*
+   * Decide how chunks of iterations will be assigned to threads.
+   */
+  this->scheduling = this->chooseChunkScheduling(LDI);
+
   /*
    * Print the parallelization request.
    */
@@ -237,6 +342,7 @@ bool DOALL::apply (
     errs() << "DOALL: Start the parallelization\n";
     errs() << "DOALL:   Number of threads to extract = " << maxCores << "\n";
     errs() << "DOALL:   Chunk size = " << ltm->getChunkSize() << "\n";
+    errs() << "DOALL:   Chunk scheduling = " << this->scheduling << "\n";
   }
 
   /*
@@ -253,6 +359,14 @@ bool DOALL::apply (
   auto postEnvRange = loopEnvironment->getEnvIndicesOfLiveOutVars();
   std::set<uint32_t> nonReducableVars(preEnvRange.begin(), preEnvRange.end());
   std::set<uint32_t> reducableVars(postEnvRange.begin(), postEnvRange.end());
+
+  /*
+   * Add the memory location of the environment used to store the exit block taken to leave the parallelized loop.
+   * This location exists only if there is more than one loop exit.
+   */
+  if (loopStructure->numberOfExitBasicBlocks() > 1){ 
+    nonReducableVars.insert(loopEnvironment->indexOfExitBlockTaken());
+  }
   this->initializeEnvironmentBuilder(LDI, nonReducableVars, reducableVars);
 
   /*
@@ -329,6 +443,16 @@ bool DOALL::apply (
     errs() << "DOALL:  Stored live outs\n";
   }
 
+  /*
+   * Accumulate values of reduced arrays to private copies.
+   */
+  this->privatizeArrayReductions(LDI, 0);
+
+  /*
+   * Allocate the objects that never outlive their iteration from the per-thread arena.
+   */
+  this->allocateIterationPrivateObjectsFromArena(LDI);
+
   this->addChunkFunctionExecutionAsideOriginalLoop(LDI, loopFunction, this->n);
 
   /*
@@ -363,6 +487,17 @@ void DOALL::addChunkFunctionExecutionAsideOriginalLoop (
   this->allocateEnvironmentArray(LDI);
   this->populateLiveInEnvironment(LDI);
 
+  /*
+   * The exit of the loop-governing IV is taken unless an iteration leaves the loop earlier (see cancelTheLoopAtEarlyExits).
+   */
+  IRBuilder<> doallBuilder(this->entryPointOfParallelizedLoop);
+  auto loopEnvironment = LDI->getEnvironment();
+  if (loopEnvironment->indexOfExitBlockTaken() != -1){
+    auto exitBlockEnvVariable = this->envBuilder->getEnvironmentVariable(loopEnvironment->indexOfExitBlockTaken());
+    auto exitOfLoopGoverningIV = ConstantInt::get(par.int32, this->getIndexOfTheExitOfTheLoopGoverningIV(LDI));
+    doallBuilder.CreateStore(exitOfLoopGoverningIV, exitBlockEnvVariable);
+  }
+
   /*
    * Fetch the pointer to the environment.
    */
@@ -380,15 +515,88 @@ void DOALL::addChunkFunctionExecutionAsideOriginalLoop (
   auto chunkSize = ConstantInt::get(par.int64, ltm->getChunkSize());
 
   /*
-   * Call the function that incudes the parallelized loop.
+   * Fetch the chunk scheduling.
    */
-  IRBuilder<> doallBuilder(this->entryPointOfParallelizedLoop);
-  auto doallCallInst = doallBuilder.CreateCall(this->taskDispatcher, ArrayRef<Value *>({
+  auto scheduling = ConstantInt::get(par.int64, this->scheduling);
+
+  /*
+   * Compute the number of iterations the loop is going to execute (0 if we cannot).
+   * The runtime uses it to choose the number of threads of the current invocation, to shrink chunks as iterations run out (guided scheduling), and to give the cores that would not get any chunk to the parallelized loops nested in this one.
+   */
+  Value *numberOfIterations = ConstantInt::get(par.int64, 0);
+  if (this->canComputeTheNumberOfIterations(LDI)){
+    numberOfIterations = this->generateCodeToComputeTheNumberOfIterations(LDI, doallBuilder);
+    assert(numberOfIterations != nullptr);
+  }
+
+  /*
+   * Fetch the ID of the loop, which identifies it in the telemetry of the runtime.
+   */
+  auto loopID = ConstantInt::get(par.int64, LDI->getID());
+
+  /*
+   * Generate the function that combines the private copies of reduced live-out variables when task instances end.
+   */
+  auto combinerPointerType = cast<PointerType>(this->taskDispatcher->getFunctionType()->getParamType(2));
+  auto reductionCombiner = this->generateReductionCombiner(LDI, combinerPointerType);
+
+  /*
+   * Start the parallelized loop without waiting for it if we can.
+   */
+  std::vector<Value *> dispatcherArguments{
     tasks[0]->getTaskBody(),
     envPtr,
+    reductionCombiner,
     numCores,
-    chunkSize
-  }));
+    chunkSize,
+    scheduling,
+    numberOfIterations,
+    loopID
+  };
+  if (this->canDeferTheJoin(LDI)){
+    auto joinPoint = this->findTheLatestPointToJoin(LDI);
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   Join the parallelized loop at " << *joinPoint << "\n";
+    }
+
+    /*
+     * Allocate the variable that keeps the handle of the running invocation of the loop.
+     *
+     * The handle is null unless the parallelized loop has been started.
+     * This way, the join does nothing when the sequential loop runs instead.
+     */
+    auto handleType = this->asynchronousTaskDispatcher->getReturnType();
+    IRBuilder<> entryBuilder(&*loopFunction->begin()->begin());
+    auto handleVariable = entryBuilder.CreateAlloca(handleType);
+    auto loopPreHeader = LDI->getLoopStructure()->getPreHeader();
+    IRBuilder<> preHeaderBuilder(loopPreHeader->getTerminator());
+    preHeaderBuilder.CreateStore(Constant::getNullValue(handleType), handleVariable);
+
+    /*
+     * Start the parallelized loop.
+     */
+    auto handle = doallBuilder.CreateCall(this->asynchronousTaskDispatcher, dispatcherArguments);
+    doallBuilder.CreateStore(handle, handleVariable);
+
+    /*
+     * Wait for the parallelized loop.
+     */
+    IRBuilder<> joinBuilder(joinPoint);
+    auto handleToJoin = joinBuilder.CreateLoad(handleVariable);
+    this->joinOfParallelizedLoop = joinBuilder.CreateCall(this->joinTasks, ArrayRef<Value *>({ handleToJoin }));
+
+    /*
+     * Jump to the unique successor of the loop.
+     */
+    doallBuilder.CreateBr(this->exitPointOfParallelizedLoop);
+
+    return ;
+  }
+
+  /*
+   * Call the function that incudes the parallelized loop.
+   */
+  auto doallCallInst = doallBuilder.CreateCall(this->taskDispatcher, dispatcherArguments);
   auto numThreadsUsed = doallBuilder.CreateExtractValue(doallCallInst, (uint64_t)0);
 
   /*
@@ -405,6 +613,87 @@ void DOALL::addChunkFunctionExecutionAsideOriginalLoop (
   return ;
 }
 
+DOALL::ChunkScheduling DOALL::chooseChunkScheduling (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Loops with more than one exit can be cancelled only when chunks are claimed at run time (see canCancelTheLoopAtEarlyExits).
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  if (loopStructure->getLoopExitBasicBlocks().size() > 1){
+    assert(this->claimChunk != nullptr);
+    if (this->canComputeTheNumberOfIterations(LDI)){
+      return ChunkScheduling::GUIDED;
+    }
+    return ChunkScheduling::DYNAMIC;
+  }
+
+  /*
+   * Floating point variables must be reduced the same way independently of the number of threads used at run time, if we have been asked to do so.
+   */
+  if (  true
+        && this->deterministicReductions
+        && this->doesReduceFloatingPointVariables(LDI)
+     ){
+    return ChunkScheduling::DETERMINISTIC;
+  }
+
+  /*
+   * Chunks can be claimed at run time only if the runtime provides the API to do it.
+   */
+  if (this->claimChunk == nullptr){
+    return ChunkScheduling::STATIC;
+  }
+
+  /*
+   * Check if the cost of an iteration can change significantly between iterations.
+   * This is the case when an iteration includes a sub-loop or a call to a function (other than intrinsics).
+   */
+  auto loopNode = LDI->getLoopHierarchyStructures();
+  auto hasVariableIterationCost = (loopNode->getNumberOfSubLoops() > 0);
+  for (auto inst : loopStructure->getInstructions()){
+    if (hasVariableIterationCost){
+      break ;
+    }
+    auto callInst = dyn_cast<CallInst>(inst);
+    if (callInst == nullptr){
+      continue ;
+    }
+    auto callee = callInst->getCalledFunction();
+    if (  true
+          && (callee != nullptr)
+          && (callee->isIntrinsic())
+       ){
+      continue ;
+    }
+    hasVariableIterationCost = true;
+  }
+
+  /*
+   * Iterations with the same cost are well balanced by the static round-robin assignment of chunks, which has no run-time overhead.
+   */
+  if (!hasVariableIterationCost){
+    return ChunkScheduling::STATIC;
+  }
+
+  /*
+   * Iterations have variable costs.
+   * Threads need to claim chunks at run time.
+   *
+   * Shrink chunks as iterations run out if we can compute the number of iterations before starting the loop.
+   */
+  if (this->canComputeTheNumberOfIterations(LDI)){
+    return ChunkScheduling::GUIDED;
+  }
+
+  return ChunkScheduling::DYNAMIC;
+}
+
+Function * DOALL::getTaskFunction (void) const {
+  return tasks[0]->getTaskBody();
+}
+
 Value * DOALL::fetchClone (Value *original) const {
   auto task = this->tasks[0];
   if (isa<ConstantData>(original)) return original;
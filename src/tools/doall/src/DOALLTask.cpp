@@ -29,6 +29,7 @@ void DOALLTask::extractFuncArgs (void) {
   this->coreArg = (Value *) &*(argIter++); 
   this->numCoresArg = (Value *) &*(argIter++);
   this->chunkSizeArg = (Value *) &*(argIter++);
+  this->scheduleArg = (Value *) &*(argIter++);
   this->instanceIndexV = coreArg;
 
   return ;
@@ -23,6 +23,12 @@ std::set<SCC *> DOALL::getSCCsThatBlockDOALLToBeApplicable (
    */
   auto sccManager = LDI->getSCCManager();
 
+  /*
+   * Fetch the objects that never outlive the iteration that allocates them.
+   * Memory accesses to them cannot depend on accesses of other iterations, even if the pointers used are the same values.
+   */
+  auto privatePointers = DOALL::getPointersToIterationPrivateObjects(LDI->getLoopStructure());
+
   /*
    * Iterate over SCCs with loop-carried data dependences
    */
@@ -63,7 +69,7 @@ std::set<SCC *> DOALL::getSCCsThatBlockDOALLToBeApplicable (
     auto areAllDataLCDsFromDisjointMemoryAccesses = true;
     auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
     sccManager->iterateOverLoopCarriedDataDependences(scc, [
-      &areAllDataLCDsFromDisjointMemoryAccesses, domainSpaceAnalysis
+      &areAllDataLCDsFromDisjointMemoryAccesses, domainSpaceAnalysis, &privatePointers
     ](DGEdge<Value> *dep) -> bool {
       if (dep->isControlDependence()) return false;
 
@@ -74,8 +80,13 @@ std::set<SCC *> DOALL::getSCCsThatBlockDOALLToBeApplicable (
 
       auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
       auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
-      areAllDataLCDsFromDisjointMemoryAccesses &= fromInst && toInst && domainSpaceAnalysis->
-        areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst);
+      areAllDataLCDsFromDisjointMemoryAccesses &= fromInst && toInst && (false
+        || domainSpaceAnalysis->areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst)
+        || (true
+            && DOALL::accessesOnlyIterationPrivateObjects(fromInst, privatePointers)
+            && DOALL::accessesOnlyIterationPrivateObjects(toInst, privatePointers)
+           )
+        );
       return !areAllDataLCDsFromDisjointMemoryAccesses;
     });
     if (areAllDataLCDsFromDisjointMemoryAccesses) {
@@ -91,4 +102,129 @@ std::set<SCC *> DOALL::getSCCsThatBlockDOALLToBeApplicable (
   return sccs;
 }
 
+std::unordered_map<Value *, CallBase *> DOALL::getPointersToIterationPrivateObjects (
+  LoopStructure *loopStructure
+  ) {
+  std::unordered_map<Value *, CallBase *> pointers;
+
+  for (auto inst : loopStructure->getInstructions()){
+
+    /*
+     * Check if the instruction allocates a new object.
+     * Reallocations are excluded as they return objects that exist already.
+     */
+    auto allocatorCall = dyn_cast<CallBase>(inst);
+    if (  false
+          || (!Utils::isAllocator(allocatorCall))
+          || Utils::isReallocator(allocatorCall)
+       ){
+      continue ;
+    }
+
+    /*
+     * Check if the object escapes the iteration that allocates it.
+     *
+     * This is not the case if pointers to it (i.e., the allocated one and the ones derived from it) are only used within the loop to access it, to compare them, or to free it.
+     * In other words, they are never stored to memory, they never reach a PHI node (e.g., to flow to the next iteration), and they are never given to other functions.
+     */
+    std::unordered_set<Value *> derivedPointers{ allocatorCall };
+    std::vector<Value *> pointersToCheck{ allocatorCall };
+    auto doesEscape = false;
+    while (  true
+             && (!doesEscape)
+             && (pointersToCheck.size() > 0)
+          ){
+      auto pointer = pointersToCheck.back();
+      pointersToCheck.pop_back();
+      for (auto user : pointer->users()){
+        auto userInst = dyn_cast<Instruction>(user);
+        if (  false
+              || (userInst == nullptr)
+              || (!loopStructure->isIncluded(userInst))
+           ){
+          doesEscape = true;
+          break ;
+        }
+        if (  false
+              || isa<BitCastInst>(userInst)
+              || isa<GetElementPtrInst>(userInst)
+           ){
+          if (derivedPointers.insert(userInst).second){
+            pointersToCheck.push_back(userInst);
+          }
+          continue ;
+        }
+        if (  false
+              || isa<LoadInst>(userInst)
+              || isa<ICmpInst>(userInst)
+           ){
+          continue ;
+        }
+        if (auto storeInst = dyn_cast<StoreInst>(userInst)){
+          if (storeInst->getValueOperand() == pointer){
+            doesEscape = true;
+            break ;
+          }
+          continue ;
+        }
+        if (auto callInst = dyn_cast<CallBase>(userInst)){
+          if (Utils::isDeallocator(callInst)){
+            continue ;
+          }
+          if (  false
+                || isa<MemIntrinsic>(callInst)
+                || callInst->isLifetimeStartOrEnd()
+             ){
+            continue ;
+          }
+        }
+        doesEscape = true;
+        break ;
+      }
+    }
+    if (doesEscape){
+      continue ;
+    }
+
+    /*
+     * The object is private to the iteration that allocates it.
+     */
+    for (auto pointer : derivedPointers){
+      pointers[pointer] = allocatorCall;
+    }
+  }
+
+  return pointers;
+}
+
+bool DOALL::accessesOnlyIterationPrivateObjects (
+  Instruction *inst,
+  const std::unordered_map<Value *, CallBase *> &privatePointers
+  ) {
+  auto isPrivate = [&privatePointers](Value *pointer) -> bool {
+    return privatePointers.find(pointer) != privatePointers.end();
+  };
+
+  if (auto loadInst = dyn_cast<LoadInst>(inst)){
+    return isPrivate(loadInst->getPointerOperand());
+  }
+  if (auto storeInst = dyn_cast<StoreInst>(inst)){
+    return isPrivate(storeInst->getPointerOperand());
+  }
+  if (auto memTransferInst = dyn_cast<MemTransferInst>(inst)){
+    return isPrivate(memTransferInst->getRawDest()) && isPrivate(memTransferInst->getRawSource());
+  }
+  if (auto memInst = dyn_cast<MemIntrinsic>(inst)){
+    return isPrivate(memInst->getRawDest());
+  }
+  if (auto callInst = dyn_cast<CallBase>(inst)){
+    if (Utils::isDeallocator(callInst)){
+      return isPrivate(Utils::getFreedObject(callInst));
+    }
+    return isPrivate(callInst);
+  }
+
+  return false;
+}
+
 }
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2016 - 2022  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+
+namespace llvm::noelle{
+
+bool DOALL::canDeferTheJoin (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Check if we have been asked to dispatch loops asynchronously.
+   */
+  if (!this->asynchronousDispatch){
+    return false;
+  }
+
+  /*
+   * The values computed by the loop are used right after it.
+   * Hence, there is nothing to run while the loop does.
+   */
+  auto loopEnvironment = LDI->getEnvironment();
+  auto liveOutIndices = loopEnvironment->getEnvIndicesOfLiveOutVars();
+  if (liveOutIndices.begin() != liveOutIndices.end()){
+    return false;
+  }
+
+  /*
+   * The code that follows the loop must be unique.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  if (loopStructure->getLoopExitBasicBlocks().size() != 1){
+    return false;
+  }
+
+  return true;
+}
+
+Instruction * DOALL::findTheLatestPointToJoin (
+  LoopDependenceInfo *LDI
+) {
+
+  /*
+   * Fetch the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopPreHeader = loopStructure->getPreHeader();
+  auto exitBlocks = loopStructure->getLoopExitBasicBlocks();
+  assert(exitBlocks.size() == 1);
+
+  /*
+   * Fetch the dependences of the program.
+   * They are the ones of the code before the parallelization, which still includes the original loop.
+   */
+  auto pdg = this->n.getProgramDependenceGraph();
+
+  /*
+   * Define the instructions that cannot run while the parallelized loop does.
+   * These are the ones that depend on the loop, that the loop depends on, or that can leave the function without reaching the next instruction.
+   */
+  auto mustRunAfterTheLoop = [pdg, loopStructure](Instruction *inst) -> bool {
+    if (inst->mayThrow()){
+      return true;
+    }
+    if (auto callInst = dyn_cast<CallInst>(inst)){
+      if (callInst->doesNotReturn()){
+        return true;
+      }
+    }
+    if (!pdg->isInGraph(inst)){
+      return true;
+    }
+    auto node = pdg->fetchNode(inst);
+    for (auto edge : node->getIncomingEdges()){
+      if (edge->isControlDependence()){
+        continue ;
+      }
+      auto otherInst = dyn_cast<Instruction>(edge->getOutgoingT());
+      if (  true
+            && (otherInst != nullptr)
+            && loopStructure->isIncluded(otherInst)
+         ){
+        return true;
+      }
+    }
+    for (auto edge : node->getOutgoingEdges()){
+      if (edge->isControlDependence()){
+        continue ;
+      }
+      auto otherInst = dyn_cast<Instruction>(edge->getIncomingT());
+      if (  true
+            && (otherInst != nullptr)
+            && loopStructure->isIncluded(otherInst)
+         ){
+        return true;
+      }
+    }
+
+    return false;
+  };
+
+  /*
+   * Walk the code that always runs after the loop, starting from its exit block.
+   *
+   * We follow unconditional branches to blocks that can only be reached from the block we leave.
+   * This way, every execution that leaves the loop reaches the join.
+   */
+  auto currentBB = exitBlocks[0];
+  auto joinPoint = currentBB->getFirstNonPHI();
+  std::unordered_set<BasicBlock *> visited;
+  while (visited.insert(currentBB).second){
+    for (auto &I : *currentBB){
+      auto inst = &I;
+
+      /*
+       * Nothing can be placed before a PHI node.
+       * Hence, the join stays before the branch to the current block if the PHI needs the loop to end.
+       */
+      if (isa<PHINode>(inst)){
+        if (mustRunAfterTheLoop(inst)){
+          return joinPoint;
+        }
+        continue ;
+      }
+      joinPoint = inst;
+
+      /*
+       * Check if we can follow the branch.
+       */
+      if (inst->isTerminator()){
+        auto brInst = dyn_cast<BranchInst>(inst);
+        if (  false
+              || (brInst == nullptr)
+              || (brInst->isConditional())
+           ){
+          return joinPoint;
+        }
+        auto nextBB = brInst->getSuccessor(0);
+        if (  false
+              || (nextBB->getSinglePredecessor() != currentBB)
+              || (nextBB == loopPreHeader)
+              || loopStructure->isIncluded(nextBB)
+           ){
+          return joinPoint;
+        }
+        currentBB = nextBB;
+        break ;
+      }
+
+      /*
+       * Check if the current instruction needs the loop to end.
+       */
+      if (mustRunAfterTheLoop(inst)){
+        return joinPoint;
+      }
+    }
+  }
+
+  return joinPoint;
+}
+
+}
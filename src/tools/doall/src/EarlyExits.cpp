@@ -0,0 +1,166 @@
+/*
+ * Copyright 2016 - 2022  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+#include "DOALLTask.hpp"
+
+namespace llvm::noelle{
+
+bool DOALL::canCancelTheLoopAtEarlyExits (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Check if the runtime can cancel the chunks of iterations that follow an early exit.
+   * This requires the chunks to be claimed at run time.
+   */
+  if (  false
+        || (this->claimChunk == nullptr)
+        || (this->cancelLoop == nullptr)
+     ){
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The runtime cannot cancel DOALL loops\n";
+    }
+    return false;
+  }
+
+  /*
+   * The exit taken is the only result of the loop.
+   * Live-out variables would need the values computed by the iteration that left the loop first.
+   *
+   * This includes the loop-governing IV, so a search loop whose index is used after the loop stays sequential.
+   * Its value could be derived from the earliest exiting iteration that the runtime records, but this is not supported yet.
+   */
+  auto loopEnvironment = LDI->getEnvironment();
+  auto liveOutIndices = loopEnvironment->getEnvIndicesOfLiveOutVars();
+  if (liveOutIndices.begin() != liveOutIndices.end()){
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The loop has more than one exit and live-out variables (e.g., the index found by a search loop)\n";
+    }
+    return false;
+  }
+
+  /*
+   * The iterations that follow the one that leaves the loop can run before the loop gets cancelled.
+   * Hence, iterations cannot have side effects.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  for (auto inst : loopStructure->getInstructions()){
+    if (isa<DbgInfoIntrinsic>(inst)){
+      continue ;
+    }
+    if (auto callInst = dyn_cast<CallInst>(inst)){
+      if (callInst->isLifetimeStartOrEnd()){
+        continue ;
+      }
+    }
+    if (!inst->mayHaveSideEffects()){
+      continue ;
+    }
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The loop has more than one exit and the instruction " << *inst << " has side effects\n";
+    }
+    return false;
+  }
+
+  /*
+   * The code after the parallelized loop can only set the PHI nodes of the exit blocks with constants that come from the header (see Noelle::linkTransformedLoopToOriginalFunction).
+   */
+  auto loopHeader = loopStructure->getHeader();
+  for (auto exitBB : loopStructure->getLoopExitBasicBlocks()){
+    for (auto &phi : exitBB->phis()){
+      auto headerIndex = phi.getBasicBlockIndex(loopHeader);
+      if (  false
+            || (headerIndex == -1)
+            || (!isa<Constant>(phi.getIncomingValue(headerIndex)))
+         ){
+        if (this->verbose != Verbosity::Disabled) {
+          errs() << "DOALL:   The loop has more than one exit and the exit block has the PHI " << phi << "\n";
+        }
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+uint32_t DOALL::getIndexOfTheExitOfTheLoopGoverningIV (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Fetch the exit taken when the loop-governing IV reaches its last value.
+   */
+  auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+  assert(loopGoverningIVAttr != nullptr);
+  auto exitBB = loopGoverningIVAttr->getExitBlockFromHeader();
+
+  /*
+   * Exit blocks are identified by their position in the list of exits of the loop (see Noelle::linkTransformedLoopToOriginalFunction).
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto exitBlocks = loopStructure->getLoopExitBasicBlocks();
+  for (auto i = 0u; i < exitBlocks.size(); i++){
+    if (exitBlocks[i] == exitBB){
+      return i;
+    }
+  }
+  abort();
+}
+
+void DOALL::cancelTheLoopAtEarlyExits (
+  LoopDependenceInfo *LDI,
+  Value *currentIteration
+) {
+
+  /*
+   * Fetch the task.
+   */
+  auto task = (DOALLTask *)tasks[0];
+
+  /*
+   * Fetch the location of the environment where the exit taken is stored.
+   */
+  auto loopEnvironment = LDI->getEnvironment();
+  auto exitBlockEnvIndex = loopEnvironment->indexOfExitBlockTaken();
+  assert(exitBlockEnvIndex != -1);
+  auto envUser = this->envBuilder->getUser(0);
+  IRBuilder<> entryBuilder(task->getEntry()->getTerminator());
+  auto envType = loopEnvironment->typeOfEnvironmentLocation(exitBlockEnvIndex);
+  envUser->createEnvPtr(entryBuilder, exitBlockEnvIndex, envType);
+  auto envPtr = envUser->getEnvPtr(exitBlockEnvIndex);
+
+  /*
+   * Every exit other than the one of the loop-governing IV cancels the iterations that follow the current one.
+   * The runtime stores the exit in the environment if the current iteration is the earliest one that left the loop.
+   *
+   * The exit of the loop-governing IV is stored by the caller of the dispatcher before starting the loop, as it is the one taken when no iteration leaves the loop earlier.
+   */
+  auto int32 = IntegerType::get(task->getTaskBody()->getContext(), 32);
+  auto exitOfLoopGoverningIV = this->getIndexOfTheExitOfTheLoopGoverningIV(LDI);
+  for (uint32_t i = 0; i < task->getNumberOfLastBlocks(); ++i) {
+    if (i == exitOfLoopGoverningIV){
+      continue ;
+    }
+    auto bb = task->getLastBlock(i);
+    IRBuilder<> builder(bb->getTerminator());
+    builder.CreateCall(this->cancelLoop, ArrayRef<Value *>({
+      task->scheduleArg,
+      currentIteration,
+      ConstantInt::get(int32, i),
+      envPtr
+    }));
+  }
+
+  return ;
+}
+
+}
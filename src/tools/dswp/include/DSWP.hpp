@@ -32,7 +32,9 @@ namespace llvm::noelle {
       DSWP (
         Noelle &par,
         bool forceParallelization,
-        bool enableSCCMerging
+        bool enableSCCMerging,
+        bool enableBatchedQueues,
+        bool enableStageReplication
       );
 
       bool apply (
@@ -51,12 +53,16 @@ namespace llvm::noelle {
        * CLI Options
        */
       bool enableMergingSCC;
+      bool enableBatchedQueues;
+      bool enableStageReplication;
 
       /*
        * Stores new pipeline execution
        */
       std::unordered_map<SCC *, DSWPTask *> sccToStage;
       std::vector<std::unique_ptr<QueueInfo>> queues;
+      std::vector<std::unique_ptr<PackedQueueInfo>> packedQueues;
+      uint64_t numberOfQueueSlots;
 
       /*
        * Types for arrays storing dependencies and stages
@@ -87,6 +93,8 @@ namespace llvm::noelle {
       void generateLoadsOfQueuePointers (Noelle &par, int taskIndex);
       void popValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex);
       void pushValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex);
+      void flushValueQueues (Noelle &par, int taskIndex);
+      void routeQueuesOfReplicatedStages (Noelle &par, LoopDependenceInfo *LDI, int taskIndex);
       void createPipelineFromStages (LoopDependenceInfo *LDI, Noelle &par);
       Value * createStagesArrayFromStages (
         LoopDependenceInfo *LDI,
@@ -98,6 +106,24 @@ namespace llvm::noelle {
         IRBuilder<> funcBuilder,
         Noelle &par
       );
+      Value * createInt64ArrayFromValues (
+        std::vector<int64_t> &values,
+        IRBuilder<> funcBuilder,
+        Noelle &par
+      );
+
+      /*
+       * Stage replication
+       */
+      void replicateStages (LoopDependenceInfo *LDI, Heuristics *h);
+      bool canStageBeReplicated (LoopDependenceInfo *LDI, DSWPTask *task) ;
+      void allocateQueueSlots (void);
+      Value * getQueuePointerOfCurrentIteration (
+        DSWPTask *task,
+        int packedQueueIndex,
+        Instruction *insertPoint,
+        int64_t iterationOffset
+      );
 
       /*
        * Recursively inline queue push/pop functions in DSWP Utils and ThreadPool API
@@ -109,6 +135,10 @@ namespace llvm::noelle {
        */
       void collectDataAndMemoryQueueInfo (LoopDependenceInfo *LDI, Noelle &par);
       void collectControlQueueInfo (LoopDependenceInfo *LDI, Noelle &par);
+      void packQueues (Noelle &par);
+      Function * getQueuePushFunction (Noelle &par, PackedQueueInfo *packedQueue) const ;
+      Function * getQueuePopFunction (Noelle &par, PackedQueueInfo *packedQueue) const ;
+      Function * getQueueFlushFunction (Noelle &par, PackedQueueInfo *packedQueue) const ;
       std::set<Task *> collectTransitivelyControlledTasks (
         LoopDependenceInfo *LDI,
         DGNode<Value> *conditionalBranchNodei
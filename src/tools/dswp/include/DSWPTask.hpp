@@ -20,6 +20,7 @@ using namespace std;
 namespace llvm::noelle {
 
   struct QueueInfo;
+  struct PackedQueueInfo;
   struct QueueInstrs;
 
   class DSWPTask : public Task {
@@ -39,6 +40,17 @@ namespace llvm::noelle {
        */
       Value *queueArg;
 
+      /*
+       * Number of threads that run this stage (see DSWP::replicateStages)
+       */
+      uint64_t numberOfReplicas;
+
+      /*
+       * Number of iterations started by this stage so far minus one.
+       * It is only used by stages that are not replicated and communicate with replicated ones.
+       */
+      Value *iterationCounter;
+
       /*
        * Original loops' relevant structures
        */
@@ -61,7 +73,12 @@ namespace llvm::noelle {
       std::set<int> pushValueQueues, popValueQueues;
 
       /*
-       * Stores information on queue/env usage within stage
+       * Stores the indices of the packed queues (see PackedQueueInfo) that carry the values of the queues above
+       */
+      std::set<int> pushPackedQueues, popPackedQueues;
+
+      /*
+       * Stores information on packed queue/env usage within stage
        */
       unordered_map<int, std::unique_ptr<QueueInstrs>> queueInstrMap;
 
@@ -78,13 +95,19 @@ namespace llvm::noelle {
     std::set<Instruction *> consumers;
     unordered_map<Instruction *, int> consumerToPushIndex;
 
+    /*
+     * Packed queue that carries the value and position of the value within the record of the packed queue
+     */
+    int packedQueueIndex;
+    int fieldIndex;
+
     QueueInfo(Instruction *p, Instruction *c, Type *type, bool isMemoryDependence)
-        : producer{p}, dependentType{type}, isMemoryDependence{isMemoryDependence} {
+        : producer{p}, dependentType{type}, isMemoryDependence{isMemoryDependence}, packedQueueIndex{-1}, fieldIndex{-1} {
       consumers.insert(c);
       if (isMemoryDependence) {
         dependentType = IntegerType::get(c->getContext(), 1);
         bitLength = 1;
-      } else if (dependentType->isPointerTy()) {
+      } else if (dependentType->isPointerTy() || dependentType->isAggregateType()) {
         bitLength = DataLayout(p->getModule()).getTypeAllocSize(dependentType) * 8;
       } else {
         bitLength = dependentType->getPrimitiveSizeInBits();
@@ -101,11 +124,41 @@ namespace llvm::noelle {
     }
   };
 
+  /*
+   * Queue allocated by the runtime.
+   *
+   * It carries the values of all the queues (see QueueInfo) between the same pair of stages whose producers belong to the same basic block.
+   * These values are produced the same number of times and in the same order, so they are packed into a record that is pushed and popped at once.
+   * A packed queue with a single value of a width the runtime has a queue for (see Queue::queueSizeToIndex) does not use a record.
+   */
+  struct PackedQueueInfo {
+    int fromStage, toStage;
+    std::vector<int> queues;
+    bool isRecord;
+    Type *recordType;
+    int bitLength;
+
+    /*
+     * Replicated stage connected to the packed queue (-1 if none).
+     * The runtime implements the packed queue with a queue per replica, which are stored in the queue array of a stage from the position firstSlot on.
+     * Iteration i uses the queue of replica i % numberOfSlots.
+     */
+    int replicatedStage;
+    int firstSlot;
+    int numberOfSlots;
+
+    /*
+     * The packed queue carries no value.
+     * It tells a replica whether to start its next iteration (true) or to exit (false).
+     */
+    bool isIterationToken;
+  };
+
   struct QueueInstrs {
     Value *queuePtr;
+    Value *queueSlotPtr;
     Value *queueCall;
     Value *alloca;
     Value *allocaCast;
-    Value *load;
   };
 }
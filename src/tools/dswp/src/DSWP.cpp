@@ -16,11 +16,15 @@ using namespace llvm::noelle;
 DSWP::DSWP (
   Noelle &n,
   bool forceParallelization,
-  bool enableSCCMerging
+  bool enableSCCMerging,
+  bool enableBatchedQueues,
+  bool enableStageReplication
 ) :
   ParallelizationTechniqueForLoopsWithLoopCarriedDataDependences{n, forceParallelization},
   enableMergingSCC{enableSCCMerging},
-  queues{}, queueArrayType{nullptr},
+  enableBatchedQueues{enableBatchedQueues},
+  enableStageReplication{enableStageReplication},
+  queues{}, packedQueues{}, numberOfQueueSlots{0}, queueArrayType{nullptr},
   sccToStage{}, stageArrayType{nullptr},
   zeroIndexForBaseArray{nullptr}
   {
@@ -30,6 +34,9 @@ DSWP::DSWP (
    */
   auto program = this->noelle.getProgram();
   this->taskDispatcher = program->getFunction("NOELLE_DSWPDispatcher");
+  if (this->enableBatchedQueues){
+    this->taskDispatcher = program->getFunction("NOELLE_DSWPDispatcher_batchedQueues");
+  }
 
   /*
    * Fetch the function that executes a stage.
@@ -227,6 +234,7 @@ bool DSWP::apply (
    */
   collectDataAndMemoryQueueInfo(LDI, this->noelle);
   collectControlQueueInfo(LDI, this->noelle);
+  packQueues(this->noelle);
   // assert(areQueuesAcyclical());
   // writeStageQueuesAsDot(*LDI);
 
@@ -256,6 +264,12 @@ bool DSWP::apply (
   collectLiveInEnvInfo(LDI);
   collectLiveOutEnvInfo(LDI);
 
+  /*
+   * Decide how many threads run each stage and allocate the queues accordingly.
+   */
+  replicateStages(LDI, h);
+  allocateQueueSlots();
+
   if (this->verbose >= Verbosity::Minimal) {
     printStageSCCs(LDI);
   }
@@ -271,7 +285,7 @@ bool DSWP::apply (
    * Helper declarations
    */
   this->zeroIndexForBaseArray = cast<Value>(ConstantInt::get(this->noelle.int64, 0));
-  this->queueArrayType = ArrayType::get(PointerType::getUnqual(this->noelle.int8), this->queues.size());
+  this->queueArrayType = ArrayType::get(PointerType::getUnqual(this->noelle.int8), this->numberOfQueueSlots);
   this->stageArrayType = ArrayType::get(PointerType::getUnqual(this->noelle.int8), this->tasks.size());
 
   /*
@@ -348,6 +362,18 @@ bool DSWP::apply (
     IRBuilder<> exitBuilder(task->getExit());
     exitBuilder.CreateRetVoid();
 
+    /*
+     * Send the values of each iteration to the replica that runs it.
+     */
+    routeQueuesOfReplicatedStages(this->noelle, LDI, i);
+
+    /*
+     * Publish the values that are still buffered in batched queues.
+     */
+    if (this->enableBatchedQueues){
+      flushValueQueues(this->noelle, i);
+    }
+
     /*
      * Store final results to loop live-out variables.
      * Generate a store to propagate the information about which exit block has been taken from the parallelized loop to the code outside it.
@@ -19,6 +19,8 @@ DSWPTask::DSWPTask (
   Module &M
   )
   : Task{ID, taskSignature, M},
+    numberOfReplicas{1},
+    iterationCounter{nullptr},
     stageSCCs{},
     clonableSCCs{}
   {
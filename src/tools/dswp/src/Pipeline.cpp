@@ -149,11 +149,28 @@ void DSWP::createPipelineFromStages (LoopDependenceInfo *LDI, Noelle &par) {
    */
   auto queueSizesPtr = createQueueSizesArrayFromStages(LDI, builder, par);
 
+  /*
+   * Allocate the arrays that describe the replication of the stages.
+   * The first one specifies the number of threads of each stage.
+   * The second one specifies the replicated stage connected to each queue (-1 if none).
+   */
+  std::vector<int64_t> stageReplicas;
+  for (auto task : this->tasks) {
+    stageReplicas.push_back(((DSWPTask *)task)->numberOfReplicas);
+  }
+  auto stageReplicasPtr = createInt64ArrayFromValues(stageReplicas, builder, par);
+  std::vector<int64_t> queueReplicatedStages;
+  for (auto &queue : this->packedQueues) {
+    queueReplicatedStages.push_back(queue->replicatedStage);
+  }
+  auto queueReplicatedStagesPtr = createInt64ArrayFromValues(queueReplicatedStages, builder, par);
+
   /*
    * Call the stage dispatcher with the environment, queues array, and stages array
    */
-  auto queuesCount = cast<Value>(ConstantInt::get(par.int64, this->queues.size()));
+  auto queuesCount = cast<Value>(ConstantInt::get(par.int64, this->packedQueues.size()));
   auto stagesCount = cast<Value>(ConstantInt::get(par.int64, this->numTaskInstances));
+  auto loopID = cast<Value>(ConstantInt::get(par.int64, LDI->getID()));
 
   /*
    * Add the call to the task dispatcher
@@ -161,9 +178,12 @@ void DSWP::createPipelineFromStages (LoopDependenceInfo *LDI, Noelle &par) {
   auto runtimeCall = builder.CreateCall(taskDispatcher, ArrayRef<Value*>({
     envPtr,
     queueSizesPtr,
+    queueReplicatedStagesPtr,
     stagesPtr,
+    stageReplicasPtr,
     stagesCount,
-    queuesCount
+    queuesCount,
+    loopID
   }));
   auto numThreadsUsed = builder.CreateExtractValue(runtimeCall, (uint64_t)0);
 
@@ -204,9 +224,9 @@ Value * DSWP::createQueueSizesArrayFromStages (
   IRBuilder<> funcBuilder,
   Noelle &par
 ) {
-  auto queuesAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->queues.size())));
-  for (int i = 0; i < this->queues.size(); ++i) {
-    auto &queue = this->queues[i];
+  auto queuesAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->packedQueues.size())));
+  for (uint64_t i = 0; i < this->packedQueues.size(); ++i) {
+    auto &queue = this->packedQueues[i];
     auto queueIndex = cast<Value>(ConstantInt::get(par.int64, i));
     auto queuePtr = funcBuilder.CreateInBoundsGEP(queuesAlloca, ArrayRef<Value*>({
       this->zeroIndexForBaseArray,
@@ -218,3 +238,21 @@ Value * DSWP::createQueueSizesArrayFromStages (
 
   return cast<Value>(funcBuilder.CreateBitCast(queuesAlloca, PointerType::getUnqual(par.int64)));
 }
+
+Value * DSWP::createInt64ArrayFromValues (
+  std::vector<int64_t> &values,
+  IRBuilder<> funcBuilder,
+  Noelle &par
+) {
+  auto arrayAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, values.size())));
+  for (uint64_t i = 0; i < values.size(); ++i) {
+    auto index = cast<Value>(ConstantInt::get(par.int64, i));
+    auto elementPtr = funcBuilder.CreateInBoundsGEP(arrayAlloca, ArrayRef<Value*>({
+      this->zeroIndexForBaseArray,
+      index
+    }));
+    funcBuilder.CreateStore(ConstantInt::get(par.int64, values[i]), elementPtr);
+  }
+
+  return cast<Value>(funcBuilder.CreateBitCast(arrayAlloca, PointerType::getUnqual(par.int64)));
+}
@@ -38,17 +38,6 @@ void DSWP::registerQueue (
     this->queues.push_back(std::move(std::make_unique<QueueInfo>(producer, consumer, producer->getType(), isMemoryDependence)));
     fromStage->producerToQueues[producer].insert(queueIndex);
     queueInfo = this->queues[queueIndex].get();
-
-    /*
-     * Confirm a new queue is of a size handled by the parallelizer
-     */
-    auto& queueTypes = par.queues.queueSizeToIndex;
-    bool byteSize = queueTypes.find(queueInfo->bitLength) != queueTypes.end();
-    if (!byteSize) {
-      errs() << "NOT SUPPORTED BYTE SIZE (" << queueInfo->bitLength << "): "; producer->getType()->print(errs()); errs() <<  "\n";
-      producer->print(errs() << "Producer: "); errs() << "\n";
-      abort();
-    }
   }
 
   /*
@@ -245,6 +234,106 @@ void DSWP::collectDataAndMemoryQueueInfo (LoopDependenceInfo *LDI, Noelle &par)
   }
 }
 
+void DSWP::packQueues (Noelle &par) {
+
+  /*
+   * Group the queues by the pair of stages they connect and by the basic block of their producer.
+   * Each group becomes a packed queue.
+   */
+  std::map<std::tuple<int, int, BasicBlock *>, int> groupToPackedQueue;
+  for (uint64_t queueIndex = 0; queueIndex < this->queues.size(); ++queueIndex) {
+    auto queueInfo = this->queues[queueIndex].get();
+    auto group = std::make_tuple(queueInfo->fromStage, queueInfo->toStage, queueInfo->producer->getParent());
+    if (groupToPackedQueue.find(group) == groupToPackedQueue.end()) {
+      groupToPackedQueue[group] = this->packedQueues.size();
+      auto packedQueue = std::make_unique<PackedQueueInfo>();
+      packedQueue->fromStage = queueInfo->fromStage;
+      packedQueue->toStage = queueInfo->toStage;
+      packedQueue->replicatedStage = -1;
+      packedQueue->isIterationToken = false;
+      this->packedQueues.push_back(std::move(packedQueue));
+    }
+    auto packedQueueIndex = groupToPackedQueue[group];
+    auto packedQueue = this->packedQueues[packedQueueIndex].get();
+    queueInfo->packedQueueIndex = packedQueueIndex;
+    queueInfo->fieldIndex = packedQueue->queues.size();
+    packedQueue->queues.push_back(queueIndex);
+  }
+
+  /*
+   * Define the record of each packed queue.
+   */
+  auto program = this->noelle.getProgram();
+  auto &DL = program->getDataLayout();
+  for (auto &packedQueue : this->packedQueues) {
+    if (packedQueue->queues.size() == 1) {
+
+      /*
+       * Single values of the widths the runtime has a queue for do not need a record.
+       */
+      auto queueInfo = this->queues[packedQueue->queues[0]].get();
+      packedQueue->recordType = queueInfo->dependentType;
+      auto& queueTypes = par.queues.queueSizeToIndex;
+      if (queueTypes.find(queueInfo->bitLength) != queueTypes.end()) {
+        packedQueue->isRecord = false;
+        packedQueue->bitLength = queueInfo->bitLength;
+        continue ;
+      }
+
+    } else {
+      std::vector<Type *> fieldTypes;
+      for (auto queueIndex : packedQueue->queues) {
+        fieldTypes.push_back(this->queues[queueIndex]->dependentType);
+      }
+      packedQueue->recordType = StructType::get(program->getContext(), fieldTypes);
+    }
+    packedQueue->isRecord = true;
+    packedQueue->bitLength = DL.getTypeAllocSize(packedQueue->recordType) * 8;
+  }
+
+  /*
+   * Track packed queue indices in stages
+   */
+  for (auto techniqueTask : this->tasks) {
+    auto task = (DSWPTask *)techniqueTask;
+    for (auto queueIndex : task->pushValueQueues) {
+      task->pushPackedQueues.insert(this->queues[queueIndex]->packedQueueIndex);
+    }
+    for (auto queueIndex : task->popValueQueues) {
+      task->popPackedQueues.insert(this->queues[queueIndex]->packedQueueIndex);
+    }
+  }
+
+  return ;
+}
+
+Function * DSWP::getQueuePushFunction (Noelle &par, PackedQueueInfo *packedQueue) const {
+  if (packedQueue->isRecord) {
+    return this->enableBatchedQueues ? par.queues.queueBatchedPushRecord : par.queues.queuePushRecord;
+  }
+  auto &queuePushes = this->enableBatchedQueues ? par.queues.queueBatchedPushes : par.queues.queuePushes;
+
+  return queuePushes[par.queues.queueSizeToIndex[packedQueue->bitLength]];
+}
+
+Function * DSWP::getQueuePopFunction (Noelle &par, PackedQueueInfo *packedQueue) const {
+  if (packedQueue->isRecord) {
+    return this->enableBatchedQueues ? par.queues.queueBatchedPopRecord : par.queues.queuePopRecord;
+  }
+  auto &queuePops = this->enableBatchedQueues ? par.queues.queueBatchedPops : par.queues.queuePops;
+
+  return queuePops[par.queues.queueSizeToIndex[packedQueue->bitLength]];
+}
+
+Function * DSWP::getQueueFlushFunction (Noelle &par, PackedQueueInfo *packedQueue) const {
+  assert(this->enableBatchedQueues);
+  if (packedQueue->isRecord) {
+    return par.queues.queueBatchedFlushRecord;
+  }
+
+  return par.queues.queueBatchedFlushes[par.queues.queueSizeToIndex[packedQueue->bitLength]];
+}
+
 bool DSWP::areQueuesAcyclical () const {
 
   /*
@@ -291,83 +380,160 @@ void DSWP::generateLoadsOfQueuePointers (
   /*
    * Load this stage's relevant queues
    */
-  auto loadQueuePtrFromIndex = [&](int queueIndex) -> void {
-    auto queueInfo = this->queues[queueIndex].get();
-    auto queueIndexValue = cast<Value>(ConstantInt::get(par.int64, queueIndex));
+  auto loadQueuePtrFromIndex = [&](int packedQueueIndex) -> void {
+    auto packedQueue = this->packedQueues[packedQueueIndex].get();
+    auto queueIndexValue = cast<Value>(ConstantInt::get(par.int64, packedQueue->firstSlot));
     auto queuePtr = entryBuilder.CreateInBoundsGEP(queuesArray, ArrayRef<Value*>({
       this->zeroIndexForBaseArray,
       queueIndexValue
     }));
-    auto parQueueIndex = par.queues.queueSizeToIndex[queueInfo->bitLength];
-    auto queueType = par.queues.queueTypes[parQueueIndex];
-    auto queueElemType = par.queues.queueElementTypes[parQueueIndex];
+    Type *queueType;
+    Type *queueElemType;
+    if (packedQueue->isRecord) {
+      queueType = par.queues.recordQueueType;
+      queueElemType = par.int8;
+    } else {
+      auto parQueueIndex = par.queues.queueSizeToIndex[packedQueue->bitLength];
+      queueType = par.queues.queueTypes[parQueueIndex];
+      if (this->enableBatchedQueues){
+        queueType = par.queues.batchedQueueTypes[parQueueIndex];
+      }
+      queueElemType = par.queues.queueElementTypes[parQueueIndex];
+    }
     auto queueCast = entryBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(queueType));
 
     auto queueInstrs = std::make_unique<QueueInstrs>();
+    queueInstrs->queueSlotPtr = queueCast;
     queueInstrs->queuePtr = entryBuilder.CreateLoad(queueCast);
-    queueInstrs->alloca = entryBuilder.CreateAlloca(queueInfo->dependentType);
+    queueInstrs->alloca = entryBuilder.CreateAlloca(packedQueue->recordType);
     queueInstrs->allocaCast = entryBuilder.CreateBitCast(
       queueInstrs->alloca,
       PointerType::getUnqual(queueElemType)
     );
-    task->queueInstrMap[queueIndex] = std::move(queueInstrs);
+    task->queueInstrMap[packedQueueIndex] = std::move(queueInstrs);
   };
 
-  for (auto queueIndex : task->pushValueQueues) loadQueuePtrFromIndex(queueIndex);
-  for (auto queueIndex : task->popValueQueues) loadQueuePtrFromIndex(queueIndex);
+  for (auto packedQueueIndex : task->pushPackedQueues) loadQueuePtrFromIndex(packedQueueIndex);
+  for (auto packedQueueIndex : task->popPackedQueues) loadQueuePtrFromIndex(packedQueueIndex);
 }
 
 void DSWP::popValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex) {
   auto task = (DSWPTask *)this->tasks[taskIndex];
 
-  for (auto queueIndex : task->popValueQueues) {
-    auto &queueInfo = this->queues[queueIndex];
-    auto queueInstrs = task->queueInstrMap[queueIndex].get();
+  for (auto packedQueueIndex : task->popPackedQueues) {
+    auto packedQueue = this->packedQueues[packedQueueIndex].get();
+    if (packedQueue->isIterationToken) {
+      continue ;
+    }
+    auto queueInstrs = task->queueInstrMap[packedQueueIndex].get();
     auto queueCallArgs = ArrayRef<Value*>({ queueInstrs->queuePtr, queueInstrs->allocaCast });
 
     /*
-     * Determine the clone of the basic block of the original producer
+     * Determine the clone of the basic block of the original producers (they all belong to the same one)
      * Insert load right there
      */
-    auto originalB = queueInfo->producer->getParent();
+    auto originalB = this->queues[packedQueue->queues[0]]->producer->getParent();
     assert(task->isAnOriginalBasicBlock(originalB));
     auto clonedB = task->getCloneOfOriginalBasicBlock(originalB);
     Instruction *insertionPoint = clonedB->getFirstNonPHIOrDbgOrLifetime();
     IRBuilder<> builder(insertionPoint);
-    auto queuePopFunction = par.queues.queuePops[par.queues.queueSizeToIndex[queueInfo->bitLength]];
+    auto queuePopFunction = this->getQueuePopFunction(par, packedQueue);
     queueInstrs->queueCall = builder.CreateCall(queuePopFunction, queueCallArgs);
-    queueInstrs->load = builder.CreateLoad(queueInstrs->alloca);
 
     /*
+     * Load the values from the record
      * Map from producer to queue load 
      */
-    task->addInstruction(queueInfo->producer, cast<Instruction>(queueInstrs->load));
+    for (auto queueIndex : packedQueue->queues) {
+      auto &queueInfo = this->queues[queueIndex];
+      auto valuePtr = queueInstrs->alloca;
+      if (packedQueue->queues.size() > 1) {
+        valuePtr = builder.CreateStructGEP(queueInstrs->alloca, queueInfo->fieldIndex);
+      }
+      auto load = builder.CreateLoad(valuePtr);
+      task->addInstruction(queueInfo->producer, cast<Instruction>(load));
+    }
   }
 }
 
 void DSWP::pushValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex) {
   auto task = (DSWPTask *)this->tasks[taskIndex];
 
-  for (auto queueIndex : task->pushValueQueues) {
-    auto queueInstrs = task->queueInstrMap[queueIndex].get();
-    auto queueInfo = this->queues[queueIndex].get();
+  for (auto packedQueueIndex : task->pushPackedQueues) {
+    auto packedQueue = this->packedQueues[packedQueueIndex].get();
+    if (packedQueue->isIterationToken) {
+      continue ;
+    }
+    auto queueInstrs = task->queueInstrMap[packedQueueIndex].get();
     auto queueCallArgs = ArrayRef<Value*>({ queueInstrs->queuePtr, queueInstrs->allocaCast });
-    auto queuePushFunction = par.queues.queuePushes[par.queues.queueSizeToIndex[queueInfo->bitLength]];
+    auto queuePushFunction = this->getQueuePushFunction(par, packedQueue);
+
+    /*
+     * Find the last producer of the record within the clone of their basic block
+     */
+    std::set<Instruction *> producerClones;
+    for (auto queueIndex : packedQueue->queues) {
+      producerClones.insert(task->getCloneOfOriginalInstruction(this->queues[queueIndex]->producer));
+    }
+    auto producerCloneBlock = (*producerClones.begin())->getParent();
+    Instruction *lastProducerClone = nullptr;
+    for (auto &I : *producerCloneBlock) {
+      if (producerClones.find(&I) != producerClones.end()) {
+        lastProducerClone = &I;
+      }
+    }
+    assert(lastProducerClone != nullptr);
 
     /*
-     * Store the produced value immediately
-     * Push the value immediately
+     * Store the produced values right after the last producer
+     * Push the record immediately
      */
-    auto producerBlock = queueInfo->producer->getParent();
-    auto producerClone = task->getCloneOfOriginalInstruction(queueInfo->producer);
-    auto producerCloneBlock = producerClone->getParent();
-    auto insertPoint = producerClone->getNextNode();
+    auto insertPoint = lastProducerClone->getNextNode();
     if (isa<PHINode>(insertPoint)) {
       insertPoint = producerCloneBlock->getFirstNonPHIOrDbgOrLifetime();
     }
     IRBuilder<> builder(insertPoint);
-    builder.CreateStore(producerClone, queueInstrs->alloca);
+    for (auto queueIndex : packedQueue->queues) {
+      auto &queueInfo = this->queues[queueIndex];
+      auto producerClone = task->getCloneOfOriginalInstruction(queueInfo->producer);
+      auto valuePtr = queueInstrs->alloca;
+      if (packedQueue->queues.size() > 1) {
+        valuePtr = builder.CreateStructGEP(queueInstrs->alloca, queueInfo->fieldIndex);
+      }
+      builder.CreateStore(producerClone, valuePtr);
+    }
     queueInstrs->queueCall = builder.CreateCall(queuePushFunction, queueCallArgs);
+  }
+}
 
+void DSWP::flushValueQueues (Noelle &par, int taskIndex) {
+  auto task = (DSWPTask *)this->tasks[taskIndex];
+
+  /*
+   * Batched queues publish the values pushed by this stage a block at a time.
+   * Publish the last blocks, which might be partially filled, before the stage returns.
+   */
+  auto exitBlock = task->getExit();
+  IRBuilder<> builder(exitBlock->getTerminator());
+  for (auto packedQueueIndex : task->pushPackedQueues) {
+    auto packedQueue = this->packedQueues[packedQueueIndex].get();
+    auto queueInstrs = task->queueInstrMap[packedQueueIndex].get();
+    auto queueFlushFunction = this->getQueueFlushFunction(par, packedQueue);
+    if (  false
+          || (packedQueue->replicatedStage == -1)
+          || (packedQueue->replicatedStage == taskIndex)
+       ){
+      builder.CreateCall(queueFlushFunction, ArrayRef<Value*>({ queueInstrs->queuePtr }));
+      continue ;
+    }
+
+    /*
+     * The stage pushed values to every replica of the stage at the other end of the packed queue.
+     */
+    for (auto slot = 0; slot < packedQueue->numberOfSlots; ++slot) {
+      auto slotIndex = cast<Value>(ConstantInt::get(par.int64, slot));
+      auto queuePtr = builder.CreateLoad(builder.CreateInBoundsGEP(queueInstrs->queueSlotPtr, slotIndex));
+      builder.CreateCall(queueFlushFunction, ArrayRef<Value*>({ queuePtr }));
+    }
   }
 }
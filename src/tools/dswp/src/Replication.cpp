@@ -0,0 +1,374 @@
+/*
+ * Copyright 2016 - 2019  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DSWP.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+void DSWP::replicateStages (LoopDependenceInfo *LDI, Heuristics *h) {
+
+  /*
+   * Check if stages can be replicated.
+   *
+   * Replicas consume the values of a batched queue only when a block of them is published.
+   * A replica could then wait for values its producer will not publish until another replica makes progress.
+   */
+  if (  false
+        || (!this->enableStageReplication)
+        || this->enableBatchedQueues
+     ){
+    return ;
+  }
+
+  /*
+   * Identify the stages that can be replicated.
+   */
+  std::vector<bool> replicableStages;
+  auto doesNonReplicableStageExist = false;
+  for (auto techniqueTask : this->tasks) {
+    auto task = (DSWPTask *)techniqueTask;
+    auto canBeReplicated = this->canStageBeReplicated(LDI, task);
+    replicableStages.push_back(canBeReplicated);
+    doesNonReplicableStageExist |= !canBeReplicated;
+  }
+
+  /*
+   * Iterations are handed to replicas by a stage that runs all of them.
+   */
+  if (!doesNonReplicableStageExist){
+    return ;
+  }
+
+  /*
+   * Assign the cores to the stages.
+   *
+   * Two replicated stages cannot be connected by a queue.
+   * Hence, when this happens, the stage that got fewer cores is not replicated and the cores are assigned again.
+   */
+  auto stages = this->partitioner->getDepthOrderedSets();
+  auto ltm = LDI->getLoopTransformationsManager();
+  std::vector<uint64_t> threads;
+  while (true) {
+    threads = h->assignCoresToStagesForDSWP(
+      *LDI->getSCCManager(),
+      stages,
+      replicableStages,
+      ltm->getMaximumNumberOfCores(),
+      this->verbose
+    );
+
+    auto isAssignmentValid = true;
+    for (auto &packedQueue : this->packedQueues) {
+      auto fromStage = packedQueue->fromStage;
+      auto toStage = packedQueue->toStage;
+      if (  false
+            || (threads[fromStage] == 1)
+            || (threads[toStage] == 1)
+         ){
+        continue ;
+      }
+      auto stageToSerialize = (threads[fromStage] < threads[toStage]) ? fromStage : toStage;
+      replicableStages[stageToSerialize] = false;
+      isAssignmentValid = false;
+      break ;
+    }
+    if (isAssignmentValid){
+      break ;
+    }
+  }
+
+  /*
+   * Record the replicas.
+   */
+  DSWPTask *tokenProducer = nullptr;
+  for (uint64_t i = 0; i < this->tasks.size(); ++i) {
+    auto task = (DSWPTask *)this->tasks[i];
+    task->numberOfReplicas = threads[i];
+    if (  true
+          && (tokenProducer == nullptr)
+          && (task->numberOfReplicas == 1)
+       ){
+      tokenProducer = task;
+    }
+  }
+  assert(tokenProducer != nullptr);
+
+  /*
+   * Mark the packed queues that are implemented by a queue per replica.
+   */
+  for (auto &packedQueue : this->packedQueues) {
+    auto fromStage = (DSWPTask *)this->tasks[packedQueue->fromStage];
+    auto toStage = (DSWPTask *)this->tasks[packedQueue->toStage];
+    if (fromStage->numberOfReplicas > 1) {
+      packedQueue->replicatedStage = packedQueue->fromStage;
+    } else if (toStage->numberOfReplicas > 1) {
+      packedQueue->replicatedStage = packedQueue->toStage;
+    }
+  }
+
+  /*
+   * Add the queues that tell replicas which iterations to run.
+   */
+  auto &cxt = this->noelle.getProgram()->getContext();
+  for (auto techniqueTask : this->tasks) {
+    auto task = (DSWPTask *)techniqueTask;
+    if (task->numberOfReplicas == 1) {
+      continue ;
+    }
+
+    auto packedQueueIndex = this->packedQueues.size();
+    auto packedQueue = std::make_unique<PackedQueueInfo>();
+    packedQueue->fromStage = tokenProducer->getID();
+    packedQueue->toStage = task->getID();
+    packedQueue->isRecord = false;
+    packedQueue->recordType = IntegerType::get(cxt, 1);
+    packedQueue->bitLength = 1;
+    packedQueue->replicatedStage = task->getID();
+    packedQueue->isIterationToken = true;
+    this->packedQueues.push_back(std::move(packedQueue));
+
+    tokenProducer->pushPackedQueues.insert(packedQueueIndex);
+    task->popPackedQueues.insert(packedQueueIndex);
+  }
+
+  return ;
+}
+
+bool DSWP::canStageBeReplicated (LoopDependenceInfo *LDI, DSWPTask *task) {
+
+  /*
+   * Every SCC of the stage must not depend on other iterations.
+   */
+  auto sccManager = LDI->getSCCManager();
+  for (auto scc : task->stageSCCs) {
+    if (!sccManager->getSCCAttrs(scc)->canExecuteIndependently()) {
+      return false;
+    }
+  }
+
+  /*
+   * A replica runs only some iterations.
+   * Hence, neither the instructions of the stage nor the ones it clones (e.g., induction variables) can be involved in loop-carried dependences.
+   */
+  std::unordered_set<Value *> stageValues;
+  for (auto sccs : { &task->stageSCCs, &task->clonableSCCs }) {
+    for (auto scc : *sccs) {
+      for (auto nodePair : scc->internalNodePairs()) {
+        stageValues.insert(nodePair.first);
+      }
+    }
+  }
+  auto loopStructure = LDI->getLoopStructure();
+  for (auto edge : LDI->getLoopDG()->getEdges()) {
+    if (  false
+          || (!edge->isLoopCarriedDependence())
+          || edge->isControlDependence()
+       ){
+      continue ;
+    }
+    auto producer = edge->getOutgoingT();
+    auto consumer = edge->getIncomingT();
+    if (  true
+          && (stageValues.find(producer) == stageValues.end())
+          && (stageValues.find(consumer) == stageValues.end())
+       ){
+      continue ;
+    }
+
+    /*
+     * Dependences carried by sub-loops are fine.
+     */
+    if (LDI->getNestedMostLoopStructure(cast<Instruction>(consumer)) != loopStructure) {
+      continue ;
+    }
+
+    return false;
+  }
+
+  /*
+   * Which replica runs the last iteration is known only at run time.
+   * Hence, the stage cannot store live-out variables.
+   */
+  auto envUser = this->envBuilder->getUser(task->getID());
+  auto liveOutIndices = envUser->getEnvIndicesOfLiveOutVars();
+  if (liveOutIndices.begin() != liveOutIndices.end()) {
+    return false;
+  }
+
+  return true;
+}
+
+void DSWP::allocateQueueSlots (void) {
+
+  /*
+   * The queue array of a stage has a slot per queue allocated by the runtime.
+   * A packed queue connected to a replicated stage has a slot per replica.
+   */
+  this->numberOfQueueSlots = 0;
+  for (auto &packedQueue : this->packedQueues) {
+    packedQueue->firstSlot = this->numberOfQueueSlots;
+    packedQueue->numberOfSlots = 1;
+    if (packedQueue->replicatedStage != -1) {
+      auto replicatedStage = (DSWPTask *)this->tasks[packedQueue->replicatedStage];
+      packedQueue->numberOfSlots = replicatedStage->numberOfReplicas;
+    }
+    this->numberOfQueueSlots += packedQueue->numberOfSlots;
+  }
+
+  return ;
+}
+
+void DSWP::routeQueuesOfReplicatedStages (Noelle &par, LoopDependenceInfo *LDI, int taskIndex) {
+  auto task = (DSWPTask *)this->tasks[taskIndex];
+
+  /*
+   * Fetch the clone of the header.
+   */
+  auto loopHeader = LDI->getLoopStructure()->getHeader();
+  auto headerClone = task->getCloneOfOriginalBasicBlock(loopHeader);
+
+  /*
+   * Check if the stage is replicated.
+   *
+   * Replicas use their own queues, which the runtime stores in the first slot of each packed queue.
+   * Hence, a replica only needs to wait for the token of its next iteration before starting it.
+   */
+  if (task->numberOfReplicas > 1) {
+    for (auto packedQueueIndex : task->popPackedQueues) {
+      auto packedQueue = this->packedQueues[packedQueueIndex].get();
+      if (!packedQueue->isIterationToken) {
+        continue ;
+      }
+
+      /*
+       * Pop the token before anything else of the iteration.
+       */
+      auto queueInstrs = task->queueInstrMap[packedQueueIndex].get();
+      IRBuilder<> builder(headerClone->getFirstNonPHIOrDbgOrLifetime());
+      auto queuePopFunction = this->getQueuePopFunction(par, packedQueue);
+      queueInstrs->queueCall = builder.CreateCall(queuePopFunction, ArrayRef<Value*>({ queueInstrs->queuePtr, queueInstrs->allocaCast }));
+      auto token = cast<Instruction>(builder.CreateLoad(queueInstrs->alloca));
+
+      /*
+       * Exit if the token says the iteration is run by another replica.
+       */
+      auto iterationBB = headerClone->splitBasicBlock(token->getNextNode()->getIterator(), "iterationOfReplica");
+      headerClone->getTerminator()->eraseFromParent();
+      IRBuilder<> headerBuilder(headerClone);
+      headerBuilder.CreateCondBr(token, iterationBB, task->getExit());
+    }
+
+    return ;
+  }
+
+  /*
+   * Collect the packed queues that connect the stage to replicated ones.
+   */
+  std::vector<int> routedPackedQueues;
+  for (auto packedQueueIndices : { &task->pushPackedQueues, &task->popPackedQueues }) {
+    for (auto packedQueueIndex : *packedQueueIndices) {
+      if (this->packedQueues[packedQueueIndex]->replicatedStage != -1) {
+        routedPackedQueues.push_back(packedQueueIndex);
+      }
+    }
+  }
+  if (routedPackedQueues.size() == 0) {
+    return ;
+  }
+
+  /*
+   * Count the iterations.
+   * The counter is incremented before any queue is used by the iteration.
+   */
+  IRBuilder<> entryBuilder(task->getEntry()->getTerminator());
+  task->iterationCounter = entryBuilder.CreateAlloca(par.int64);
+  entryBuilder.CreateStore(ConstantInt::get(par.int64, -1), task->iterationCounter);
+  IRBuilder<> headerBuilder(headerClone->getFirstNonPHIOrDbgOrLifetime());
+  auto previousIteration = headerBuilder.CreateLoad(task->iterationCounter);
+  auto currentIteration = headerBuilder.CreateAdd(previousIteration, ConstantInt::get(par.int64, 1));
+  headerBuilder.CreateStore(currentIteration, task->iterationCounter);
+
+  /*
+   * Tell the replica of each replicated stage to run the current iteration.
+   */
+  auto &cxt = task->getTaskBody()->getContext();
+  for (auto packedQueueIndex : task->pushPackedQueues) {
+    auto packedQueue = this->packedQueues[packedQueueIndex].get();
+    if (!packedQueue->isIterationToken) {
+      continue ;
+    }
+    auto queueInstrs = task->queueInstrMap[packedQueueIndex].get();
+    headerBuilder.CreateStore(ConstantInt::getTrue(cxt), queueInstrs->alloca);
+    auto queuePushFunction = this->getQueuePushFunction(par, packedQueue);
+    queueInstrs->queueCall = headerBuilder.CreateCall(queuePushFunction, ArrayRef<Value*>({ queueInstrs->queuePtr, queueInstrs->allocaCast }));
+  }
+
+  /*
+   * Use the queue of the replica that runs the current iteration.
+   */
+  for (auto packedQueueIndex : routedPackedQueues) {
+    auto queueCall = cast<CallInst>(task->queueInstrMap[packedQueueIndex]->queueCall);
+    auto queuePtr = this->getQueuePointerOfCurrentIteration(task, packedQueueIndex, queueCall, 0);
+    queueCall->setArgOperand(0, queuePtr);
+  }
+
+  /*
+   * The replica that runs the last iteration exits the loop as the original code does.
+   * Tell the other replicas to exit.
+   */
+  auto exitTerminator = task->getExit()->getTerminator();
+  IRBuilder<> exitBuilder(exitTerminator);
+  for (auto packedQueueIndex : task->pushPackedQueues) {
+    auto packedQueue = this->packedQueues[packedQueueIndex].get();
+    if (!packedQueue->isIterationToken) {
+      continue ;
+    }
+    auto queueInstrs = task->queueInstrMap[packedQueueIndex].get();
+    auto queuePushFunction = this->getQueuePushFunction(par, packedQueue);
+    for (auto nextIteration = 1; nextIteration < packedQueue->numberOfSlots; ++nextIteration) {
+      auto queuePtr = this->getQueuePointerOfCurrentIteration(task, packedQueueIndex, exitTerminator, nextIteration);
+      exitBuilder.CreateStore(ConstantInt::getFalse(cxt), queueInstrs->alloca);
+      exitBuilder.CreateCall(queuePushFunction, ArrayRef<Value*>({ queuePtr, queueInstrs->allocaCast }));
+    }
+  }
+
+  return ;
+}
+
+Value * DSWP::getQueuePointerOfCurrentIteration (
+  DSWPTask *task,
+  int packedQueueIndex,
+  Instruction *insertPoint,
+  int64_t iterationOffset
+) {
+  assert(task->iterationCounter != nullptr);
+  auto packedQueue = this->packedQueues[packedQueueIndex].get();
+
+  /*
+   * Compute the slot of the replica that runs the iteration.
+   */
+  IRBuilder<> builder(insertPoint);
+  auto int64 = this->noelle.int64;
+  Value *iteration = builder.CreateLoad(task->iterationCounter);
+  if (iterationOffset != 0) {
+    iteration = builder.CreateAdd(iteration, ConstantInt::get(int64, iterationOffset));
+  }
+  auto slot = builder.CreateURem(iteration, ConstantInt::get(int64, packedQueue->numberOfSlots));
+
+  /*
+   * Load the queue stored in the slot.
+   */
+  auto queueInstrs = task->queueInstrMap[packedQueueIndex].get();
+  auto slotPtr = builder.CreateInBoundsGEP(queueInstrs->queueSlotPtr, slot);
+  auto queuePtr = builder.CreateLoad(slotPtr);
+
+  return queuePtr;
+}
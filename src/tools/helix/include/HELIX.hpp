@@ -26,6 +26,7 @@
 namespace llvm::noelle {
 
   class SpilledLoopCarriedDependency;
+  class HELIXTask;
 
   class HELIX : public ParallelizationTechniqueForLoopsWithLoopCarriedDataDependences {
     public:
@@ -35,7 +36,9 @@ namespace llvm::noelle {
        */
       HELIX (
         Noelle &n,
-        bool forceParallelization
+        bool forceParallelization,
+        bool deterministicReductions,
+        bool chunkIterations
       );
 
       bool apply (
@@ -51,7 +54,7 @@ namespace llvm::noelle {
       PDG * constructTaskInternalDependenceGraphFromOriginalLoopDG (
         LoopDependenceInfo *LDI,
         PostDominatorTree &postDomTreeOfTaskFunction
-      );
+      ) override ;
 
       Function * getTaskFunction (void) const ;
 
@@ -121,7 +124,7 @@ namespace llvm::noelle {
         DataFlowResult *reachabilityDFR
       );
 
-      void scheduleSequentialSegments (
+      bool scheduleSequentialSegments (
         LoopDependenceInfo *LDI,
         std::vector<SequentialSegment *> *sss,
         DataFlowResult *reachabilityDFR
@@ -132,6 +135,11 @@ namespace llvm::noelle {
         std::vector<SequentialSegment *> *sss
       );
 
+      void signalOnlyAtTheEndOfChunks (
+        HELIXTask *helixTask,
+        BasicBlock *loopHeader
+      );
+
       void inlineCalls (
         Task *task
       );
@@ -140,6 +148,10 @@ namespace llvm::noelle {
         LoopDependenceInfo *LDI
       );
 
+      uint32_t computeNumberOfIterationsPerChunk (
+        LoopDependenceInfo *LDI
+      ) const ;
+
     private:
       Function *waitSSCall, *signalSSCall;
       LoopDependenceInfo *originalLDI;
@@ -150,15 +162,13 @@ namespace llvm::noelle {
       std::unordered_map<Instruction *, Instruction *> lastIterationExecutionDuplicateMap;
       BasicBlock *lastIterationExecutionBlock;
       bool enableInliner;
+      bool deterministicReductions;
+      bool chunkIterations;
+      uint32_t iterationsPerChunk;
+      PHINode *chunkPHI;
       Function *taskDispatcherSS;
       Function *taskDispatcherCS;
 
-      void squeezeSequentialSegment (
-        LoopDependenceInfo *LDI,
-        DataFlowResult *reachabilityDFR,
-        SequentialSegment *ss
-      );
-
       DataFlowResult *computeReachabilityFromInstructions (LoopDependenceInfo *LDI) ;
 
   };
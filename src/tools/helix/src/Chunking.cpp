@@ -0,0 +1,94 @@
+/*
+ * Copyright 2016 - 2022  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "HELIX.hpp"
+
+namespace llvm::noelle {
+
+uint32_t HELIX::computeNumberOfIterationsPerChunk (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Check if we have been asked to chunk iterations.
+   */
+  if (!this->chunkIterations){
+    return 1;
+  }
+
+  /*
+   * The size of the chunks is chosen from the profiles.
+   */
+  auto profiles = this->noelle.getProfiles();
+  auto loopStructure = LDI->getLoopStructure();
+  if (  false
+        || (!profiles->isAvailable())
+        || (!profiles->hasBeenExecuted(loopStructure))
+     ){
+    return 1;
+  }
+
+  /*
+   * Estimate the instructions of an iteration that run within sequential segments and the ones that do not.
+   */
+  auto averageInstructions = profiles->getAverageTotalInstructionsPerIteration(loopStructure);
+  auto sequentialFraction = this->computeSequentialFractionOfExecution(LDI, this->noelle);
+  auto sequentialInstructions = averageInstructions * sequentialFraction;
+  auto parallelInstructions = averageInstructions - sequentialInstructions;
+
+  /*
+   * Estimate the cost of a wait/signal pair, which moves the cache line of a sequential segment between two cores.
+   * This matches the cost of a value sent through a queue (see InvocationLatency).
+   */
+  const double synchronizationCost = 100;
+
+  /*
+   * A core executes the sequential segments of the iterations of a chunk one after the other.
+   * The next core waits only once for the whole chunk, but it waits also for the parallel code that runs between these sequential segments.
+   * Hence, the sequential chain of iterations costs (per iteration):
+   *    sequentialInstructions + parallelInstructions * (chunk - 1) / chunk + synchronizationCost / chunk
+   *
+   * The cores cannot run faster than (sequentialInstructions + parallelInstructions) / cores per iteration either.
+   *
+   * Pick the smallest chunk that minimizes the maximum between the two.
+   */
+  auto ltm = LDI->getLoopTransformationsManager();
+  auto cores = ltm->getMaximumNumberOfCores();
+  auto averageIterations = profiles->getAverageLoopIterationsPerInvocation(loopStructure);
+  auto estimateCostPerIteration = [&](uint32_t iterationsPerChunk) -> double {
+    auto chainCost = sequentialInstructions
+      + ((parallelInstructions * (iterationsPerChunk - 1)) / iterationsPerChunk)
+      + (synchronizationCost / iterationsPerChunk);
+    auto throughputCost = averageInstructions / cores;
+    return std::max(chainCost, throughputCost);
+  };
+  const uint32_t maximumIterationsPerChunk = 64;
+  uint32_t bestIterationsPerChunk = 1;
+  auto bestCost = estimateCostPerIteration(1);
+  for (uint32_t iterationsPerChunk = 2; iterationsPerChunk <= maximumIterationsPerChunk; iterationsPerChunk *= 2){
+
+    /*
+     * Every core must execute at least one chunk of a typical invocation of the loop.
+     */
+    if ((iterationsPerChunk * cores) > averageIterations){
+      break ;
+    }
+
+    auto cost = estimateCostPerIteration(iterationsPerChunk);
+    if (cost < bestCost){
+      bestCost = cost;
+      bestIterationsPerChunk = iterationsPerChunk;
+    }
+  }
+
+  return bestIterationsPerChunk;
+}
+
+}
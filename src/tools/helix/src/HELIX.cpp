@@ -15,13 +15,19 @@ namespace llvm::noelle{
 
 HELIX::HELIX (
   Noelle &n,
-  bool forceParallelization
+  bool forceParallelization,
+  bool deterministicReductions,
+  bool chunkIterations
   )
   : ParallelizationTechniqueForLoopsWithLoopCarriedDataDependences{n, forceParallelization},
     loopCarriedLoopEnvironmentBuilder{nullptr}, 
     taskFunctionDG{nullptr},
     lastIterationExecutionBlock{nullptr},
-    enableInliner{true}
+    enableInliner{true},
+    deterministicReductions{deterministicReductions},
+    chunkIterations{chunkIterations},
+    iterationsPerChunk{1},
+    chunkPHI{nullptr}
   {
 
   /*
@@ -59,7 +65,6 @@ HELIX::HELIX (
     ptrType,
     ptrType,
     ptrType,
-    ptrType,
     int64,
     int64,
     PointerType::getUnqual(int64)
@@ -78,6 +83,23 @@ bool HELIX::canBeAppliedToLoop (LoopDependenceInfo *LDI, Heuristics *h) const {
     return false;
   }
 
+  /*
+   * Iterations are distributed round-robin among the threads used at run time.
+   * Hence, floating point values cannot be reduced the same way by every invocation of the loop.
+   */
+  if (  true
+        && this->deterministicReductions
+        && (  false
+              || this->doesReduceFloatingPointVariables(LDI)
+              || this->doesReduceFloatingPointArrays(LDI)
+           )
+     ){
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "HELIX:   The loop reduces floating point values, which cannot be reduced deterministically\n";
+    }
+    return false;
+  }
+
   /*
    * Check if we are forced to parallelize
    */
@@ -97,7 +119,8 @@ bool HELIX::canBeAppliedToLoop (LoopDependenceInfo *LDI, Heuristics *h) const {
   auto loopStructure = LDI->getLoopStructure();
   auto averageInstructions = profiles->getAverageTotalInstructionsPerIteration(loopStructure);
   auto averageInstructionThreshold = 20;
-  auto hasLittleExecution = averageInstructions < averageInstructionThreshold;
+  auto iterationsPerChunk = this->computeNumberOfIterationsPerChunk(LDI);
+  auto hasLittleExecution = (averageInstructions * iterationsPerChunk) < averageInstructionThreshold;
   auto maximumSequentialFraction = .2;
   auto sequentialFraction = this->computeSequentialFractionOfExecution(LDI, this->noelle);
   auto hasProportionallySignificantSequentialExecution = sequentialFraction >= maximumSequentialFraction;
@@ -239,6 +262,14 @@ void HELIX::createParallelizableTask (
   this->numTaskInstances = ltm->getMaximumNumberOfCores();
   assert(helixTask == this->tasks[0]);
 
+  /*
+   * Decide how many consecutive iterations each core executes between synchronizations.
+   */
+  this->iterationsPerChunk = this->computeNumberOfIterationsPerChunk(LDI);
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << "HELIX:  Iterations per chunk = " << this->iterationsPerChunk << "\n";
+  }
+
   /*
    * Fetch the environment of the loop
    */
@@ -414,13 +445,26 @@ bool HELIX::synchronizeTask (
   /*
    * Schedule the sequential segments to overlap parallel and sequential segments.
    */
-  this->scheduleSequentialSegments(LDI, &sequentialSegments, reachabilityDFR);
+  auto scheduled = this->scheduleSequentialSegments(LDI, &sequentialSegments, reachabilityDFR);
 
   /*
    * Delete reachability results here before we decide whether to continue with the HELIX parallelization
    */
   delete reachabilityDFR;
 
+  /*
+   * The entries and exits of the sequential segments are instructions.
+   * Hence, they need to be identified again if code has been moved around them.
+   */
+  if (scheduled) {
+    for (auto ss : sequentialSegments) {
+      delete ss;
+    }
+    reachabilityDFR = this->computeReachabilityFromInstructions(LDI);
+    sequentialSegments = this->identifySequentialSegments(originalLDI, LDI, reachabilityDFR);
+    delete reachabilityDFR;
+  }
+
   /*
    * Check if any sequential segment's entry and exit frontier spans the entire loop execution
    * If so, do not parallelize
@@ -528,6 +572,12 @@ bool HELIX::synchronizeTask (
     helixTask->addBasicBlock(originalSingleExitBlock, cloneLoopExitBlock);
   }
 
+  /*
+   * Accumulate values of reduced arrays to private copies.
+   * This must follow the identification of sequential segments, which relies on the original accesses to these arrays.
+   */
+  this->privatizeArrayReductions(this->originalLDI, 0);
+
   /*
    * Link the parallelize code to the original one.
    */
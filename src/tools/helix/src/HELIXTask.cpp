@@ -31,8 +31,7 @@ void HELIXTask::extractFuncArgs (void) {
   auto argIter = this->F->arg_begin();
   this->envArg = (Value *) &*(argIter++);
   this->loopCarriedArrayArg = (Value *) &*(argIter++);
-  this->ssPastArrayArg = (Value *) &*(argIter++);
-  this->ssFutureArrayArg = (Value *) &*(argIter++);
+  this->ssArrayArg = (Value *) &*(argIter++);
   this->coreArg = (Value *) &*(argIter++); 
   this->numCoresArg = (Value *) &*(argIter++);
   this->loopIsOverFlagArg = (Value *) &*(argIter++);
@@ -30,8 +30,7 @@ namespace llvm::noelle {
        */
       Value *coreArg;
       Value *numCoresArg;
-      Value *ssPastArrayArg;
-      Value *ssFutureArrayArg;
+      Value *ssArrayArg;
       Value *loopCarriedArrayArg;
       Value *loopIsOverFlagArg;
 
@@ -9,108 +9,16 @@
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "HELIX.hpp"
-#include "HELIXTask.hpp"
-#include <set>
 
 using namespace llvm;
 using namespace llvm::noelle;
 
-static void constructEdgesFromUseDefs (PDG *pdg);
-static void constructEdgesFromControlForFunction (PDG *pdg, Function &F, PostDominatorTree &postDomTree);
-
 PDG * HELIX::constructTaskInternalDependenceGraphFromOriginalLoopDG (LoopDependenceInfo *LDI, PostDominatorTree &postDomTreeOfTaskFunction) {
 
   /*
-   * Fetch the task.
-   */
-  auto helixTask = static_cast<HELIXTask *>(this->tasks[0]);
-  auto taskBody = helixTask->getTaskBody();
-
-  /*
-   * Create a new PDG for the internals of the task.
-   */
-  this->taskFunctionDG = new PDG(*taskBody);
-  constructEdgesFromUseDefs(this->taskFunctionDG);
-
-  constructEdgesFromControlForFunction(this->taskFunctionDG, *taskBody, postDomTreeOfTaskFunction);
-
-  auto copyEdgeUsingTaskClonedValues = [&](DGEdge<Value> *originalEdge) -> void {
-      DGEdge<Value> edgeToPointToClones(*originalEdge);
-
-      // Loop carry dependencies will be recomputed
-      edgeToPointToClones.setLoopCarried(false);
-
-      edgeToPointToClones.setNodePair(
-        this->taskFunctionDG->fetchNode(helixTask->getCloneOfOriginalInstruction(cast<Instruction>(originalEdge->getOutgoingT()))),
-        this->taskFunctionDG->fetchNode(helixTask->getCloneOfOriginalInstruction(cast<Instruction>(originalEdge->getIncomingT())))
-      );
-      this->taskFunctionDG->copyAddEdge(edgeToPointToClones);
-  };
-
-  /*
-   * Derive intra-iteration memory dependencies from original dependence graph
+   * Derive the register, control, and intra-iteration memory dependences of the task.
    */
-  for (auto nodePair : LDI->getLoopDG()->internalNodePairs()) {
-
-    /*
-     * Fetch the value.
-     */
-    auto value = nodePair.first;
-
-    /*
-     * We only care about instructions that can generate memory dependences.
-     */
-    if (  true
-          && (!isa<StoreInst>(value))
-          && (!isa<LoadInst>(value))
-          && (!isa<CallInst>(value))
-       ){
-      continue ;
-    }
-
-    /*
-     * Check the dependence.
-     */
-    for (auto edge : nodePair.second->getOutgoingEdges()) {
-
-      /*
-       * We only care about memory dependences.
-       */
-      if (!edge->isMemoryDependence()){
-        continue ;
-      }
-
-      /*
-       * This is a memory dependence.
-       *
-       * Check if it is due to lifetime intrinsics.
-       */
-      auto srcValue = edge->getIncomingT();
-      auto dstValue = edge->getOutgoingT();
-      if (auto valueAsCallInst = dyn_cast<CallInst>(srcValue)){
-        if (valueAsCallInst->isLifetimeStartOrEnd()){
-          continue ;
-        }
-      }
-      if (auto valueAsCallInst = dyn_cast<CallInst>(dstValue)){
-        if (valueAsCallInst->isLifetimeStartOrEnd()){
-          continue ;
-        }
-      }
-
-      /*
-       * We only care about instruction within the parallelized loop.
-       */
-      if (!LDI->getLoopDG()->isInternal(srcValue)) {
-        continue ;
-      }
-
-      /*
-       * Copy the dependence.
-       */
-      copyEdgeUsingTaskClonedValues(edge);
-    }
-  }
+  this->taskFunctionDG = ParallelizationTechnique::constructTaskInternalDependenceGraphFromOriginalLoopDG(LDI, postDomTreeOfTaskFunction);
 
   auto aliasStoresAndLoadsOfMemoryLocation = [&](
     std::unordered_set<StoreInst *> &stores,
@@ -138,61 +46,5 @@ PDG * HELIX::constructTaskInternalDependenceGraphFromOriginalLoopDG (LoopDepende
     aliasStoresAndLoadsOfMemoryLocation(spill->environmentStores, spill->environmentLoads);
   }
 
-  // if (this->verbose >= Verbosity::Maximal) {
-  //   auto sccdag = new SCCDAG(taskFunctionDG);
-  //   DGPrinter::writeGraph<PDG, Value>("technique-task-fdg-" + std::to_string(LDI->getID()) + ".dot", taskFunctionDG);
-  //   DGPrinter::writeGraph<SCCDAG, SCC>("technique-task-sccdag-" + std::to_string(LDI->getID()) + ".dot", sccdag);
-  //   delete sccdag;
-  // }
-
   return this->taskFunctionDG;
 }
-
-/*
- * HACK: Copied straight from PDGAnalysis. Refactor and provide from pdg WITHOUT requiring alias analysis dependencies
- */
-static void constructEdgesFromUseDefs (PDG *pdg){
-  for (auto node : make_range(pdg->begin_nodes(), pdg->end_nodes())) {
-    auto pdgValue = node->getT();
-    if (pdgValue->getNumUses() == 0)
-      continue;
-
-    for (auto& U : pdgValue->uses()) {
-      auto user = U.getUser();
-
-      if (isa<Instruction>(user) || isa<Argument>(user)) {
-        auto edge = pdg->addEdge(pdgValue, user);
-        edge->setMemMustType(false, true, DG_DATA_RAW);
-      }
-    }
-  }
-}
-
-/*
- * HACK: Copied straight from PDGAnalysis. Refactor and provide from pdg WITHOUT requiring alias analysis dependencies
- */
-static void constructEdgesFromControlForFunction (PDG *pdg, Function &F, PostDominatorTree &postDomTree) {
-  for (auto &B : F)
-  {
-    SmallVector<BasicBlock *, 10> dominatedBBs;
-    postDomTree.getDescendants(&B, dominatedBBs);
-
-    /*
-     * For each basic block that B post dominates, check if B doesn't stricly post dominate its predecessor
-     * If it does not, then there is a control dependency from the predecessor to B 
-     */
-    for (auto dominatedBB : dominatedBBs)
-    {
-      for (auto predBB : make_range(pred_begin(dominatedBB), pred_end(dominatedBB)))
-      {
-        if (postDomTree.properlyDominates(&B, predBB)) continue;
-        auto controlTerminator = predBB->getTerminator();
-        for (auto &I : B)
-        {
-          auto edge = pdg->addEdge((Value*)controlTerminator, (Value*)&I);
-          edge->setControl(true);
-        }
-      }
-    }
-  }
-}
@@ -77,9 +77,24 @@ void HELIX::rewireLoopForIVsToIterateNthIterations (LoopDependenceInfo *LDI) {
    */
   auto clonedStepSizeMap = cloneIVStepValueComputation(LDI, 0, entryBuilder);
 
+  /*
+   * Fetch the first iteration executed by the task.
+   *
+   * Each core executes chunks of consecutive iterations.
+   * Without chunking, a chunk is a single iteration and the first iteration is core_id.
+   * Otherwise, it is core_id * iterations_per_chunk and we keep track of the progress on the current chunk.
+   */
+  Value *firstIteration = task->coreArg;
+  if (this->iterationsPerChunk > 1){
+    auto chunkCounterType = task->coreArg->getType();
+    auto chunkSize = ConstantInt::get(chunkCounterType, this->iterationsPerChunk);
+    firstIteration = entryBuilder.CreateMul(task->coreArg, chunkSize, "coreIdx_X_chunkSize");
+    this->chunkPHI = IVUtility::createChunkPHI(preheaderClone, headerClone, chunkCounterType, chunkSize);
+  }
+
   /*
    * Determine start value of the IV for the task
-   * core_start: original_start + original_step_size * core_id
+   * core_start: original_start + original_step_size * first_iteration
    */
   for (auto ivInfo : ivInfos) {
     auto startOfIV = fetchClone(ivInfo->getStartValue());
@@ -87,13 +102,15 @@ void HELIX::rewireLoopForIVsToIterateNthIterations (LoopDependenceInfo *LDI) {
     auto originalIVPHI = ivInfo->getLoopEntryPHI();
     auto ivPHI = cast<PHINode>(fetchClone(originalIVPHI));
 
-    auto offsetStartValue = IVUtility::computeInductionVariableValueForIteration(preheaderClone, ivPHI, startOfIV, stepOfIV, task->coreArg);
+    auto offsetStartValue = IVUtility::computeInductionVariableValueForIteration(preheaderClone, ivPHI, startOfIV, stepOfIV, firstIteration);
     ivPHI->setIncomingValueForBlock(preheaderClone, offsetStartValue);
   }
 
   /*
    * Determine additional step size to account for n cores each executing the task
-   * jump_step_size: original_step_size * (num_cores - 1)
+   * jump_step_size: original_step_size * (num_cores - 1) * iterations_per_chunk
+   *
+   * With chunking, the IVs jump only at the end of a chunk.
    */
   for (auto ivInfo : ivInfos) {
     auto stepOfIV = clonedStepSizeMap.at(ivInfo);
@@ -104,9 +121,19 @@ void HELIX::rewireLoopForIVsToIterateNthIterations (LoopDependenceInfo *LDI) {
           task->numCoresArg,
           ConstantInt::get(task->numCoresArg->getType(), 1)
         );
-    Value* jumpStepSize = IVUtility::scaleInductionVariableStep(preheaderClone, ivPHI, stepOfIV, numCoresMinusOne);
+    if (this->chunkPHI == nullptr){
+      Value* jumpStepSize = IVUtility::scaleInductionVariableStep(preheaderClone, ivPHI, stepOfIV, numCoresMinusOne);
+      IVUtility::stepInductionVariablePHI(preheaderClone, ivPHI, jumpStepSize);
+      continue ;
+    }
 
-    IVUtility::stepInductionVariablePHI(preheaderClone, ivPHI, jumpStepSize);
+    auto iterationsToSkip = entryBuilder.CreateMul(
+          numCoresMinusOne,
+          ConstantInt::get(task->numCoresArg->getType(), this->iterationsPerChunk),
+          "numCoresMinus1_X_chunkSize"
+        );
+    auto chunkStepSize = IVUtility::scaleInductionVariableStep(preheaderClone, ivPHI, stepOfIV, iterationsToSkip);
+    IVUtility::chunkInductionVariablePHI(preheaderClone, ivPHI, this->chunkPHI, chunkStepSize);
   }
 
   /*
@@ -227,6 +254,13 @@ void HELIX::rewireLoopForIVsToIterateNthIterations (LoopDependenceInfo *LDI) {
     originalInstsThatMustMove.push_back(&I);
   }
 
+  /*
+   * The progress on the current chunk is tracked by the header.
+   */
+  if (this->chunkPHI != nullptr){
+    cloneInstsThatCanStayInTheNewHeader.insert(this->chunkPHI);
+  }
+
   /*
    * Collect the instruction in the old header of the task that must move.
    */
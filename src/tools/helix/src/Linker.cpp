@@ -42,6 +42,14 @@ void HELIX::addChunkFunctionExecutionAsideOriginalLoop (
   auto envPtr = envBuilder->getEnvironmentArrayVoidPtr();
   auto loopCarriedEnvPtr = this->loopCarriedLoopEnvironmentBuilder->getEnvironmentArrayVoidPtr();
 
+  /*
+   * Fetch the size of the environment of spilled loop-carried values.
+   * The helper threads of the runtime prefetch it.
+   */
+  auto &DL = this->noelle.getProgram()->getDataLayout();
+  auto loopCarriedEnvBytes = DL.getTypeAllocSize(this->loopCarriedLoopEnvironmentBuilder->getEnvironmentArrayType());
+  auto loopCarriedEnvSize = ConstantInt::get(this->noelle.int64, loopCarriedEnvBytes);
+
   /*
    * Fetch the number of cores
    */
@@ -54,15 +62,40 @@ void HELIX::addChunkFunctionExecutionAsideOriginalLoop (
   auto numOfSS = ConstantInt::get(this->noelle.int64, numberOfSequentialSegments);
 
   /*
-   * Call the function that incudes the parallelized loop.
+   * Fetch the ID of the loop, which identifies it in the telemetry of the runtime.
+   */
+  auto loopID = ConstantInt::get(this->noelle.int64, LDI->getID());
+
+  /*
+   * Compute the number of iterations the loop is going to execute (0 if we cannot).
+   * The runtime uses it to choose the number of threads of the current invocation.
    */
   IRBuilder<> helixBuilder(this->entryPointOfParallelizedLoop);
+  Value *numberOfIterations = ConstantInt::get(this->noelle.int64, 0);
+  if (this->canComputeTheNumberOfIterations(LDI)){
+    numberOfIterations = this->generateCodeToComputeTheNumberOfIterations(LDI, helixBuilder);
+    assert(numberOfIterations != nullptr);
+  }
+
+  /*
+   * Generate the function that combines the private copies of reduced live-out variables when task instances end.
+   */
+  auto combinerPointerType = cast<PointerType>(this->taskDispatcherSS->getFunctionType()->getParamType(2));
+  auto reductionCombiner = this->generateReductionCombiner(LDI, combinerPointerType);
+
+  /*
+   * Call the function that incudes the parallelized loop.
+   */
   auto runtimeCall = helixBuilder.CreateCall(this->taskDispatcherSS, ArrayRef<Value *>({
     (Value *)tasks[0]->getTaskBody(),
     envPtr,
+    reductionCombiner,
     loopCarriedEnvPtr,
+    loopCarriedEnvSize,
     numCores,
-    numOfSS
+    numOfSS,
+    numberOfIterations,
+    loopID
   }));
   auto numThreadsUsed = helixBuilder.CreateExtractValue(runtimeCall, (uint64_t)0);
 
@@ -15,32 +15,6 @@
 using namespace llvm;
 using namespace llvm::noelle;
 
-/*
- * Heuristic used: push furthest outlier instructions closer to the rest of the sequential segment
- * by moving between control flow equivalent sets of basic blocks
- */
-void HELIX::squeezeSequentialSegment (
-  LoopDependenceInfo *LDI,
-  DataFlowResult *reachabilityDFR,
-  SequentialSegment *ss
-  ){
-
-  /*
-   * Fetch ControlFlowEquivalence and dependence graph
-   * TODO: Move this to LDI
-   */
-  auto loops = LDI->getLoopHierarchyStructures();
-  auto rootLoop = loops->getLoop();
-  auto taskFunction = rootLoop->getHeader()->getParent();
-  auto taskDG = LDI->getLoopDG();
-  DominatorTree taskDT(*taskFunction);
-  PostDominatorTree taskPDT(*taskFunction);
-  DominatorSummary taskDS(taskDT, taskPDT);
-  ControlFlowEquivalence cfe(&taskDS, loops, rootLoop);
-
-  return ;
-}
-
 void HELIX::squeezeSequentialSegments (
   LoopDependenceInfo *LDI,
   std::vector<SequentialSegment *> *sss,
@@ -68,12 +42,37 @@ void HELIX::squeezeSequentialSegments (
   return ;
 }
 
-void HELIX::scheduleSequentialSegments (
+bool HELIX::scheduleSequentialSegments (
   LoopDependenceInfo *LDI,
   std::vector<SequentialSegment *> *sss,
   DataFlowResult *reachabilityDFR
   ){
-  //TODO
 
-  return ;
+  /*
+   * Every core waits for the previous one at the entry of a sequential segment and signals the next one at its exit.
+   * Hence, the code between the first and the last instruction of a segment is on the critical path of the loop, while the rest can overlap with other iterations.
+   *
+   * Move the code that belongs to no sequential segment out of them.
+   * Code a segment depends on is hoisted before its wait, and the rest is sunk after its signal.
+   * This way, a core signals the next one before running unrelated work.
+   */
+  auto sccdagAttribution = LDI->getSCCManager();
+  auto sccdag = sccdagAttribution->getSCCDAG();
+  std::unordered_set<SCCSet *> sccPartitions;
+  for (auto ss : *sss) {
+    auto ssPartition = new SCCSet();
+    for (auto scc : ss->getSCCs()) {
+      ssPartition->sccs.insert(scc);
+    }
+    sccPartitions.insert(ssPartition);
+  }
+
+  SCCPartitionScheduler scheduler(sccdag, sccPartitions, reachabilityDFR);
+  auto modified = scheduler.moveUnrelatedInstructionsOutOfPartitions();
+
+  for (auto ssPartition : sccPartitions) {
+    delete ssPartition;
+  }
+
+  return modified;
 }
@@ -171,6 +171,16 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments (
         continue;
       }
 
+      /*
+       * Do not synchronize the progress on the current chunk, which is private to each core (see rewireLoopForIVsToIterateNthIterations)
+       */
+      if (  true
+            && (this->chunkPHI != nullptr)
+            && scc->isInternal(this->chunkPHI)
+         ){
+        continue ;
+      }
+
       /*
        * If the SCC is due to a control dependence, but the number of iterations can be computed just before executing the loop, then we can skip it.
        */
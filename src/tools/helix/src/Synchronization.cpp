@@ -99,13 +99,12 @@ void HELIX::addSynchronizations (
   };
 
   /*
-   * Fetch sequential segments entry in the past and future array
+   * Fetch sequential segments entry in the array shared by all cores
    * Allocate space to track sequential segment entry state
    */
-  std::vector<Value *> ssPastPtrs{}, ssFuturePtrs{}, ssStates{};
+  std::vector<Value *> ssPtrs{}, ssStates{};
   for (auto ss : *sss) {
-    ssPastPtrs.push_back(fetchEntry(helixTask->ssPastArrayArg, ss->getID()));
-    ssFuturePtrs.push_back(fetchEntry(helixTask->ssFutureArrayArg, ss->getID()));
+    ssPtrs.push_back(fetchEntry(helixTask->ssArrayArg, ss->getID()));
 
     /*
      * We must execute exactly one wait instruction for each sequential segment, for each loop iteration, and for each thread.
@@ -119,6 +118,18 @@ void HELIX::addSynchronizations (
     ssStates.push_back(ssStateAlloca);
   }
 
+  /*
+   * Allocate space to track the ticket of the current iteration (or chunk of iterations).
+   *
+   * Tickets are given to iterations in order: the core coreArg runs the iterations with tickets coreArg, coreArg + numCoresArg, and so on.
+   * The runtime lets an iteration enter a sequential segment once the ones with smaller tickets have left it.
+   * The ticket is updated at the beginning of every iteration (see the header below).
+   */
+  auto ticketAlloca = entryBuilder.CreateAlloca(int64);
+  ticketAlloca->moveBefore(helixTask->getEntry()->getFirstNonPHIOrDbgOrLifetime());
+  auto ticketBeforeTheFirstIteration = entryBuilder.CreateSub(helixTask->coreArg, helixTask->numCoresArg);
+  entryBuilder.CreateStore(ticketBeforeTheFirstIteration, ticketAlloca);
+
   /*
    * Define the code that inject wait instructions.
    */
@@ -157,7 +168,8 @@ void HELIX::addSynchronizations (
     auto ssWaitBBName = "SS" + std::to_string(ss->getID()) + "-wait";
     auto ssWaitBB = BasicBlock::Create(cxt, ssWaitBBName, helixTask->getTaskBody());
     IRBuilder<> ssWaitBuilder(ssWaitBB);
-    auto wait = ssWaitBuilder.CreateCall(this->waitSSCall, { ssPastPtrs.at(ss->getID()) });
+    auto ticket = ssWaitBuilder.CreateLoad(ticketAlloca);
+    auto wait = ssWaitBuilder.CreateCall(this->waitSSCall, { ssPtrs.at(ss->getID()), ticket });
     auto ssState = ssStates.at(ss->getID());
     ssWaitBuilder.CreateStore(ConstantInt::get(int64, 1), ssState);
     ssWaitBuilder.CreateBr(ssEntryBB);
@@ -193,14 +205,16 @@ void HELIX::addSynchronizations (
     if (!justBeforeExitBr || justBeforeExitBr->isUnconditional()) {
       Instruction *insertPoint = terminator == justBeforeExit ? terminator : justBeforeExit->getNextNode();
       IRBuilder<> beforeExitBuilder(insertPoint);
-      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { ssFuturePtrs.at(ss->getID()) });
+      auto ticket = beforeExitBuilder.CreateLoad(ticketAlloca);
+      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { ssPtrs.at(ss->getID()), ticket });
       helixTask->signals.insert(cast<CallInst>(signal));
       return;
     }
 
     for (auto successorBlock : successors(block)) {
       IRBuilder<> beforeExitBuilder(successorBlock->getFirstNonPHIOrDbgOrLifetime());
-      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { ssFuturePtrs.at(ss->getID()) });
+      auto ticket = beforeExitBuilder.CreateLoad(ticketAlloca);
+      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { ssPtrs.at(ss->getID()), ticket });
       helixTask->signals.insert(cast<CallInst>(signal));
     }
   };
@@ -278,11 +292,36 @@ void HELIX::addSynchronizations (
     auto isFlagSet = checkFlagBuilder.CreateICmpEQ(ConstantInt::get(int64, 1), flagValue);
     checkFlagBuilder.CreateCondBr(isFlagSet, failedCheckBB, afterCheckBB);
 
+    /*
+     * The signals complete the ticket of the current iteration.
+     * Hence, they must wait for the iterations before it (if they have not already) to keep the tickets in order.
+     */
     IRBuilder<> failedCheckBuilder(failedCheckBB);
     auto brToExit = failedCheckBuilder.CreateBr(helixTask->getExit());
-    for (auto ss : *sss) injectSignal(ss, brToExit);
+    for (auto ss : *sss) {
+      injectWait(ss, brToExit);
+      injectSignal(ss, brToExit);
+    }
   };
 
+  /*
+   * Compute the ticket of the current iteration at the beginning of it.
+   * This has to be done before any synchronization of the iteration.
+   */
+  IRBuilder<> ticketBuilder(loopHeader->getFirstNonPHIOrDbgOrLifetime());
+  Value *ticketIncrement = helixTask->numCoresArg;
+  if (this->chunkPHI != nullptr){
+
+    /*
+     * With chunking, all iterations of a chunk share the ticket of the chunk.
+     */
+    auto isFirstIterationOfChunk = ticketBuilder.CreateICmpEQ(this->chunkPHI, ConstantInt::get(this->chunkPHI->getType(), 0));
+    ticketIncrement = ticketBuilder.CreateSelect(isFirstIterationOfChunk, ticketIncrement, ConstantInt::get(int64, 0));
+  }
+  auto ticketOfThePreviousIteration = ticketBuilder.CreateLoad(ticketAlloca);
+  auto ticketOfTheCurrentIteration = ticketBuilder.CreateAdd(ticketOfThePreviousIteration, ticketIncrement);
+  auto ticketStore = ticketBuilder.CreateStore(ticketOfTheCurrentIteration, ticketAlloca);
+
   /*
    * Once the preamble has been synchronized, if that was necessary, synchronize each sequential segment
    */
@@ -292,10 +331,23 @@ void HELIX::addSynchronizations (
      * Reset the value of ssState at the beginning of the iteration
      * NOTE: This has to be done BEFORE any preamble synchronization, so this
      * insertion comes after the check exit logic has already been inserted
+     * and after the computation of the ticket
      */
-    auto firstLoopInst = loopHeader->getFirstNonPHIOrDbgOrLifetime();
+    auto firstLoopInst = ticketStore->getNextNode();
     IRBuilder<> headerBuilder(firstLoopInst);
-    headerBuilder.CreateStore(ConstantInt::get(int64, 0), ssStates.at(ss->getID()));
+    auto ssState = ssStates.at(ss->getID());
+    Value *ssStateAtTheBeginningOfTheIteration = ConstantInt::get(int64, 0);
+    if (this->chunkPHI != nullptr){
+
+      /*
+       * With chunking, the wait is needed only by the first iteration of a chunk.
+       * The other iterations of the chunk keep the ssState of the previous one.
+       */
+      auto isFirstIterationOfChunk = headerBuilder.CreateICmpEQ(this->chunkPHI, ConstantInt::get(this->chunkPHI->getType(), 0));
+      auto ssStateOfThePreviousIteration = headerBuilder.CreateLoad(ssState);
+      ssStateAtTheBeginningOfTheIteration = headerBuilder.CreateSelect(isFirstIterationOfChunk, ssStateAtTheBeginningOfTheIteration, ssStateOfThePreviousIteration);
+    }
+    headerBuilder.CreateStore(ssStateAtTheBeginningOfTheIteration, ssState);
 
     /*
      * Inject waits.
@@ -369,6 +421,59 @@ void HELIX::addSynchronizations (
     }
   }
 
+  /*
+   * With chunking, the next core waits only once per chunk (see the reset of ssState above).
+   * Hence, the signals that can be followed by another iteration must run only at the last iteration of a chunk.
+   *
+   * NOTE: The signals that run when leaving the loop are not guarded because the chunk is over.
+   */
+  if (this->chunkPHI != nullptr){
+    this->signalOnlyAtTheEndOfChunks(helixTask, loopHeader);
+  }
+
+  return ;
+}
+
+void HELIX::signalOnlyAtTheEndOfChunks (
+  HELIXTask *helixTask,
+  BasicBlock *loopHeader
+){
+
+  /*
+   * Collect the basic blocks that can reach the header of the loop.
+   */
+  std::unordered_set<BasicBlock *> blocksThatCanReachTheHeader;
+  std::queue<BasicBlock *> toVisit;
+  toVisit.push(loopHeader);
+  while (!toVisit.empty()){
+    auto bb = toVisit.front();
+    toVisit.pop();
+    for (auto predecessor : predecessors(bb)){
+      if (blocksThatCanReachTheHeader.insert(predecessor).second){
+        toVisit.push(predecessor);
+      }
+    }
+  }
+
+  /*
+   * Guard the signals that can be followed by another iteration.
+   */
+  auto lastIterationOfChunk = ConstantInt::get(this->chunkPHI->getType(), this->iterationsPerChunk - 1);
+  for (auto signal : helixTask->signals){
+    auto signalBB = signal->getParent();
+    if (blocksThatCanReachTheHeader.find(signalBB) == blocksThatCanReachTheHeader.end()){
+      continue ;
+    }
+
+    /*
+     * Move the signal to a basic block that runs only if the current iteration is the last one of its chunk.
+     */
+    IRBuilder<> checkBuilder(signal);
+    auto isLastIterationOfChunk = checkBuilder.CreateICmpEQ(this->chunkPHI, lastIterationOfChunk);
+    auto signalTerminator = SplitBlockAndInsertIfThen(isLastIterationOfChunk, signal, false);
+    signal->moveBefore(signalTerminator);
+  }
+
   return ;
 }
 
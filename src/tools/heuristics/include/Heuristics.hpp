@@ -41,6 +41,19 @@ namespace llvm::noelle {
         Verbosity verbose
       );
 
+      /*
+       * Return the number of threads to run each DSWP stage (@stages) with.
+       * Only the stages in @replicableStages can run on more than one thread.
+       * The returned numbers sum up to at most @numThreads unless there are more stages than threads.
+       */
+      std::vector<uint64_t> assignCoresToStagesForDSWP (
+        SCCDAGAttrs &attrs,
+        std::vector<SCCSet *> &stages,
+        std::vector<bool> &replicableStages,
+        uint64_t numThreads,
+        Verbosity verbose
+      );
+
      private:
 
       void minMaxMergePartition (
@@ -30,6 +30,58 @@ void Heuristics::adjustParallelizationPartitionForDSWP (
   minMaxMergePartition(*partitioner, attrs, numThreads, verbose);
 }
 
+std::vector<uint64_t> Heuristics::assignCoresToStagesForDSWP (
+  SCCDAGAttrs &attrs,
+  std::vector<SCCSet *> &stages,
+  std::vector<bool> &replicableStages,
+  uint64_t numThreads,
+  Verbosity verbose
+) {
+  assert(stages.size() == replicableStages.size());
+
+  /*
+   * Every stage runs on at least one thread.
+   */
+  std::vector<uint64_t> threads(stages.size(), 1);
+  uint64_t assignedThreads = stages.size();
+
+  /*
+   * Estimate the latency of an iteration of each stage.
+   */
+  std::vector<uint64_t> latencies;
+  for (auto stage : stages) {
+    std::unordered_set<SCCSet *> sets{ stage };
+    latencies.push_back(invocationLatency.latencyPerInvocation(&attrs, sets));
+  }
+
+  /*
+   * The throughput of the pipeline is set by its slowest stage.
+   * A stage that runs on N threads completes an iteration every (latency / N) on average.
+   * Give one more thread to the slowest stage until either it cannot be replicated or we run out of threads.
+   */
+  while (assignedThreads < numThreads) {
+    uint64_t slowestStage = 0;
+    for (uint64_t i = 1; i < stages.size(); ++i) {
+      if (latencies[i] * threads[slowestStage] > latencies[slowestStage] * threads[i]) {
+        slowestStage = i;
+      }
+    }
+    if (!replicableStages[slowestStage]) {
+      break ;
+    }
+    threads[slowestStage]++;
+    assignedThreads++;
+  }
+
+  if (verbose >= Verbosity::Minimal) {
+    for (uint64_t i = 0; i < stages.size(); ++i) {
+      errs() << "Heuristics:  DSWP stage " << i << " (latency " << latencies[i] << ") runs on " << threads[i] << " threads\n";
+    }
+  }
+
+  return threads;
+}
+
 void Heuristics::minMaxMergePartition (
   SCCDAGPartitioner &partitioner,
   SCCDAGAttrs &attrs,
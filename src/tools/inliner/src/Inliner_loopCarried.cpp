@@ -82,7 +82,9 @@ bool Inliner::inlineCallsInvolvedInLoopCarriedDataDependences (Noelle &noelle, n
        * If it is, then we disable all sub-loops to be considered because DOALL always takes priority and we don't parallelize nested loops at the moment.
        */
       DOALL doall{
-        noelle
+        noelle,
+        false,
+        false
       };
       if (  true
             && (summaryNode->getNumberOfSubLoops() >= 1)
@@ -186,13 +186,16 @@ namespace llvm::noelle {
      * Compute the amount of time that can be saved by a parallelization technique per loop.
      */
     std::map<LoopDependenceInfo *, uint64_t> timeSavedLoops;
-    auto selector = [&noelle, &timeSavedLoops, profiles](StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
+    auto selector = [this, &noelle, &timeSavedLoops, profiles](StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
 
       /*
        * Fetch the loop.
        */
       auto ls = n->getLoop();
-      auto optimizations = { LoopDependenceInfoOptimization::MEMORY_CLONING_ID, LoopDependenceInfoOptimization::THREAD_SAFE_LIBRARY_ID};
+      std::unordered_set<LoopDependenceInfoOptimization> optimizations{ LoopDependenceInfoOptimization::MEMORY_CLONING_ID, LoopDependenceInfoOptimization::THREAD_SAFE_LIBRARY_ID};
+      if (this->enableRuntimeAliasChecks){
+        optimizations.insert(LoopDependenceInfoOptimization::RUNTIME_ALIAS_CHECKS_ID);
+      }
       auto ldi = noelle.getLoop(ls, optimizations);
 
       /*
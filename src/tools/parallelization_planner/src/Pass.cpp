@@ -16,11 +16,13 @@ namespace llvm::noelle {
  * Options of the Planner pass.
  */
 static cl::opt<bool> ForceParallelizationPlanner("noelle-parallelizer-force", cl::ZeroOrMore, cl::Hidden, cl::desc("Force the parallelization"));
+static cl::opt<bool> EnableRuntimeAliasChecksPlanner("noelle-parallelizer-runtime-alias-checks", cl::ZeroOrMore, cl::Hidden, cl::desc("Parallelize loops assuming their pointers do not alias and check it before running them"));
 
 Planner::Planner()
   :
     ModulePass{ID}, 
-    forceParallelization{false}
+    forceParallelization{false},
+    enableRuntimeAliasChecks{false}
 {
 
   return ;
@@ -28,6 +30,7 @@ Planner::Planner()
 
 bool Planner::doInitialization (Module &M) {
   this->forceParallelization = (ForceParallelizationPlanner.getNumOccurrences() > 0);
+  this->enableRuntimeAliasChecks = (EnableRuntimeAliasChecksPlanner.getNumOccurrences() > 0);
 
   return false; 
 }
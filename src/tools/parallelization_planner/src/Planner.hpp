@@ -62,6 +62,7 @@ namespace llvm::noelle {
        * Fields
        */
       bool forceParallelization;
+      bool enableRuntimeAliasChecks;
 
       /*
        * Methods
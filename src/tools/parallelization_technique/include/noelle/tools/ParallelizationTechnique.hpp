@@ -20,6 +20,7 @@
 #include "noelle/core/Hot.hpp"
 #include "noelle/core/PDGPrinter.hpp"
 #include "noelle/core/SubCFGs.hpp"
+#include "noelle/core/IVStepperUtility.hpp"
 
 namespace llvm::noelle {
 
@@ -54,6 +55,44 @@ namespace llvm::noelle {
       BasicBlock * getParLoopEntryPoint (void) const ;
       BasicBlock * getParLoopExitPoint (void) const ;
 
+      /*
+       * Instruction that waits for the parallelized loop when it is started without waiting for it.
+       * It is nullptr if the parallelized loop ends before its exit point.
+       */
+      Instruction * getParLoopJoinPoint (void) const ;
+
+      /*
+       * Can the number of iterations of the loop LDI be computed before the loop starts?
+       */
+      bool canComputeTheNumberOfIterations (
+        LoopDependenceInfo *LDI
+      ) const ;
+
+      /*
+       * Does the loop LDI reduce floating point live-out variables?
+       * The result of such reductions depends on how iterations are distributed among task instances as floating point operations are not associative.
+       */
+      bool doesReduceFloatingPointVariables (
+        LoopDependenceInfo *LDI
+      ) const ;
+
+      /*
+       * Does the loop LDI reduce arrays of floating point values (see ArrayReduction)?
+       */
+      bool doesReduceFloatingPointArrays (
+        LoopDependenceInfo *LDI
+      ) const ;
+
+      /*
+       * Build the dependence graph of the task generated by the last invocation of "apply".
+       * This is needed to analyze the loops nested in the parallelized one as the task includes their clones.
+       * The caller owns the returned graph.
+       */
+      virtual PDG * constructTaskInternalDependenceGraphFromOriginalLoopDG (
+        LoopDependenceInfo *LDI,
+        PostDominatorTree &postDomTreeOfTaskFunction
+      );
+
       /*
        * Destructor.
        */
@@ -101,6 +140,25 @@ namespace llvm::noelle {
         Value *numberOfThreadsExecuted
         );
 
+      /*
+       * Generate the function the runtime uses to combine the private copies of reduced live-out variables of two task instances when they end (see LoopEnvironmentBuilder::generateReductionCombiner).
+       * @combinerPointerType is the type of the dispatcher parameter that takes such function.
+       * Return a null pointer if the loop has no reduced live-out variables.
+       *
+       * If the function is generated, performReductionToAllReducableLiveOutVariables only reads the private copies of the task instance 0.
+       */
+      Value * generateReductionCombiner (
+        LoopDependenceInfo *LDI,
+        PointerType *combinerPointerType
+        );
+
+      void collectReductionOperationsOfLiveOutVariables (
+        LoopDependenceInfo *LDI,
+        std::unordered_map<int, int> &reducableBinaryOps,
+        std::unordered_map<int, CmpInst::Predicate> &reducableMinMaxPredicates,
+        std::unordered_map<int, std::pair<int, CmpInst::Predicate>> &pairedReducableVariables
+        );
+
       /*
        * Task helpers for manipulating loop body clones
        */
@@ -119,6 +177,15 @@ namespace llvm::noelle {
         int taskIndex
       );
 
+      /*
+       * Privatize the arrays reduced by the loop (e.g., histograms) within the task @taskIndex.
+       * Each instance of the task accumulates values to its own copy of an array, and it merges such copy into the array when it ends.
+       */
+      void privatizeArrayReductions (
+        LoopDependenceInfo *LDI,
+        int taskIndex
+      );
+
       std::unordered_map<InductionVariable *, Value *> cloneIVStepValueComputation (
         LoopDependenceInfo *LDI,
         int taskIndex,
@@ -216,6 +283,16 @@ namespace llvm::noelle {
         Noelle &par
       ) const ;
 
+      /*
+       * Generate the code to compute the number of iterations of the loop LDI.
+       * The code is added where "builder" points to, which must be before the loop.
+       * Return nullptr if the number of iterations cannot be computed before the loop starts.
+       */
+      Value * generateCodeToComputeTheNumberOfIterations (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> &builder
+      );
+
       /*
        * Debug
        */
@@ -229,12 +306,14 @@ namespace llvm::noelle {
       Noelle &noelle;
       Verbosity verbose;
       LoopEnvironmentBuilder *envBuilder;
+      Function *reductionCombiner;
 
       /*
        * Parallel task related information.
        */
       FunctionType *taskSignature;
       BasicBlock *entryPointOfParallelizedLoop, *exitPointOfParallelizedLoop;
+      Instruction *joinOfParallelizedLoop;
       std::vector<Task *> tasks;
       uint32_t numTaskInstances;
   };
@@ -15,7 +15,7 @@ namespace llvm::noelle {
 ParallelizationTechnique::ParallelizationTechnique (
   Noelle &n
   )
-  : noelle{n}, tasks{}, envBuilder{nullptr}
+  : noelle{n}, tasks{}, envBuilder{nullptr}, reductionCombiner{nullptr}, joinOfParallelizedLoop{nullptr}
   {
   this->verbose = n.getVerbosity();
 
@@ -168,11 +168,6 @@ BasicBlock * ParallelizationTechnique::performReductionToAllReducableLiveOutVari
   auto loopSummary = LDI->getLoopStructure();
   auto loopPreHeader = loopSummary->getPreHeader();
 
-  /*
-   * Fetch the SCC manager.
-   */
-  auto sccManager = LDI->getSCCManager();
-
   /*
    * Fetch the environment of the loop
    */
@@ -183,32 +178,34 @@ BasicBlock * ParallelizationTechnique::performReductionToAllReducableLiveOutVari
    * Collect reduction operation information needed to accumulate reducable variables after parallelization execution
    */
   std::unordered_map<int, int> reducableBinaryOps;
+  std::unordered_map<int, CmpInst::Predicate> reducableMinMaxPredicates;
+  std::unordered_map<int, std::pair<int, CmpInst::Predicate>> pairedReducableVariables;
   std::unordered_map<int, Value *> initialValues;
+  this->collectReductionOperationsOfLiveOutVariables(LDI, reducableBinaryOps, reducableMinMaxPredicates, pairedReducableVariables);
   for (auto envInd : environment->getEnvIndicesOfLiveOutVars()) {
     auto isReduced = envBuilder->isVariableReducable(envInd);
     if (!isReduced) continue;
 
     auto producer = environment->producerAt(envInd);
-    auto producerSCC = sccManager->getSCCDAG()->sccOfValue(producer);
-    auto producerSCCAttributes = sccManager->getSCCAttrs(producerSCC);
-
-    /*
-     * HACK: Need to get accumulator that feeds directly into producer PHI, not any intermediate one
-     */
-    auto firstAccumI = *(producerSCCAttributes->getAccumulators().begin());
-    auto binOpCode = firstAccumI->getOpcode();
-    reducableBinaryOps[envInd] = sccManager->accumOpInfo.accumOpForType(binOpCode, producer->getType());
-
     PHINode *loopEntryProducerPHI = this->fetchLoopEntryPHIOfProducer(LDI, producer);
     auto initValPHIIndex = loopEntryProducerPHI->getBasicBlockIndex(loopPreHeader);
     auto initialValue = loopEntryProducerPHI->getIncomingValue(initValPHIIndex);
     initialValues[envInd] = castToCorrectReducibleType(*builder, initialValue, producer->getType());
   }
 
+  /*
+   * If the private copies of the task instances have been combined already when tasks ended, then they are all in the private copies of the task instance 0.
+   */
+  if (this->reductionCombiner != nullptr){
+    numberOfThreadsExecuted = ConstantInt::get(numberOfThreadsExecuted->getType(), 1);
+    this->reductionCombiner = nullptr;
+  }
   auto afterReductionB = this->envBuilder->reduceLiveOutVariables(
     this->entryPointOfParallelizedLoop,
     *builder,
     reducableBinaryOps,
+    reducableMinMaxPredicates,
+    pairedReducableVariables,
     initialValues,
     numberOfThreadsExecuted);
 
@@ -262,6 +259,105 @@ BasicBlock * ParallelizationTechnique::performReductionToAllReducableLiveOutVari
   return afterReductionB;
 }
 
+Value * ParallelizationTechnique::generateReductionCombiner (
+  LoopDependenceInfo *LDI,
+  PointerType *combinerPointerType
+){
+
+  /*
+   * Collect the operations that combine the private copies of reduced live-out variables.
+   */
+  std::unordered_map<int, int> reducableBinaryOps;
+  std::unordered_map<int, CmpInst::Predicate> reducableMinMaxPredicates;
+  std::unordered_map<int, std::pair<int, CmpInst::Predicate>> pairedReducableVariables;
+  this->collectReductionOperationsOfLiveOutVariables(LDI, reducableBinaryOps, reducableMinMaxPredicates, pairedReducableVariables);
+
+  /*
+   * Check if there are reduced live-out variables.
+   */
+  this->reductionCombiner = nullptr;
+  if (  true
+        && reducableBinaryOps.empty()
+        && reducableMinMaxPredicates.empty()
+        && pairedReducableVariables.empty()
+     ){
+    return ConstantPointerNull::get(combinerPointerType);
+  }
+
+  /*
+   * Generate the function.
+   */
+  auto combinerType = cast<FunctionType>(combinerPointerType->getElementType());
+  this->reductionCombiner = this->envBuilder->generateReductionCombiner(
+    *this->noelle.getProgram(),
+    combinerType,
+    reducableBinaryOps,
+    reducableMinMaxPredicates,
+    pairedReducableVariables
+    );
+
+  return this->reductionCombiner;
+}
+
+void ParallelizationTechnique::collectReductionOperationsOfLiveOutVariables (
+  LoopDependenceInfo *LDI,
+  std::unordered_map<int, int> &reducableBinaryOps,
+  std::unordered_map<int, CmpInst::Predicate> &reducableMinMaxPredicates,
+  std::unordered_map<int, std::pair<int, CmpInst::Predicate>> &pairedReducableVariables
+){
+
+  /*
+   * Fetch the SCC manager and the environment of the loop.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto environment = LDI->getEnvironment();
+  assert(environment != nullptr);
+
+  for (auto envInd : environment->getEnvIndicesOfLiveOutVars()) {
+    auto isReduced = envBuilder->isVariableReducable(envInd);
+    if (!isReduced) continue;
+
+    auto producer = environment->producerAt(envInd);
+    auto producerSCC = sccManager->getSCCDAG()->sccOfValue(producer);
+    auto producerSCCAttributes = sccManager->getSCCAttrs(producerSCC);
+
+    /*
+     * Check if the variable is a min/max or paired with one (e.g., argmin/argmax).
+     */
+    auto minMaxPredicate = sccManager->getMinMaxPredicateOfReduction(producerSCC);
+    auto minMaxSCC = sccManager->getMinMaxSCCOfPairedReduction(producerSCC);
+    if (minMaxPredicate != CmpInst::BAD_ICMP_PREDICATE) {
+      reducableMinMaxPredicates[envInd] = minMaxPredicate;
+
+    } else if (minMaxSCC != nullptr) {
+
+      /*
+       * Fetch the environment variable of the min/max that selects the values of the current variable.
+       */
+      auto minMaxEnvInd = -1;
+      for (auto otherEnvInd : environment->getEnvIndicesOfLiveOutVars()) {
+        if (minMaxSCC->isInternal(environment->producerAt(otherEnvInd))) {
+          minMaxEnvInd = otherEnvInd;
+          break ;
+        }
+      }
+      assert(minMaxEnvInd != -1 && "The min/max of a paired reduction isn't part of the environment");
+      pairedReducableVariables[envInd] = std::make_pair(minMaxEnvInd, sccManager->getTieBreakPredicateOfPairedReduction(producerSCC));
+
+    } else {
+
+      /*
+       * HACK: Need to get accumulator that feeds directly into producer PHI, not any intermediate one
+       */
+      auto firstAccumI = *(producerSCCAttributes->getAccumulators().begin());
+      auto binOpCode = firstAccumI->getOpcode();
+      reducableBinaryOps[envInd] = sccManager->accumOpInfo.accumOpForType(binOpCode, producer->getType());
+    }
+  }
+
+  return ;
+}
+
 void ParallelizationTechnique::addPredecessorAndSuccessorsBasicBlocksToTasks (
   LoopDependenceInfo *LDI,
   std::vector<Task *> taskStructs
@@ -290,6 +386,7 @@ void ParallelizationTechnique::addPredecessorAndSuccessorsBasicBlocksToTasks (
   auto &cxt = loopFunction->getContext();
   this->entryPointOfParallelizedLoop = BasicBlock::Create(cxt, "", loopFunction);
   this->exitPointOfParallelizedLoop = BasicBlock::Create(cxt, "", loopFunction);
+  this->joinOfParallelizedLoop = nullptr;
 
   this->numTaskInstances = taskStructs.size();
   for (auto i = 0; i < numTaskInstances; ++i) {
@@ -429,6 +526,8 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
   auto rootLoop = LDI->getLoopStructure();
   auto memoryCloningAnalysis = LDI->getMemoryCloningAnalysis();
   auto envUser = this->envBuilder->getUser(taskIndex);
+  auto program = this->noelle.getProgram();
+  auto &cxt = program->getContext();
 
   task->getTaskBody()->print(errs());
   rootLoop->getFunction()->print(errs());
@@ -440,14 +539,14 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
   assert(environment != nullptr);
 
   /*
-   * Check every stack object that can be safely cloned.
+   * Check every memory object that can be safely cloned.
    */
   for (auto location : memoryCloningAnalysis->getClonableMemoryLocations()) {
 
     /*
-     * Fetch the stack object.
+     * Fetch the memory object.
      */
-    auto alloca = location->getAllocation();
+    auto allocation = location->getAllocation();
 
     /*
      * Check if this is an allocation used by this task
@@ -472,9 +571,11 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
      *
      * The stack object can be safely cloned (thanks to the object-cloning analysis) and it is used by our loop.
      *
-     * First, we need to remove the alloca instruction to be a live-in.
+     * First, we need to remove the instruction that allocates the object (if any) to be a live-in.
      */
-    task->removeLiveIn(alloca);
+    if (auto allocationInst = dyn_cast<Instruction>(allocation)){
+      task->removeLiveIn(allocationInst);
+    }
 
     /*
      * Now we need to traverse operands of loop instructions to clone
@@ -570,9 +671,9 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
           }
 
           /*
-           * Check if the current operand is the alloca instruction that will be cloned.
+           * Check if the current operand is the object that will be cloned.
            */
-          if (opJ == alloca){
+          if (opJ == allocation){
             assert(!task->isAnOriginalLiveIn(opJ));
             continue ;
           }
@@ -622,15 +723,91 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
     /*
      * Clone the stack object at the beginning of the task.
      */
-    auto allocaClone = alloca->clone();
     auto firstInst = &*entryBlock.begin();
     entryBuilder.SetInsertPoint(firstInst);
-    entryBuilder.Insert(allocaClone);
+    if (auto alloca = dyn_cast<AllocaInst>(allocation)){
+      auto allocaClone = alloca->clone();
+      entryBuilder.Insert(allocaClone);
+
+      /*
+       * Keep track of the original-clone mapping.
+       */
+      task->addInstruction(alloca, allocaClone);
+      continue ;
+    }
 
     /*
-     * Keep track of the original-clone mapping.
+     * Global and heap objects are cloned by allocating a private copy when the task instance starts, and by freeing it when the task instance ends.
+     * The copy does not need to be initialized, because every iteration overwrites the object before reading it.
+     * The copy does not need to be copied back either, because no code outside the loop can read the object.
      */
-    task->addInstruction(alloca, allocaClone);
+    auto int8PtrType = PointerType::getUnqual(IntegerType::get(cxt, 8));
+    auto int64Type = IntegerType::get(cxt, 64);
+    auto mallocFunction = program->getOrInsertFunction("malloc", FunctionType::get(int8PtrType, ArrayRef<Type *>({int64Type}), false));
+    auto freeFunction = program->getOrInsertFunction("free", FunctionType::get(Type::getVoidTy(cxt), ArrayRef<Type *>({int8PtrType}), false));
+    auto sizeInBytes = ConstantInt::get(int64Type, location->getSizeInBits() / 8);
+    auto privateCopy = entryBuilder.CreateCall(mallocFunction, ArrayRef<Value *>({sizeInBytes}));
+    auto exitBlock = task->getExit();
+    IRBuilder<> exitBuilder(exitBlock);
+    if (auto exitTerminator = exitBlock->getTerminator()){
+      exitBuilder.SetInsertPoint(exitTerminator);
+    }
+    exitBuilder.CreateCall(freeFunction, ArrayRef<Value *>({privateCopy}));
+
+    /*
+     * Heap objects are accessed through the value returned by their allocator.
+     * Hence, the private copy replaces it when the data flow of the task gets adjusted.
+     */
+    if (location->isHeapObject()){
+      task->addInstruction(cast<Instruction>(allocation), privateCopy);
+      continue ;
+    }
+
+    /*
+     * Global variables are constants used directly by the instructions of the task.
+     * Hence, we redirect these uses (and the ones of constant expressions derived from the global variable) to the private copy.
+     */
+    assert(location->isGlobalObject());
+    auto privateObject = entryBuilder.CreateBitCast(privateCopy, allocation->getType());
+    std::function<void (Instruction *)> redirectUsesToPrivateObject = [&](Instruction *inst) {
+      for (auto i = 0u; i < inst->getNumOperands(); ++i) {
+        auto op = inst->getOperand(i);
+        if (op == allocation){
+          inst->setOperand(i, privateObject);
+          continue ;
+        }
+        auto constExpr = dyn_cast<ConstantExpr>(op);
+        if (  false
+              || (constExpr == nullptr)
+              || (!location->mustAliasAMemoryLocationWithinObject(constExpr))
+           ){
+          continue ;
+        }
+
+        /*
+         * Materialize the constant expression at the beginning of the task after its operands.
+         */
+        auto constExprInst = constExpr->getAsInstruction();
+        redirectUsesToPrivateObject(constExprInst);
+        entryBuilder.Insert(constExprInst);
+        inst->setOperand(i, constExprInst);
+      }
+    };
+    std::vector<Instruction *> taskBodyInstructions;
+    for (auto &bb : *task->getTaskBody()){
+      for (auto &inst : bb){
+        if (  false
+              || (&inst == privateCopy)
+              || (&inst == privateObject)
+           ){
+          continue ;
+        }
+        taskBodyInstructions.push_back(&inst);
+      }
+    }
+    for (auto inst : taskBodyInstructions){
+      redirectUsesToPrivateObject(inst);
+    }
   }
   task->getTaskBody()->print(errs());
   rootLoop->getFunction()->print(errs());
@@ -638,6 +815,189 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
   return ;
 }
 
+void ParallelizationTechnique::privatizeArrayReductions (
+  LoopDependenceInfo *LDI,
+  int taskIndex
+){
+
+  /*
+   * Fetch the arrays reduced by the loop.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto arrayReductions = sccManager->getArrayReductions();
+  if (arrayReductions.size() == 0){
+    return ;
+  }
+
+  /*
+   * Fetch the task.
+   */
+  auto task = this->tasks[taskIndex];
+  assert(task != nullptr);
+
+  /*
+   * Fetch the runtime functions that manage private copies of arrays.
+   */
+  auto program = this->noelle.getProgram();
+  auto allocateDense = program->getFunction("NOELLE_arrayReduction_allocateDense");
+  auto mergeDense = program->getFunction("NOELLE_arrayReduction_mergeDense");
+  auto allocateSparse = program->getFunction("NOELLE_arrayReduction_allocateSparse");
+  auto accumulateSparse = program->getFunction("NOELLE_arrayReduction_accumulateSparse");
+  auto mergeSparse = program->getFunction("NOELLE_arrayReduction_mergeSparse");
+  assert(allocateDense != nullptr);
+  assert(mergeDense != nullptr);
+  assert(allocateSparse != nullptr);
+  assert(accumulateSparse != nullptr);
+  assert(mergeSparse != nullptr);
+  auto voidPointerType = mergeDense->getFunctionType()->getParamType(1);
+
+  /*
+   * Arrays that are bigger than this (or whose size is unknown) are privatized by using sparse copies.
+   * This avoids allocating, initializing, and merging big copies of arrays that are only partially updated by a task.
+   */
+  uint64_t maximumBytesOfDenseCopies = 4 * 1024 * 1024;
+
+  /*
+   * Private copies are allocated when a task instance starts, and they are merged into the original arrays when it ends.
+   */
+  auto &cxt = program->getContext();
+  auto &DL = program->getDataLayout();
+  auto int64Type = IntegerType::get(cxt, 64);
+  auto &entryBlock = (*task->getTaskBody()->begin());
+  IRBuilder<> entryBuilder(&entryBlock);
+  if (auto entryTerminator = entryBlock.getTerminator()){
+    entryBuilder.SetInsertPoint(entryTerminator);
+  }
+  auto exitBlock = task->getExit();
+  IRBuilder<> exitBuilder(exitBlock);
+  if (auto exitTerminator = exitBlock->getTerminator()){
+    exitBuilder.SetInsertPoint(exitTerminator);
+  }
+
+  for (auto arrayReduction : arrayReductions){
+
+    /*
+     * Check if the array is reduced by the task.
+     */
+    auto gep = arrayReduction->getPointer();
+    if (!task->isAnOriginalInstruction(gep)){
+      continue ;
+    }
+
+    /*
+     * Fetch the clones of the instructions that accumulate values to the elements of the array.
+     */
+    auto load = arrayReduction->getLoad();
+    auto update = arrayReduction->getUpdate();
+    auto store = arrayReduction->getStore();
+    auto gepClone = cast<GetElementPtrInst>(task->getCloneOfOriginalInstruction(gep));
+    auto loadClone = task->getCloneOfOriginalInstruction(load);
+    auto updateClone = task->getCloneOfOriginalInstruction(update);
+    auto storeClone = task->getCloneOfOriginalInstruction(store);
+    auto sharedArray = gepClone->getPointerOperand();
+
+    /*
+     * Describe the elements of the array and how values are accumulated to them.
+     */
+    auto elementType = arrayReduction->getElementType();
+    auto elementBytes = DL.getTypeAllocSize(elementType);
+    auto isFloatingPoint = elementType->isFloatingPointTy();
+    auto elementBytesValue = ConstantInt::get(int64Type, elementBytes);
+    auto isFloatingPointValue = ConstantInt::get(int64Type, isFloatingPoint ? 1 : 0);
+    auto operationValue = ConstantInt::get(int64Type, arrayReduction->getOperation());
+
+    /*
+     * Check if a dense copy of the array can be used.
+     */
+    auto numberOfElements = arrayReduction->getNumberOfElements();
+    if (  true
+          && (numberOfElements > 0)
+          && ((numberOfElements * elementBytes) <= maximumBytesOfDenseCopies)
+       ){
+
+      /*
+       * Allocate the dense copy and redirect the accesses to the array to it.
+       */
+      auto numberOfElementsValue = ConstantInt::get(int64Type, numberOfElements);
+      auto privateCopy = entryBuilder.CreateCall(allocateDense, ArrayRef<Value *>({
+        numberOfElementsValue,
+        elementBytesValue,
+        isFloatingPointValue,
+        operationValue
+      }));
+      auto privateArray = entryBuilder.CreateBitCast(privateCopy, sharedArray->getType());
+      gepClone->setOperand(0, privateArray);
+
+      /*
+       * Merge the dense copy into the array.
+       */
+      auto sharedArrayPointer = exitBuilder.CreateBitCast(sharedArray, voidPointerType);
+      exitBuilder.CreateCall(mergeDense, ArrayRef<Value *>({
+        privateCopy,
+        sharedArrayPointer,
+        numberOfElementsValue,
+        elementBytesValue,
+        isFloatingPointValue,
+        operationValue,
+        task->getTaskInstanceID()
+      }));
+
+      continue ;
+    }
+
+    /*
+     * Allocate the sparse copy.
+     */
+    auto table = entryBuilder.CreateCall(allocateSparse, ArrayRef<Value *>({
+      elementBytesValue,
+      isFloatingPointValue,
+      operationValue
+    }));
+
+    /*
+     * Accumulate values to the sparse copy rather than to the array.
+     */
+    IRBuilder<> updateBuilder(storeClone);
+    auto indexClone = gepClone->getOperand(gepClone->getNumOperands() - 1);
+    auto index = updateBuilder.CreateSExtOrTrunc(indexClone, int64Type);
+    auto accumulatedValue = (updateClone->getOperand(0) == loadClone) ? updateClone->getOperand(1) : updateClone->getOperand(0);
+    if (isFloatingPoint){
+      accumulatedValue = updateBuilder.CreateBitCast(accumulatedValue, IntegerType::get(cxt, elementBytes * 8));
+    }
+    auto valueBits = updateBuilder.CreateZExtOrTrunc(accumulatedValue, int64Type);
+    updateBuilder.CreateCall(accumulateSparse, ArrayRef<Value *>({
+      table,
+      index,
+      valueBits
+    }));
+
+    /*
+     * Remove the accesses to the array from the task.
+     */
+    storeClone->eraseFromParent();
+    updateClone->eraseFromParent();
+    loadClone->eraseFromParent();
+    task->removeOriginalInstruction(store);
+    task->removeOriginalInstruction(update);
+    task->removeOriginalInstruction(load);
+    if (gepClone->use_empty()){
+      gepClone->eraseFromParent();
+      task->removeOriginalInstruction(gep);
+    }
+
+    /*
+     * Merge the sparse copy into the array.
+     */
+    auto sharedArrayPointer = exitBuilder.CreateBitCast(sharedArray, voidPointerType);
+    exitBuilder.CreateCall(mergeSparse, ArrayRef<Value *>({
+      table,
+      sharedArrayPointer
+    }));
+  }
+
+  return ;
+}
+
 void ParallelizationTechnique::generateCodeToLoadLiveInVariables (
   LoopDependenceInfo *LDI, 
   int taskIndex
@@ -1197,6 +1557,22 @@ Value * ParallelizationTechnique::getIdentityValueForEnvironmentValue (
    * Fetch the attributes about the producer SCC.
    */
   auto sccAttrs = sccManager->getSCCAttrs(producerSCC);
+
+  /*
+   * Partial results of paired reductions (e.g., argmin/argmax) are never selected unless their min/max counterpart is.
+   * Hence, any initial value works.
+   */
+  if (sccManager->getMinMaxSCCOfPairedReduction(producerSCC) != nullptr){
+    return Constant::getNullValue(typeForValue);
+  }
+
+  /*
+   * Check if the environment value is a min/max.
+   */
+  auto minMaxPredicate = sccManager->getMinMaxPredicateOfReduction(producerSCC);
+  if (minMaxPredicate != CmpInst::BAD_ICMP_PREDICATE){
+    return sccManager->accumOpInfo.generateMinMaxIdentityFor(minMaxPredicate, typeForValue);
+  }
   assert(sccAttrs->numberOfAccumulators() > 0 && "The environment value isn't accumulated!");
 
   /*
@@ -1509,6 +1885,129 @@ ParallelizationTechnique::~ParallelizationTechnique () {
   return ;
 }
       
+bool ParallelizationTechnique::canComputeTheNumberOfIterations (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Check if the trip count is known at compile time.
+   */
+  if (LDI->doesHaveCompileTimeKnownTripCount()){
+    return true;
+  }
+
+  /*
+   * The trip count needs to be computed at run time from the start value, the step, and the exit condition value of the loop-governing IV.
+   *
+   * Check that the step is a constant integer.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+  if (loopGoverningIVAttr == nullptr){
+    return false;
+  }
+  auto &loopGoverningIV = loopGoverningIVAttr->getInductionVariable();
+  if (!loopGoverningIV.getIVType()->isIntegerTy()){
+    return false;
+  }
+  auto stepValue = loopGoverningIV.getSingleComputedStepValue();
+  if (  false
+        || (stepValue == nullptr)
+        || (!isa<ConstantInt>(stepValue))
+     ){
+    return false;
+  }
+
+  /*
+   * Check that the start and the exit condition values are available before the loop starts.
+   */
+  for (auto value : { loopGoverningIV.getStartValue(), loopGoverningIVAttr->getExitConditionValue() }){
+    auto inst = dyn_cast<Instruction>(value);
+    if (inst == nullptr){
+      continue ;
+    }
+    if (loopStructure->isIncluded(inst)){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool ParallelizationTechnique::doesReduceFloatingPointVariables (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Fetch the SCC manager and the environment of the loop.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto environment = LDI->getEnvironment();
+  assert(environment != nullptr);
+
+  /*
+   * Check the live-out variables.
+   */
+  for (auto envInd : environment->getEnvIndicesOfLiveOutVars()) {
+    auto producer = environment->producerAt(envInd);
+    if (!producer->getType()->isFloatingPointTy()){
+      continue ;
+    }
+    auto producerSCC = sccManager->getSCCDAG()->sccOfValue(producer);
+    auto producerSCCAttributes = sccManager->getSCCAttrs(producerSCC);
+    if (producerSCCAttributes->canExecuteReducibly()){
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool ParallelizationTechnique::doesReduceFloatingPointArrays (
+  LoopDependenceInfo *LDI
+) const {
+  auto sccManager = LDI->getSCCManager();
+  for (auto arrayReduction : sccManager->getArrayReductions()){
+    if (arrayReduction->getElementType()->isFloatingPointTy()){
+      return true;
+    }
+  }
+
+  return false;
+}
+
+Value * ParallelizationTechnique::generateCodeToComputeTheNumberOfIterations (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> &builder
+) {
+
+  /*
+   * Check if we can compute the number of iterations.
+   */
+  if (!this->canComputeTheNumberOfIterations(LDI)){
+    return nullptr;
+  }
+
+  /*
+   * Check if the trip count is known at compile time.
+   */
+  if (LDI->doesHaveCompileTimeKnownTripCount()){
+    return ConstantInt::get(this->noelle.int64, LDI->getCompileTimeTripCount());
+  }
+
+  /*
+   * Generate the code to compute the trip count.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto IVManager = LDI->getInductionVariableManager();
+  auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+  LoopGoverningIVUtility ivUtility(loopStructure, *IVManager, *loopGoverningIVAttr);
+  auto tripCount = ivUtility.generateCodeToComputeTheTripCount(builder);
+  auto tripCountInt64 = builder.CreateZExtOrTrunc(tripCount, this->noelle.int64);
+
+  return tripCountInt64;
+}
+
 BasicBlock * ParallelizationTechnique::getParLoopEntryPoint (void) const { 
   return entryPointOfParallelizedLoop; 
 }
@@ -1517,4 +2016,8 @@ BasicBlock * ParallelizationTechnique::getParLoopExitPoint (void) const {
   return exitPointOfParallelizedLoop; 
 }
 
+Instruction * ParallelizationTechnique::getParLoopJoinPoint (void) const { 
+  return joinOfParallelizedLoop; 
+}
+
 }
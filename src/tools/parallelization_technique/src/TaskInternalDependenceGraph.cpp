@@ -0,0 +1,171 @@
+/*
+ * Copyright 2016 - 2022  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/tools/ParallelizationTechnique.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+static void constructEdgesFromUseDefs (PDG *pdg);
+static void constructEdgesFromControlForFunction (PDG *pdg, Function &F, PostDominatorTree &postDomTree);
+
+PDG * ParallelizationTechnique::constructTaskInternalDependenceGraphFromOriginalLoopDG (LoopDependenceInfo *LDI, PostDominatorTree &postDomTreeOfTaskFunction) {
+
+  /*
+   * Fetch the task.
+   */
+  auto task = this->tasks[0];
+  auto taskBody = task->getTaskBody();
+
+  /*
+   * Create a new PDG for the internals of the task.
+   *
+   * Register and control dependences are computed from the code of the task.
+   */
+  auto taskFunctionDG = new PDG(*taskBody);
+  constructEdgesFromUseDefs(taskFunctionDG);
+  constructEdgesFromControlForFunction(taskFunctionDG, *taskBody, postDomTreeOfTaskFunction);
+
+  /*
+   * Memory dependences cannot be computed from the task alone as the task accesses memory through the environment.
+   * Hence, we derive them from the dependence graph of the original loop.
+   */
+  for (auto nodePair : LDI->getLoopDG()->internalNodePairs()) {
+
+    /*
+     * Fetch the value.
+     */
+    auto value = nodePair.first;
+
+    /*
+     * We only care about instructions that can generate memory dependences.
+     */
+    if (  true
+          && (!isa<StoreInst>(value))
+          && (!isa<LoadInst>(value))
+          && (!isa<CallInst>(value))
+       ){
+      continue ;
+    }
+
+    /*
+     * Check the dependence.
+     */
+    for (auto edge : nodePair.second->getOutgoingEdges()) {
+
+      /*
+       * We only care about memory dependences between instructions of the parallelized loop.
+       */
+      if (!edge->isMemoryDependence()){
+        continue ;
+      }
+      auto srcValue = edge->getOutgoingT();
+      auto dstValue = edge->getIncomingT();
+      if (  false
+            || (!LDI->getLoopDG()->isInternal(srcValue))
+            || (!LDI->getLoopDG()->isInternal(dstValue))
+         ){
+        continue ;
+      }
+
+      /*
+       * Skip dependences due to lifetime intrinsics.
+       */
+      auto isLifetimeIntrinsic = [](Value *v) -> bool {
+        if (auto callInst = dyn_cast<CallInst>(v)){
+          return callInst->isLifetimeStartOrEnd();
+        }
+        return false;
+      };
+      if (  false
+            || isLifetimeIntrinsic(srcValue)
+            || isLifetimeIntrinsic(dstValue)
+         ){
+        continue ;
+      }
+
+      /*
+       * Fetch the clones of the instructions involved.
+       * Some instructions of the original loop (e.g., the ones that only control the loop) may not have a clone in the task.
+       */
+      auto srcClone = task->getCloneOfOriginalInstruction(cast<Instruction>(srcValue));
+      auto dstClone = task->getCloneOfOriginalInstruction(cast<Instruction>(dstValue));
+      if (  false
+            || (srcClone == nullptr)
+            || (dstClone == nullptr)
+            || (!taskFunctionDG->isInGraph(srcClone))
+            || (!taskFunctionDG->isInGraph(dstClone))
+         ){
+        continue ;
+      }
+
+      /*
+       * Copy the dependence.
+       *
+       * Loop-carried dependences will be recomputed by whoever analyzes the loops of the task.
+       */
+      DGEdge<Value> edgeToPointToClones(*edge);
+      edgeToPointToClones.setLoopCarried(false);
+      edgeToPointToClones.setNodePair(
+        taskFunctionDG->fetchNode(srcClone),
+        taskFunctionDG->fetchNode(dstClone)
+      );
+      taskFunctionDG->copyAddEdge(edgeToPointToClones);
+    }
+  }
+
+  return taskFunctionDG;
+}
+
+/*
+ * These two mirror the ones of PDGAnalysis, which cannot be used here as they require alias analyses.
+ */
+static void constructEdgesFromUseDefs (PDG *pdg){
+  for (auto node : make_range(pdg->begin_nodes(), pdg->end_nodes())) {
+    auto pdgValue = node->getT();
+    if (pdgValue->getNumUses() == 0)
+      continue;
+
+    for (auto& U : pdgValue->uses()) {
+      auto user = U.getUser();
+
+      if (isa<Instruction>(user) || isa<Argument>(user)) {
+        auto edge = pdg->addEdge(pdgValue, user);
+        edge->setMemMustType(false, true, DG_DATA_RAW);
+      }
+    }
+  }
+}
+
+static void constructEdgesFromControlForFunction (PDG *pdg, Function &F, PostDominatorTree &postDomTree) {
+  for (auto &B : F)
+  {
+    SmallVector<BasicBlock *, 10> dominatedBBs;
+    postDomTree.getDescendants(&B, dominatedBBs);
+
+    /*
+     * For each basic block that B post dominates, check if B doesn't stricly post dominate its predecessor
+     * If it does not, then there is a control dependency from the predecessor to B 
+     */
+    for (auto dominatedBB : dominatedBBs)
+    {
+      for (auto predBB : make_range(pred_begin(dominatedBB), pred_end(dominatedBB)))
+      {
+        if (postDomTree.properlyDominates(&B, predBB)) continue;
+        auto controlTerminator = predBB->getTerminator();
+        for (auto &I : B)
+        {
+          auto edge = pdg->addEdge((Value*)controlTerminator, (Value*)&I);
+          edge->setControl(true);
+        }
+      }
+    }
+  }
+}
@@ -37,6 +37,39 @@ namespace llvm::noelle {
     for (auto queueF : par.queues.queuePushes) {
       par.queues.queueTypes.push_back(queueF->arg_begin()->getType());
     }
+
+    /*
+     * Collect the functions of the batched queues.
+     */
+    std::string batchedPushers[4] = { "queueBatchedPush8", "queueBatchedPush16", "queueBatchedPush32", "queueBatchedPush64" };
+    std::string batchedPoppers[4] = { "queueBatchedPop8", "queueBatchedPop16", "queueBatchedPop32", "queueBatchedPop64" };
+    std::string batchedFlushers[4] = { "queueBatchedFlush8", "queueBatchedFlush16", "queueBatchedFlush32", "queueBatchedFlush64" };
+    auto fetchFunction = [&M](std::string name) -> Function * {
+      auto f = M.getFunction(name);
+      if (f == nullptr){
+        errs() << "Parallelizer: ERROR = function \"" << name << "\" could not be found\n";
+        abort();
+      }
+      return f;
+    };
+    for (auto i = 0; i < 4; i++){
+      par.queues.queueBatchedPushes.push_back(fetchFunction(batchedPushers[i]));
+      par.queues.queueBatchedPops.push_back(fetchFunction(batchedPoppers[i]));
+      par.queues.queueBatchedFlushes.push_back(fetchFunction(batchedFlushers[i]));
+    }
+    for (auto queueF : par.queues.queueBatchedPushes) {
+      par.queues.batchedQueueTypes.push_back(queueF->arg_begin()->getType());
+    }
+
+    /*
+     * Collect the functions of the queues of records.
+     */
+    par.queues.queuePushRecord = fetchFunction("queuePushRecord");
+    par.queues.queuePopRecord = fetchFunction("queuePopRecord");
+    par.queues.queueBatchedPushRecord = fetchFunction("queueBatchedPushRecord");
+    par.queues.queueBatchedPopRecord = fetchFunction("queueBatchedPopRecord");
+    par.queues.queueBatchedFlushRecord = fetchFunction("queueBatchedFlushRecord");
+    par.queues.recordQueueType = par.queues.queuePushRecord->arg_begin()->getType();
     par.queues.queueSizeToIndex = unordered_map<int, int>({ { 1, 0 }, { 8, 0 }, { 16, 1 }, { 32, 2 }, { 64, 3 }});
     par.queues.queueElementTypes = std::vector<Type *>({ par.int8, par.int16, par.int32, par.int64 });
 
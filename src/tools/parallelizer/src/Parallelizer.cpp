@@ -31,14 +31,20 @@ namespace llvm::noelle {
     DSWP dswp{
       par,
       this->forceParallelization,
-      !this->forceNoSCCPartition
+      !this->forceNoSCCPartition,
+      this->enableBatchedQueues,
+      this->enableStageReplication
     };
     DOALL doall{
-      par
+      par,
+      this->enableDeterministicReductions,
+      this->enableAsynchronousDispatch
     };
     HELIX helix{
       par,
-      this->forceParallelization
+      this->forceParallelization,
+      this->enableDeterministicReductions,
+      this->enableHELIXChunking
     };
 
     /*
@@ -179,9 +185,28 @@ namespace llvm::noelle {
         exitPoint, 
         envArray,
         exitIndex,
-        loopExitBlocks
+        loopExitBlocks,
+        false,
+        usedTechnique->getParLoopJoinPoint()
         );
+
+    /*
+     * Run the parallelized loop only when the memory accesses it assumes to be disjoint are so.
+     */
+    par.guardTransformedLoopWithRuntimeAliasChecks(LDI, loopPreHeader);
     assert(par.verifyCode());
+
+    /*
+     * Parallelize the loops nested in the parallelized one.
+     *
+     * These loops have been cloned into the task, so the loops we parallelize here are their clones.
+     */
+    if (  true
+          && this->enableNestedParallelism
+          && (usedTechnique == &doall)
+       ){
+      this->parallelizeNestedLoops(LDI, doall, par, h);
+    }
     // if (verbose >= Verbosity::Maximal) {
     //   loopFunction->print(errs() << "Final printout:\n"); errs() << "\n";
     // }
@@ -192,4 +217,152 @@ namespace llvm::noelle {
 
     return true;
   }
+
+  bool Parallelizer::parallelizeNestedLoops (
+      LoopDependenceInfo *LDI,
+      DOALL &doall,
+      Noelle &par,
+      Heuristics *h
+      ){
+    auto prefix = "Parallelizer: parallelizeNestedLoops: " ;
+
+    /*
+     * Check if there are loops nested in the parallelized one.
+     */
+    auto loopNode = LDI->getLoopHierarchyStructures();
+    if (loopNode->getNumberOfSubLoops() == 0){
+      return false;
+    }
+
+    /*
+     * Fetch the verbosity level.
+     */
+    auto verbose = par.getVerbosity();
+    if (verbose != Verbosity::Disabled) {
+      errs() << prefix << "Start\n";
+    }
+
+    /*
+     * Fetch the task that includes the clone of the parallelized loop.
+     */
+    auto taskFunction = doall.getTaskFunction();
+    auto &LI = getAnalysis<LoopInfoWrapperPass>(*taskFunction).getLoopInfo();
+    auto& PDT = getAnalysis<PostDominatorTreeWrapperPass>(*taskFunction).getPostDomTree();
+    auto& SE = getAnalysis<ScalarEvolutionWrapperPass>(*taskFunction).getSE();
+
+    /*
+     * Build the dependence graph of the task.
+     */
+    if (verbose >= Verbosity::Maximal) {
+      errs() << prefix << "  Constructing task dependence graph\n";
+    }
+    auto taskFunctionDG = doall.constructTaskInternalDependenceGraphFromOriginalLoopDG(LDI, PDT);
+
+    /*
+     * Compute the abstractions of the loops nested in the parallelized one.
+     *
+     * The outermost loop of the task is the clone of the parallelized loop.
+     * Hence, we consider the loops that are directly nested in it.
+     * Loops nested deeper are handled recursively once their parent is parallelized.
+     */
+    auto DS = par.getDominators(taskFunction);
+    auto taskLoops = par.getLoopStructures(taskFunction, 0);
+    auto taskForest = par.organizeLoopsInTheirNestingForest(*taskLoops);
+    std::vector<LoopDependenceInfo *> nestedLoops;
+    for (auto tree : taskForest->getTrees()){
+      for (auto nestedLoopNode : tree->getChildren()){
+        auto nestedLoopHeader = nestedLoopNode->getLoop()->getHeader();
+        auto llvmLoop = LI.getLoopFor(nestedLoopHeader);
+        assert(llvmLoop != nullptr);
+        auto nestedLDI = new LoopDependenceInfo(taskFunctionDG, nestedLoopNode, llvmLoop, *DS, SE, par.getCompilationOptionsManager()->getMaximumNumberOfCores(), par.canFloatsBeConsideredRealNumbers());
+        nestedLDI->copyParallelizationOptionsFrom(LDI);
+        nestedLoops.push_back(nestedLDI);
+      }
+    }
+
+    /*
+     * Parallelize the nested loops.
+     *
+     * Only DOALL is considered as the other techniques need all cores to make progress, which a nested loop is not guaranteed to get.
+     */
+    auto modified = false;
+    for (auto nestedLDI : nestedLoops){
+      auto nestedLoopStructure = nestedLDI->getLoopStructure();
+      auto ltm = nestedLDI->getLoopTransformationsManager();
+      if (verbose != Verbosity::Disabled) {
+        errs() << prefix << "  Nested loop \"" << *nestedLoopStructure->getHeader()->getFirstNonPHI() << "\"\n";
+      }
+
+      /*
+       * Check if the nested loop can be parallelized.
+       */
+      DOALL nestedDOALL{
+        par,
+        this->enableDeterministicReductions,
+        false
+      };
+      if (  false
+            || (!par.isTransformationEnabled(DOALL_ID))
+            || (!ltm->isTransformationEnabled(DOALL_ID))
+            || (!nestedDOALL.canBeAppliedToLoop(nestedLDI, h))
+         ){
+        if (verbose != Verbosity::Disabled) {
+          errs() << prefix << "    The nested loop has not been parallelized\n";
+        }
+        continue ;
+      }
+
+      /*
+       * Parallelize the nested loop.
+       */
+      auto nestedLoopPreHeader = nestedLoopStructure->getPreHeader();
+      auto nestedLoopExitBlocks = nestedLoopStructure->getLoopExitBasicBlocks();
+      if (!nestedDOALL.apply(nestedLDI, h)){
+        if (verbose != Verbosity::Disabled) {
+          errs() << prefix << "    The nested loop has not been parallelized\n";
+        }
+        continue ;
+      }
+
+      /*
+       * Link the parallelized nested loop within the task.
+       *
+       * Every thread of the parent loop can run its own invocation of the nested loop in parallel.
+       * The runtime splits the cores reserved by the parent loop among them.
+       */
+      auto exitIndex = ConstantInt::get(par.int64, nestedLDI->getEnvironment()->indexOfExitBlockTaken());
+      par.linkTransformedLoopToOriginalFunction(
+          taskFunction->getParent(),
+          nestedLoopPreHeader,
+          nestedDOALL.getParLoopEntryPoint(),
+          nestedDOALL.getParLoopExitPoint(),
+          nestedDOALL.getEnvArray(),
+          exitIndex,
+          nestedLoopExitBlocks,
+          true
+          );
+      assert(par.verifyCode());
+      modified = true;
+      if (verbose != Verbosity::Disabled) {
+        errs() << prefix << "    The nested loop has been parallelized\n";
+      }
+
+      /*
+       * Parallelize the loops nested in the one we have just parallelized.
+       */
+      this->parallelizeNestedLoops(nestedLDI, nestedDOALL, par, h);
+    }
+
+    /*
+     * Free the memory.
+     */
+    for (auto nestedLDI : nestedLoops){
+      delete nestedLDI;
+    }
+
+    if (verbose != Verbosity::Disabled) {
+      errs() << prefix << "Exit\n";
+    }
+    return modified;
+  }
 }
@@ -66,6 +66,13 @@ namespace llvm::noelle {
        */
       bool forceParallelization;
       bool forceNoSCCPartition;
+      bool enableBatchedQueues;
+      bool enableStageReplication;
+      bool enableNestedParallelism;
+      bool enableDeterministicReductions;
+      bool enableAsynchronousDispatch;
+      bool enableRuntimeAliasChecks;
+      bool enableHELIXChunking;
 
       /*
        * Methods
@@ -76,6 +83,13 @@ namespace llvm::noelle {
         Heuristics *h
       );
 
+      bool parallelizeNestedLoops (
+        LoopDependenceInfo *LDI,
+        DOALL &doall,
+        Noelle &par,
+        Heuristics *h
+      );
+
       std::vector<LoopDependenceInfo *> getLoopsToParallelize (Module &M, Noelle &par) ;
 
       bool collectThreadPoolHelperFunctionsAndTypes (Module &M, Noelle &par) ;
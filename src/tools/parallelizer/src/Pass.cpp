@@ -17,12 +17,26 @@ namespace llvm::noelle {
  */
 static cl::opt<bool> ForceParallelization("noelle-parallelizer-force", cl::ZeroOrMore, cl::Hidden, cl::desc("Force the parallelization"));
 static cl::opt<bool> ForceNoSCCPartition("dswp-no-scc-merge", cl::ZeroOrMore, cl::Hidden, cl::desc("Force no SCC merging when parallelizing"));
+static cl::opt<bool> EnableBatchedQueues("dswp-batched-queues", cl::ZeroOrMore, cl::Hidden, cl::desc("Transfer values between DSWP stages in cache-line-sized blocks"));
+static cl::opt<bool> EnableStageReplication("dswp-replicate-stages", cl::ZeroOrMore, cl::Hidden, cl::desc("Run the DSWP stages without loop-carried dependences on several threads (PS-DSWP)"));
+static cl::opt<bool> EnableNestedParallelism("noelle-parallelizer-nested", cl::ZeroOrMore, cl::Hidden, cl::desc("Parallelize the loops nested in DOALL loops as well"));
+static cl::opt<bool> EnableDeterministicReductions("noelle-deterministic-reductions", cl::ZeroOrMore, cl::Hidden, cl::desc("Reduce floating point values the same way independently of the number of threads used at run time"));
+static cl::opt<bool> EnableAsynchronousDispatch("noelle-parallelizer-async", cl::ZeroOrMore, cl::Hidden, cl::desc("Run the code that follows a DOALL loop and that does not depend on it while the loop runs"));
+static cl::opt<bool> EnableRuntimeAliasChecks("noelle-parallelizer-runtime-alias-checks", cl::ZeroOrMore, cl::Hidden, cl::desc("Parallelize loops assuming their pointers do not alias and check it before running them"));
+static cl::opt<bool> EnableHELIXChunking("noelle-helix-chunking", cl::ZeroOrMore, cl::Hidden, cl::desc("Let each core run consecutive iterations of HELIX loops between synchronizations (the number of iterations is chosen from the profiles)"));
 
 Parallelizer::Parallelizer()
   :
     ModulePass{ID}, 
     forceParallelization{false},
-    forceNoSCCPartition{false}
+    forceNoSCCPartition{false},
+    enableBatchedQueues{false},
+    enableStageReplication{false},
+    enableNestedParallelism{false},
+    enableDeterministicReductions{false},
+    enableAsynchronousDispatch{false},
+    enableRuntimeAliasChecks{false},
+    enableHELIXChunking{false}
 {
 
   return ;
@@ -31,6 +45,13 @@ Parallelizer::Parallelizer()
 bool Parallelizer::doInitialization (Module &M) {
   this->forceParallelization = (ForceParallelization.getNumOccurrences() > 0);
   this->forceNoSCCPartition = (ForceNoSCCPartition.getNumOccurrences() > 0);
+  this->enableBatchedQueues = (EnableBatchedQueues.getNumOccurrences() > 0);
+  this->enableStageReplication = (EnableStageReplication.getNumOccurrences() > 0);
+  this->enableNestedParallelism = (EnableNestedParallelism.getNumOccurrences() > 0);
+  this->enableDeterministicReductions = (EnableDeterministicReductions.getNumOccurrences() > 0);
+  this->enableAsynchronousDispatch = (EnableAsynchronousDispatch.getNumOccurrences() > 0);
+  this->enableRuntimeAliasChecks = (EnableRuntimeAliasChecks.getNumOccurrences() > 0);
+  this->enableHELIXChunking = (EnableHELIXChunking.getNumOccurrences() > 0);
 
   return false; 
 }
@@ -90,13 +111,16 @@ bool Parallelizer::runOnModule (Module &M) {
   auto mm = noelle.getMetadataManager();
   std::map<uint32_t, LoopDependenceInfo*> loopParallelizationOrder;
   for (auto tree : forest->getTrees()) {
-    auto selector = [&noelle, &mm, &loopParallelizationOrder](StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
+    auto selector = [this, &noelle, &mm, &loopParallelizationOrder](StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
       auto ls = n->getLoop();
       if (!mm->doesHaveMetadata(ls, "noelle.parallelizer.looporder")) {
         return false;
       }
       auto parallelizationOrderIndex = std::stoi(mm->getMetadata(ls, "noelle.parallelizer.looporder"));
-      auto optimizations = { LoopDependenceInfoOptimization::MEMORY_CLONING_ID, LoopDependenceInfoOptimization::THREAD_SAFE_LIBRARY_ID};
+      std::unordered_set<LoopDependenceInfoOptimization> optimizations{ LoopDependenceInfoOptimization::MEMORY_CLONING_ID, LoopDependenceInfoOptimization::THREAD_SAFE_LIBRARY_ID};
+      if (this->enableRuntimeAliasChecks){
+        optimizations.insert(LoopDependenceInfoOptimization::RUNTIME_ALIAS_CHECKS_ID);
+      }
       auto ldi = noelle.getLoop(ls, optimizations);      
       loopParallelizationOrder[parallelizationOrderIndex] = ldi;
       return false;
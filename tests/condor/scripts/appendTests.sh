@@ -1,9 +1,14 @@
 #!/bin/bash
 
 condorFile=`realpath $1` ;
+shift ;
+testsToAppend="$@" ;
 
 cd ../regression ; 
-for i in `ls` ; do
+if test "${testsToAppend}" == "" ; then
+  testsToAppend="`ls`" ;
+fi
+for i in ${testsToAppend} ; do
   if ! test -d $i ; then
     continue ;
   fi
@@ -2,6 +2,7 @@
 
 # Global variables
 let idx=0 ;
+source ../scripts/feature_tests.sh ;
 
 # Functions
 function generateCondor {
@@ -11,6 +12,7 @@ function generateCondor {
   local feo="$4" ;
   local meo="$5" ;
   local to="$6" ;
+  local tests="$7" ;
 
   # Create the directory
   pushd ./ ;
@@ -21,7 +23,7 @@ function generateCondor {
 
   baseBf="`basename ${cf}`" ;
   python2 scripts/generateCondorScript.py ${cf} ./${baseBf}_${idx}.con "regression_${idx}" "-noelle-pdg-check -noelle-verbose=3 ${no}" "${po}" "$feo" "$meo" "$to" ${email};
-	./scripts/appendTests.sh ./${baseBf}_${idx}.con ;
+	./scripts/appendTests.sh ./${baseBf}_${idx}.con ${tests} ;
   let idx=idx+1 ;
 
   return 
@@ -94,6 +96,26 @@ function generateAllCondorJobs {
   noelleOptions="-noelle-disable-dswp -noelle-disable-doall -noelle-disable-helix -noelle-disable-inliner -noelle-disable-whilifier -noelle-disable-loop-distribution -noelle-disable-scev-simplification" ;
   generateCondor "$condorFile" "$noelleOptions" "$parOptions" "$feOptions" "$meOptions"
 
+  # Optional features of the parallelizer (only on the tests that exercise them)
+  noelleOptions="-noelle-disable-helix -noelle-disable-dswp" ;
+  generateCondor "$condorFile" "$noelleOptions" "$parOptions -noelle-parallelizer-nested" "$feOptions" "$meOptions" "" "${NESTED_TESTS}"
+
+  noelleOptions="-noelle-disable-doall -noelle-disable-helix" ;
+  generateCondor "$condorFile" "$noelleOptions" "$parOptions -dswp-batched-queues" "$feOptions" "$meOptions" "" "${DSWP_TESTS}"
+  generateCondor "$condorFile" "$noelleOptions" "$parOptions -dswp-replicate-stages" "$feOptions" "$meOptions" "" "${DSWP_TESTS}"
+
+  noelleOptions="" ;
+  generateCondor "$condorFile" "$noelleOptions" "$parOptions -noelle-deterministic-reductions" "$feOptions" "$meOptions" "" "${REDUCTION_TESTS}"
+
+  noelleOptions="-noelle-disable-helix -noelle-disable-dswp" ;
+  generateCondor "$condorFile" "$noelleOptions" "$parOptions -noelle-parallelizer-async" "$feOptions" "$meOptions" "" "${ASYNC_TESTS}"
+
+  noelleOptions="" ;
+  generateCondor "$condorFile" "$noelleOptions" "$parOptions -noelle-parallelizer-runtime-alias-checks" "$feOptions" "$meOptions" "" "${ALIAS_CHECK_TESTS}"
+
+  noelleOptions="-noelle-disable-doall -noelle-disable-dswp" ;
+  generateCondor "$condorFile" "$noelleOptions" "$parOptions -noelle-helix-chunking" "$feOptions" "$meOptions" "" "${HELIX_TESTS}"
+
   return 
 }
 
@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BINS 256
+
+static long long int histogram[BINS];
+
+void computeHistogram (int *keys, long long int *weights, long long int iters){
+  for (auto i=0; i < iters; ++i){
+    histogram[keys[i]] += weights[i];
+  }
+
+  return ;
+}
+
+void computeSparseHistogram (int *keys, int *counts, long long int iters){
+  for (auto i=0; i < iters; ++i){
+    counts[keys[i]]++;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 1){
+    iterations = 1;
+  }
+  int *keys = (int *) calloc(iterations, sizeof(int));
+  int *sparseKeys = (int *) calloc(iterations, sizeof(int));
+  long long int *weights = (long long int *) calloc(iterations, sizeof(long long int));
+  int *counts = (int *) calloc(iterations, sizeof(int));
+  for (auto i=0; i < iterations; ++i){
+    keys[i] = (i * 7919) % BINS;
+    sparseKeys[i] = (i * 104729) % iterations;
+    weights[i] = i % 13;
+  }
+
+  computeHistogram(keys, weights, iterations);
+  computeSparseHistogram(sparseKeys, counts, iterations);
+
+  unsigned long long int checksum = 0;
+  for (auto i=0; i < BINS; ++i){
+    checksum = (checksum * 31) + histogram[i];
+  }
+  for (auto i=0; i < iterations; ++i){
+    checksum = (checksum * 31) + counts[i];
+  }
+  printf("%llu\n", checksum);
+
+  return 0;
+}
@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+struct node {
+  long long int value;
+  long long int result;
+  struct node *next;
+};
+
+static long long int work (long long int v){
+  long long int r = v;
+  for (auto i = 0; i < 100; ++i){
+    r = (r * 7 + i) % 1000003;
+  }
+  return r;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations == 0) return 0;
+
+  /*
+   * Build the list.
+   */
+  auto n = iterations * 100;
+  struct node *head = NULL;
+  for (auto i = 0; i < n; i++){
+    auto newNode = (struct node *) malloc(sizeof(struct node));
+    newNode->value = i;
+    newNode->result = 0;
+    newNode->next = head;
+    head = newNode;
+  }
+
+  /*
+   * Walking the list is sequential while the work done per node is independent of the other nodes.
+   * Hence, the stage that does the work can run on several threads.
+   */
+  auto current = head;
+  while (current != NULL){
+    current->result = work(current->value);
+    current = current->next;
+  }
+
+  long long int s = 0;
+  for (auto tmp = head; tmp != NULL; tmp = tmp->next){
+    s += tmp->result;
+  }
+  printf("%lld\n", s);
+
+  return 0;
+}
@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+bool contains (long long int *values, long long int iters, long long int key){
+  for (auto i=0; i < iters; ++i){
+    if (values[i] == key){
+      return true;
+    }
+  }
+
+  return false;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 1){
+    iterations = 1;
+  }
+  long long int *values = (long long int *) calloc(iterations, sizeof(long long int));
+  for (auto i=0; i < iterations; ++i){
+    values[i] = (i * 7919) % 100003;
+  }
+
+  unsigned long long int found = 0;
+  for (auto k=0; k < 64; ++k){
+    auto key = (k % 3) ? values[(k * 7) % iterations] : (k * 1571);
+    found = (found * 31) + (contains(values, iterations, key) ? k : 0);
+  }
+  printf("%llu\n", found);
+
+  return 0;
+}
@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+long long int hash (long long int *values, long long int n){
+  long long int h = 1;
+  for (auto i=0; i < n; ++i){
+    auto v = (values[i] * 3) + 1;
+    h = (h * 31) ^ v;
+    values[i] = h & 0xFF;
+  }
+
+  return h;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations == 0) return 0;
+
+  /*
+   * Every iteration of the loop of "hash" is tiny.
+   * Hence, HELIX can run several consecutive iterations per core between synchronizations.
+   */
+  auto n = iterations * 1000;
+  long long int *values = (long long int *) malloc(sizeof(long long int) * n);
+  for (auto i=0; i < n; i++){
+    values[i] = i % 17;
+  }
+
+  auto h = hash(values, n);
+
+  long long int s = 0;
+  for (auto i=0; i < n; i++){
+    s += values[i];
+  }
+  printf("%lld %lld\n", h, s);
+
+  return 0;
+}
@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+void computeWindowSums (long long int *values, long long int *sums, long long int iters){
+  for (auto i=0; i < iters; ++i){
+    auto windowSize = 8 + (i % 32);
+    long long int *window = (long long int *) malloc(windowSize * sizeof(long long int));
+    for (auto j=0; j < windowSize; ++j){
+      window[j] = values[(i + j) % iters];
+    }
+    long long int sum = 0;
+    for (auto j=0; j < windowSize; ++j){
+      sum += window[j];
+    }
+    sums[i] = sum;
+    free(window);
+  }
+
+  return ;
+}
+
+void computeDigits (long long int *values, int *digits, long long int iters){
+  for (auto i=0; i < iters; ++i){
+    char *buffer = (char *) calloc(32, sizeof(char));
+    auto value = values[i];
+    auto length = 0;
+    do {
+      buffer[length++] = '0' + (value % 10);
+      value /= 10;
+    } while (value > 0);
+    auto numberOfDigits = 0;
+    while (buffer[numberOfDigits] != '\0'){
+      numberOfDigits++;
+    }
+    digits[i] = numberOfDigits;
+    free(buffer);
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 1){
+    iterations = 1;
+  }
+  long long int *values = (long long int *) calloc(iterations, sizeof(long long int));
+  long long int *sums = (long long int *) calloc(iterations, sizeof(long long int));
+  int *digits = (int *) calloc(iterations, sizeof(int));
+  for (auto i=0; i < iterations; ++i){
+    values[i] = (i * 7919) % 100003;
+  }
+
+  computeWindowSums(values, sums, iterations);
+  computeDigits(values, digits, iterations);
+
+  unsigned long long int checksum = 0;
+  for (auto i=0; i < iterations; ++i){
+    checksum = (checksum * 31) + sums[i] + digits[i];
+  }
+  printf("%llu\n", checksum);
+
+  return 0;
+}
@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+long long int computeMax (long long int *a, long long int iters){
+  long long int m = -1;
+
+  for (auto i=0; i < iters; ++i){
+    m = a[i] > m ? a[i] : m;
+  }
+
+  return m;
+}
+
+double computeMin (double *a, long long int iters){
+  double m = 1000000.0;
+
+  for (auto i=0; i < iters; ++i){
+    m = fmin(m, a[i]);
+  }
+
+  return m;
+}
+
+long long int computeXor (long long int *a, long long int iters){
+  long long int s = 0;
+
+  for (auto i=0; i < iters; ++i){
+    s ^= a[i];
+  }
+
+  return s;
+}
+
+int computeArgMax (long long int *a, int iters){
+  long long int m = a[0];
+  int index = 0;
+
+  for (auto i=1; i < iters; ++i){
+    if (a[i] > m){
+      m = a[i];
+      index = i;
+    }
+  }
+
+  return index;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 1){
+    iterations = 1;
+  }
+  long long int *array = (long long int *) calloc(iterations, sizeof(long long int));
+  double *arrayOfDoubles = (double *) calloc(iterations, sizeof(double));
+  for (auto i=0; i < iterations; ++i){
+    array[i] = (i * 7919) % 1009;
+    arrayOfDoubles[i] = (double)((i * 104729) % 1013) - 500.5;
+  }
+
+  auto m = computeMax(array, iterations);
+  auto d = computeMin(arrayOfDoubles, iterations);
+  auto s = computeXor(array, iterations);
+  auto index = computeArgMax(array, iterations);
+  printf("%lld %.1f %lld %d\n", m, d, s, index);
+
+  return 0;
+}
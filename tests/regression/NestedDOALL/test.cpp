@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ROWS 4
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoi(argv[1]);
+  if (iterations <= 0){
+    return 0;
+  }
+
+  /*
+   * Allocate the matrix.
+   */
+  auto matrix = (long long *) malloc(sizeof(long long) * ROWS * iterations);
+  auto sums = (long long *) calloc(ROWS, sizeof(long long));
+
+  /*
+   * The outer loop has fewer iterations than cores.
+   * Both loops are DOALL.
+   */
+  for (auto i = 0; i < ROWS; i++){
+    for (auto j = 0; j < iterations; j++){
+      matrix[i * iterations + j] = (i + 1) * j;
+    }
+  }
+
+  /*
+   * The nested loop is a reduction.
+   */
+  for (auto i = 0; i < ROWS; i++){
+    long long s = 0;
+    for (auto j = 0; j < iterations; j++){
+      s += matrix[i * iterations + j] % 7;
+    }
+    sums[i] = s;
+  }
+
+  for (auto i = 0; i < ROWS; i++){
+    printf("%lld\n", sums[i]);
+  }
+
+  free(matrix);
+  free(sums);
+
+  return 0;
+}
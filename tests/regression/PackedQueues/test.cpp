@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoi(argv[1]);
+
+  /*
+   * Several values computed by the same sequential SCC flow to the same consumers.
+   * One of them is wider than 64 bits.
+   */
+  long long a = 1;
+  double b = 0.5;
+  int c = 3;
+  long double accumulator = 0;
+  long long checksum = 0;
+  for (auto i = 0; i < iterations; i++){
+    a = (a * 3 + i) % 1000003;
+    b = b * 0.5 + 1.0;
+    c = c ^ i;
+    long double wide = ((long double)b) * i;
+
+    checksum += (a % 7) + c;
+    accumulator += wide;
+  }
+
+  printf("%lld %.6Lf\n", checksum, accumulator);
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+  long long int histogram[16];
+  long long int total;
+} Scratch;
+
+static Scratch scratch;
+
+void computeHistogramPeaks (long long int *values, long long int *peaks, long long int iters){
+  for (auto i=0; i < iters; ++i){
+    memset(&scratch, 0, sizeof(Scratch));
+    for (auto j=0; j < 64; ++j){
+      auto value = values[(i + j) % iters];
+      scratch.histogram[value % 16]++;
+      scratch.total += value;
+    }
+    long long int peak = 0;
+    for (auto j=0; j < 16; ++j){
+      if (scratch.histogram[j] > scratch.histogram[peak]){
+        peak = j;
+      }
+    }
+    peaks[i] = peak + scratch.total;
+  }
+
+  return ;
+}
+
+void computeDigitSums (long long int *values, long long int *sums, long long int iters){
+  auto digits = (char *) malloc(32);
+  for (auto i=0; i < iters; ++i){
+    memset(digits, 0, 32);
+    auto value = values[i];
+    auto length = 0;
+    do {
+      digits[length++] = value % 10;
+      value /= 10;
+    } while (value > 0);
+    long long int sum = 0;
+    for (auto j=0; j < 32; ++j){
+      sum += digits[j];
+    }
+    sums[i] = sum;
+  }
+  free(digits);
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 1){
+    iterations = 1;
+  }
+  long long int *values = (long long int *) calloc(iterations, sizeof(long long int));
+  long long int *peaks = (long long int *) calloc(iterations, sizeof(long long int));
+  long long int *sums = (long long int *) calloc(iterations, sizeof(long long int));
+  for (auto i=0; i < iterations; ++i){
+    values[i] = (i * 7919) % 100003;
+  }
+
+  computeHistogramPeaks(values, peaks, iterations);
+  computeDigitSums(values, sums, iterations);
+
+  unsigned long long int checksum = 0;
+  for (auto i=0; i < iterations; ++i){
+    checksum = (checksum * 31) + peaks[i] + sums[i];
+  }
+  printf("%llu\n", checksum);
+
+  return 0;
+}
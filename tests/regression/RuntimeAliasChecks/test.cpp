@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+void scale (double *dst, double *src, long long int iters){
+  for (auto i=0; i < iters; ++i){
+    dst[i] = (src[i] / 2) + 1;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations == 0) return 0;
+
+  double *a = (double *) malloc(sizeof(double) * (iterations + 1));
+  double *b = (double *) malloc(sizeof(double) * (iterations + 1));
+  for (auto i=0; i <= iterations; i++){
+    a[i] = i % 10;
+    b[i] = 0;
+  }
+
+  /*
+   * The arrays do not overlap.
+   */
+  scale(b, a, iterations);
+
+  /*
+   * Every iteration reads the value written by the previous one.
+   */
+  scale(a + 1, a, iterations);
+
+  double s = 0;
+  for (auto i=0; i <= iterations; i++){
+    s += a[i] + b[i];
+  }
+  printf("%f\n", s);
+
+  return 0;
+}
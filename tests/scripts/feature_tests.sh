@@ -0,0 +1,22 @@
+#!/bin/bash
+
+# Regression tests that exercise optional features of the parallelizer.
+# Each feature is tested only on these tests, both by test_regression.sh and by the condor jobs.
+
+# -noelle-parallelizer-nested
+NESTED_TESTS="NestedDOALL NestedLoops NestedLoops2 Nested_loops Nestb" ;
+
+# -dswp-batched-queues and -dswp-replicate-stages
+DSWP_TESTS="2_SCCs DSWPIterations_RemovableIntraIterMemEdge DSWPReplicatedStages EndHeavySCC More_pushes_than_pulls More_pushes_than_pulls_in_memory Multiloops_2_SCCs Multiloops_2_SCCs_2 Multiloops_8_SCCs Multiloops_more_pushes_than_pulls OutOfOrderSCCs PackedQueues SCCOfOneInstruction TinySCC TinySCC2" ;
+
+# -noelle-deterministic-reductions
+REDUCTION_TESTS="ArrayReduction Double Floats LinkedListReduction MinMaxReduction ReductionInHeaderAndBody ReductionIterations1 ReductionIterations2 ReductionIterations3 ReductionIterations4 ReductionIterations5 ReductionIterations6 ReductionIterations7 ReductionIterationsAnd ReductionIterationsOr ReductionWithCasting" ;
+
+# -noelle-parallelizer-async
+ASYNC_TESTS="IndependentIterations IndependentIterations2 IndependentIterations3 IndependentIterations4 IndependentIterations5 IterationPrivateMalloc Multiloops Multiloops_3 NestedDOALL PrivateScratchObjects" ;
+
+# -noelle-parallelizer-runtime-alias-checks
+ALIAS_CHECK_TESTS="AllocAA_primitive_indirect BadLoadRef Memory_interprocedural_dependence0 Memory_interprocedural_dependence1 Memory_intraprocedural_dependence PointerTraversal1 PointerTraversal2 RAWCallToCall RuntimeAliasChecks" ;
+
+# -noelle-helix-chunking
+HELIX_TESTS="Chunking ConnectedButIndepIters CriticalSection DependentIterations DependentIterations2 DependentIterations3 HELIXChunking LoopCarriedDependence PossibleNewHelixBug" ;
@@ -2,22 +2,27 @@
 
 # Fetch the inputs
 if test $# -lt 2 ; then
-  echo "USAGE: `basename $0` BASELINE_OUTPUT RUN2_OUTPUT" ;
+  echo "USAGE: `basename $0` BASELINE_TELEMETRY RUN2_TELEMETRY" ;
+  echo "  Telemetry files are written by binaries run with NOELLE_TELEMETRY=FILE" ;
   exit 1;
 fi
 
-setup1=`grep overhead $1 | grep Setup | awk '{c += $5} END {print c}'` ;
-setup2=`grep overhead $2 | grep Setup | awk '{c += $5} END {print c}'` ;
+function sumField {
+  grep -o "\"$2\": [0-9]*" $1 | awk '{c += $2} END {print c + 0}' ;
+}
+
+setup1=`sumField $1 totalSetupNanoseconds` ;
+setup2=`sumField $2 totalSetupNanoseconds` ;
 delta=`echo "scale=3; (($setup2 - $setup1) / $setup1) * 100" | bc`;
 echo "Setup overhead = $delta %" ;
 
-forking1=`grep overhead $1 | grep Task | awk '{c += $6} END {print c}'` ;
-forking2=`grep overhead $2 | grep Task | awk '{c += $6} END {print c}'` ;
+forking1=`sumField $1 totalForkNanoseconds` ;
+forking2=`sumField $2 totalForkNanoseconds` ;
 delta=`echo "scale=3; (($forking2 - $forking1) / $forking1) * 100" | bc`;
 echo "Forking overhead = $delta %" ;
 
-joining1=`grep overhead $1 | grep Joining | awk '{c += $5} END {print c}'`;
-joining2=`grep overhead $2 | grep Joining | awk '{c += $5} END {print c}'`;
+joining1=`sumField $1 totalJoinNanoseconds` ;
+joining2=`sumField $2 totalJoinNanoseconds` ;
 delta=`echo "scale=3; (($joining2 - $joining1) / $joining1) * 100" | bc`;
 echo "Joining overhead = $delta %" ;
 
@@ -37,9 +42,9 @@ echo "  $joining1Rel % (Joining)";
 setup2Rel=`echo "scale=3; ($setup2 / $tot2) * 100" | bc` ;
 forking2Rel=`echo "scale=3; ($forking2 / $tot2) * 100" | bc` ;
 joining2Rel=`echo "scale=3; ($joining2 / $tot2) * 100" | bc` ;
-invocs=`grep overhead $2 | grep Setup | wc -l | awk '{print $1}'` ;
+invocs=`sumField $2 invocations` ;
 tot2Avg=`echo "$tot2 / $invocs" | bc`;
-echo "$2 breakdown of $tot2Avg clock cycles per invocation (among $invocs invocations)" ;
+echo "$2 breakdown of $tot2Avg nanoseconds per invocation (among $invocs invocations)" ;
 echo "  $setup2Rel % (Setup)";
 echo "  $forking2Rel % (Forking)";
 echo "  $joining2Rel % (Joining)";
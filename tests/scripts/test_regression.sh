@@ -12,16 +12,32 @@ function runningTestsWrapper {
   return ;
 }
 
+function runningTestsOnWrapper {
+  local testsToUse="$1" ;
+  shift ;
+  local optionsToUse="$@" ;
+
+  runningTests "Testing `echo ${testsToUse} | wc -w` tests with \"${optionsToUse}\"" "-noelle-verbose=3 ${optionsToUse}" "${testsToUse}" ;
+
+  return ;
+}
+
 function runningTests {
   echo $1 ;
 
+  # Fetch the tests to run (all of them by default)
+  local testsToRun="$3" ;
+  if test "${testsToRun}" == "" ; then
+    testsToRun="`ls`" ;
+  fi
+
   local checked_tests=0 ;
   local passed_tests=0 ;
   local dirs_of_failed_tests="" ;
  
   # Compute the number of tests
   numOfTests="0" ;
-  for i in `ls`; do
+  for i in ${testsToRun}; do
     if ! test -d $i ; then
       continue ;
     fi
@@ -29,7 +45,7 @@ function runningTests {
   done
 
   currentTest="0" ; 
-  for i in `ls`; do
+  for i in ${testsToRun}; do
     if ! test -d $i ; then
       continue ;
     fi
@@ -77,6 +93,8 @@ function runningTests {
 
 export PATH=`pwd`/../install/bin:$PATH
 
+source scripts/feature_tests.sh ;
+
 cd regression ;
 
 # Test enablers
@@ -96,10 +114,19 @@ runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -dswp-no-sc
 
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-helix ;
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-helix -dswp-no-scc-merge ;
+runningTestsOnWrapper "${DSWP_TESTS}" -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-helix -dswp-batched-queues ;
+runningTestsOnWrapper "${DSWP_TESTS}" -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-helix -dswp-replicate-stages ;
 
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp ;
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp -dswp-no-scc-merge ;
 
+runningTestsOnWrapper "${NESTED_TESTS}" -noelle-parallelizer-force -noelle-parallelizer-nested -noelle-disable-helix -noelle-disable-dswp ;
+
+runningTestsOnWrapper "${REDUCTION_TESTS}" -noelle-parallelizer-force -noelle-deterministic-reductions ;
+runningTestsOnWrapper "${ASYNC_TESTS}" -noelle-parallelizer-force -noelle-parallelizer-async ;
+runningTestsOnWrapper "${ALIAS_CHECK_TESTS}" -noelle-parallelizer-force -noelle-parallelizer-runtime-alias-checks ;
+runningTestsOnWrapper "${HELIX_TESTS}" -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp -noelle-helix-chunking ;
+
 cd ../ ;
 
 exit 0;